@@ -3,8 +3,11 @@
 #include <concepts>
 #include <cstddef>
 #include <array>
+#include <vector>
 #include <optional>
 #include <cmath>
+#include <complex>
+#include <type_traits>
 // 実装内のみで使用される型やコンセプト
 namespace klibrary::linear_algebra::alias_and_concepts {
     using SizeT = std::size_t;
@@ -76,6 +79,48 @@ namespace klibrary::linear_algebra::alias_and_concepts {
         { a.sqrt() } -> std::convertible_to<DefaultFPType>;
     };
 
+    template <class T>
+    struct IsComplexType : std::false_type {};
+    template <class T>
+    struct IsComplexType<std::complex<T>> : std::true_type {};
+
+    // std::complexであるかを判定するコンセプト
+    template <class T>
+    concept IsComplex = IsComplexType<T>::value;
+
+    template <class T>
+    struct RealType { using type = T; };
+    template <class T>
+    struct RealType<std::complex<T>> { using type = T; };
+
+    // 複素数型の実部の型 (複素数型以外ではTそのもの)
+    template <class T>
+    using RealTypeOf = typename RealType<T>::type;
+
+    // 複素共役 (複素数型以外ではそのまま返す)
+    template <class T>
+    constexpr T conjugate_of(const T& x) {
+        if constexpr(IsComplex<T>) {
+            return std::conj(x);
+        } else {
+            return x;
+        }
+    }
+
+    /*
+     * スレッドごとに保持される要素型Tの作業領域 (size個以上の要素を持つ) の先頭を返す
+     * 作業領域は要素型ごとに1つであり、必要に応じて拡張され、縮小はされない。
+     * 同じ要素型の作業領域を同時に複数使用する場合は、1回の呼び出しでまとめて確保して分割する。
+     */
+    template <class T>
+    T* workspace(const SizeT& size) {
+        thread_local std::vector<T> buffer;
+        if(buffer.size() < size) {
+            buffer.resize(size);
+        }
+        return buffer.data();
+    }
+
 }
 // ユーザーが使用可能な型やコンセプト
 namespace klibrary::linear_algebra {
@@ -2,10 +2,13 @@
 #define staticmatrix_base_hpp
 #include "staticmatrix_base_shape.hpp"
 #include "./../AliasAndConcepts/staticmatrix_alias_and_concepts.hpp"
+#include "./../Reduction/staticmatrix_reduction.hpp"
+#include "./../Dispatch/staticmatrix_dispatch.hpp"
 #include <array>
 #include <cassert>
 #include <iostream>
 #include <concepts>
+#include <algorithm>
 namespace {
     using namespace klibrary::linear_algebra::alias_and_concepts;
 }
@@ -95,15 +98,13 @@ namespace klibrary::linear_algebra {
             }
             void swap_rows(const SizeT& r1, const SizeT& r2) {
                 assert(r1 < Rows && r2 < Rows);
-                std::array<ElemT, Cols> temp;
+                // 一時配列を経由せずに2行を要素ごとに交換する (行の入れ替えを記録のみ行う場合はStaticPermutationを使用する)
+                if(r1 == r2) {
+                    return;
+                }
                 auto r1_begin = std::next(this->matrix_.begin(), r1 * Cols);
                 auto r2_begin = std::next(this->matrix_.begin(), r2 * Cols);
-                auto r1_end = (r1 == Rows - 1) ? this->matrix_.end() : std::next(this->matrix_.begin(), (r1 + 1) * Cols);
-                auto r2_end = (r2 == Rows - 1) ? this->matrix_.end() : std::next(this->matrix_.begin(), (r2 + 1) * Cols);
-                
-                std::move(r1_begin, r1_end, temp.begin());
-                std::move(r2_begin, r2_end, r1_begin);
-                std::move(temp.begin(), temp.end(), r2_begin);
+                std::swap_ranges(r1_begin, std::next(r1_begin, Cols), r2_begin);
                 return;
             }
             void swap_cols(const SizeT& c1, const SizeT& c2) {
@@ -119,6 +120,11 @@ namespace klibrary::linear_algebra {
                 static_assert(Cols == Cols_R);
                 static_assert(IsConvertibleTo<ElemT_R, ElemT>);
 
+                // 要素数が大きいfloat、doubleの行列は実行時に選択された計算核で計算する
+                if constexpr(std::same_as<ElemT, ElemT_R> && dispatch::DispatchableElement<ElemT> && Rows * Cols >= dispatch::threshold) {
+                    dispatch::kernels<ElemT>().add(this->matrix_.data(), &matrix[0], this->matrix_.data(), Rows * Cols);
+                    return (*this);
+                }
                 for(SizeT i = 0; i < Rows * Cols; ++i) {
                     this->matrix_[i] += static_cast<ElemT>(matrix[i]);
                 }
@@ -130,6 +136,10 @@ namespace klibrary::linear_algebra {
                 static_assert(Cols == Cols_R);
                 static_assert(IsConvertibleTo<ElemT_R, ElemT>);
 
+                if constexpr(std::same_as<ElemT, ElemT_R> && dispatch::DispatchableElement<ElemT> && Rows * Cols >= dispatch::threshold) {
+                    dispatch::kernels<ElemT>().subtract(this->matrix_.data(), &matrix[0], this->matrix_.data(), Rows * Cols);
+                    return (*this);
+                }
                 for(SizeT i = 0; i < Rows * Cols; ++i) {
                     this->matrix_[i] -= static_cast<ElemT>(matrix[i]);
                 }
@@ -144,6 +154,17 @@ namespace klibrary::linear_algebra {
 
                 const SizeT N = Rows;
                 StaticMatrixBase<ElemT, Rows, Cols> result;
+                if constexpr(std::same_as<ElemT, ElemT_R> && dispatch::DispatchableElement<ElemT> && Rows * Cols >= dispatch::threshold) {
+                    dispatch::kernels<ElemT>().gemm(this->matrix_.data(), N, &matrix[0], N, result.matrix_.data(), N, N, N, N);
+                    this->matrix_ = std::move(result.matrix_);
+                    return (*this);
+                }
+                // 複素行列は実部・虚部を分割した形式の計算核で計算する
+                if constexpr(std::same_as<ElemT, ElemT_R> && IsComplex<ElemT> && Rows * Cols >= dispatch::threshold) {
+                    dispatch::complex_gemm(this->matrix_.data(), &matrix[0], result.matrix_.data(), N, N, N);
+                    this->matrix_ = std::move(result.matrix_);
+                    return (*this);
+                }
                 for(SizeT r = 0; r < N; ++r) {
                     for(SizeT i = 0; i < N; ++i) {
                         for(SizeT c = 0; c < N; ++c) {
@@ -162,6 +183,10 @@ namespace klibrary::linear_algebra {
             auto& operator*=(const ScalarType& scalar) {
                 static_assert(IsConvertibleTo<ScalarType, ElemT>);
 
+                if constexpr(std::same_as<ElemT, ScalarType> && dispatch::DispatchableElement<ElemT> && Rows * Cols >= dispatch::threshold) {
+                    dispatch::kernels<ElemT>().scale(scalar, this->matrix_.data(), Rows * Cols);
+                    return (*this);
+                }
                 for(SizeT i = 0; i < Rows * Cols; ++i) {
                     if constexpr(IsMultiplicationDefined<ElemT, ScalarType>) {
                         this->matrix_[i] = static_cast<ElemT>(this->matrix_[i] * scalar);
@@ -247,13 +272,15 @@ namespace klibrary::linear_algebra {
         }
         return result;
     }
-    template <class ElemT_L, SizeT Rows_L, SizeT Cols_L, class ElemT_R, SizeT Rows_R, SizeT Cols_R>
-    auto operator*(
+    // 行列-行列乗算の各要素の総和をPolicyで計算する
+    template <class Policy, class ElemT_L, SizeT Rows_L, SizeT Cols_L, class ElemT_R, SizeT Rows_R, SizeT Cols_R>
+    auto multiply(
         const StaticMatrixBase<ElemT_L, Rows_L, Cols_L>& lhs,
         const StaticMatrixBase<ElemT_R, Rows_R, Cols_R>& rhs
     ) {
         static_assert(Cols_L == Rows_R);
         static_assert(HasCommonTypeWith<ElemT_L, ElemT_R>);
+        static_assert(reduction::ReductionPolicy<Policy>);
 
         using CommonType = CommonTypeOf<ElemT_L, ElemT_R>;
 
@@ -262,20 +289,37 @@ namespace klibrary::linear_algebra {
         constexpr SizeT Mids = Rows_R;
 
         StaticMatrixBase<CommonType, Rows_L, Cols_R> result;
+        // 要素数が大きいfloat、doubleの行列の逐次加算による積は実行時に選択された計算核で計算する (各要素の加算順序は同じ)
+        if constexpr(std::same_as<Policy, reduction::Sequential> && std::same_as<ElemT_L, ElemT_R> && dispatch::DispatchableElement<ElemT_L> && Rows * Cols >= dispatch::threshold) {
+            dispatch::kernels<ElemT_L>().gemm(&lhs[0], Mids, &rhs[0], Cols, &result[0], Cols, Rows, Mids, Cols);
+            return result;
+        }
+        // 複素行列は実部・虚部を分割した形式の計算核(split_complex::multiplyと同じ)で計算する。加算順序は異なる
+        if constexpr(std::same_as<Policy, reduction::Sequential> && std::same_as<ElemT_L, ElemT_R> && IsComplex<ElemT_L> && Rows * Cols >= dispatch::threshold) {
+            dispatch::complex_gemm(&lhs[0], &rhs[0], &result[0], Rows, Mids, Cols);
+            return result;
+        }
         for(SizeT r = 0; r < Rows; ++r) {
             for(SizeT c = 0; c < Cols; ++c) {
-                for(SizeT m = 0; m < Mids; ++m) {
+                result(r, c) = Policy::template sum<CommonType>(Mids, [&](const SizeT& m) {
                     if constexpr(IsMultiplicationDefined<ElemT_L, ElemT_R>) {
-                        result(r, c) += static_cast<CommonType>(lhs(r, m) * rhs(m, c));
+                        return static_cast<CommonType>(lhs(r, m) * rhs(m, c));
                     } else {
                         static_assert(IsMultiplicationDefined<CommonType, CommonType>);
-                        result(r, c) += static_cast<CommonType>(lhs(r, m)) * static_cast<CommonType>(rhs(m, c));
+                        return static_cast<CommonType>(static_cast<CommonType>(lhs(r, m)) * static_cast<CommonType>(rhs(m, c)));
                     }
-                }
+                });
             }
         }
         return result;
     }
+    template <class ElemT_L, SizeT Rows_L, SizeT Cols_L, class ElemT_R, SizeT Rows_R, SizeT Cols_R>
+    auto operator*(
+        const StaticMatrixBase<ElemT_L, Rows_L, Cols_L>& lhs,
+        const StaticMatrixBase<ElemT_R, Rows_R, Cols_R>& rhs
+    ) {
+        return multiply<DefaultReduction>(lhs, rhs);
+    }
     template <class ElemT, SizeT Rows, SizeT Cols, class ScalarType>
     auto operator*(
         const StaticMatrixBase<ElemT, Rows, Cols>& lhs,
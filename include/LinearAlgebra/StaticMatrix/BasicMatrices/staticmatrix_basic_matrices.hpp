@@ -2,6 +2,7 @@
 #define staticmatrix_basic_matrices_hpp
 #include "./../AliasAndConcepts/staticmatrix_alias_and_concepts.hpp"
 #include "./../Base/staticmatrix_base.hpp"
+#include "./../Random/staticmatrix_random.hpp"
 namespace {
     using namespace klibrary::linear_algebra::alias_and_concepts;
 }
@@ -55,6 +56,38 @@ namespace klibrary::linear_algebra {
                 }
                 return diagonal_matrix;
             }
+            // 各成分が[low, high)の一様乱数である行列
+            static auto Random(Philox4x32& engine, const ElemT& low = ElemT(0), const ElemT& high = ElemT(1)) {
+                static_assert(FloatingPoint<ElemT>);
+                StaticMatrixBasicMatrices<ElemT, Rows, Cols> uniform_matrix;
+                random_matrix::fill_uniform(engine, &uniform_matrix[0], Rows * Cols, low, high);
+                return uniform_matrix;
+            }
+            // 各成分が平均mean、標準偏差stddevの正規乱数である行列
+            static auto RandomNormal(Philox4x32& engine, const ElemT& mean = ElemT(0), const ElemT& stddev = ElemT(1)) {
+                static_assert(FloatingPoint<ElemT>);
+                StaticMatrixBasicMatrices<ElemT, Rows, Cols> normal_matrix;
+                random_matrix::fill_normal(engine, &normal_matrix[0], Rows * Cols, mean, stddev);
+                return normal_matrix;
+            }
+            // Haar測度に従う直交行列
+            static auto RandomOrthogonal(Philox4x32& engine) {
+                static_assert(Rows == Cols);
+                auto orthogonal_matrix = RandomNormal(engine);
+                random_matrix::orthogonalize(orthogonal_matrix);
+                return orthogonal_matrix;
+            }
+            // 固有値が[min_eigenvalue, max_eigenvalue)の一様乱数である対称正定値行列 Q diag(λ) Q^T (QはRandomOrthogonal)
+            static auto RandomSPD(Philox4x32& engine, const ElemT& min_eigenvalue = ElemT(1), const ElemT& max_eigenvalue = ElemT(Rows)) {
+                static_assert(Rows == Cols);
+                assert(ElemT(0) < min_eigenvalue && min_eigenvalue <= max_eigenvalue);
+                const auto q = RandomOrthogonal(engine);
+                Array<ElemT, Rows> eigenvalues;
+                random_matrix::fill_uniform(engine, eigenvalues.data(), Rows, min_eigenvalue, max_eigenvalue);
+                StaticMatrixBasicMatrices<ElemT, Rows, Cols> spd_matrix;
+                random_matrix::congruence(spd_matrix, q, eigenvalues.data());
+                return spd_matrix;
+            }
     };
 }
 #endif // staticmatrix_basic_matrices_hpp
\ No newline at end of file
@@ -29,6 +29,28 @@ namespace klibrary::linear_algebra {
                 }
                 return (*this);
             }
+            // 共役転置 (エルミート転置)。複素数型以外では転置と同じ
+            static auto ConjugateTranspose(const StaticMatrixBasicTransforms& input) {
+                StaticMatrixBasicTransforms<ElemT, Cols, Rows> output;
+                for(SizeT r = 0; r < Rows; ++r) {
+                    for(SizeT c = 0; c < Cols; ++c) {
+                        output(c, r) = conjugate_of(input(r, c));
+                    }
+                }
+                return output;
+            }
+            auto conjugate_transpose() {
+                static_assert(Rows == Cols);
+                for(SizeT r = 0; r < Rows; ++r) {
+                    (*this)(r, r) = conjugate_of((*this)(r, r));
+                    for(SizeT c = r + 1; c < Cols; ++c) {
+                        const ElemT upper = (*this)(r, c);
+                        (*this)(r, c) = conjugate_of((*this)(c, r));
+                        (*this)(c, r) = conjugate_of(upper);
+                    }
+                }
+                return (*this);
+            }
     };
 }
 #endif // staticmatrix_basic_transforms_hpp
\ No newline at end of file
@@ -0,0 +1,51 @@
+#ifndef staticmatrix_complex_hpp
+#define staticmatrix_complex_hpp
+#include "./../AliasAndConcepts/staticmatrix_alias_and_concepts.hpp"
+#include "./../Base/staticmatrix_base.hpp"
+#include "./../Dispatch/staticmatrix_dispatch.hpp"
+#include <cmath>
+#include <complex>
+namespace {
+    using namespace klibrary::linear_algebra::alias_and_concepts;
+}
+/*
+ * 複素行列の積の計算核 (分割形式)
+ *
+ * std::complex<T>の行列は実部と虚部が交互に並ぶため、そのままでは積の実部と虚部の計算を
+ * 同じ命令列でSIMD化できない。右オペランドを実部と虚部の2つの平面に並べ替えてから、
+ * 1行分の結果も実部・虚部別々の平面に累積することで、最内ループは連続したT型の配列同士の
+ * 積和のみとなり、SIMD化が行われる。
+ * Tがfloat、doubleの場合は実行時に選択された命令セットの計算核(dispatch::Kernels::complex_gemm、complex_dot)を使用する。
+ * 積和の縮約は行わないため、結果は命令セットによらず一致する。並べ替えの作業領域はスレッドごとに保持し、再利用する。
+ */
+namespace klibrary::linear_algebra::split_complex {
+    // result = lhs * rhs
+    template <class T, SizeT Rows, SizeT Mids, SizeT Cols>
+    void multiply(
+        const StaticMatrixBase<std::complex<T>, Rows, Mids>& lhs,
+        const StaticMatrixBase<std::complex<T>, Mids, Cols>& rhs,
+        StaticMatrixBase<std::complex<T>, Rows, Cols>& result
+    ) {
+        dispatch::complex_gemm(&lhs[0], &rhs[0], &result[0], Rows, Mids, Cols);
+    }
+
+    // y = matrix * x (x, yは添え字演算子を持つ長さCols, Rowsの型)
+    template <class T, SizeT Rows, SizeT Cols, class VectorIn, class VectorOut>
+    void multiply_vector(const StaticMatrixBase<std::complex<T>, Rows, Cols>& matrix, const VectorIn& x, VectorOut& y) {
+        T* const x_real = workspace<T>(2 * Cols);
+        T* const x_imag = x_real + Cols;
+        for(SizeT c = 0; c < Cols; ++c) {
+            const std::complex<T> value = x[c];
+            x_real[c] = value.real();
+            x_imag[c] = value.imag();
+        }
+        for(SizeT r = 0; r < Rows; ++r) {
+            if constexpr(dispatch::DispatchableElement<T>) {
+                y[r] = dispatch::kernels<T>().complex_dot(&matrix(r, 0), x_real, x_imag, Cols);
+            } else {
+                y[r] = dispatch::body::complex_dot(&matrix(r, 0), x_real, x_imag, Cols);
+            }
+        }
+    }
+}
+#endif // staticmatrix_complex_hpp
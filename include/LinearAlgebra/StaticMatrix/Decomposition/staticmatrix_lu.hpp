@@ -0,0 +1,132 @@
+#ifndef staticmatrix_lu_hpp
+#define staticmatrix_lu_hpp
+#include "./../AliasAndConcepts/staticmatrix_alias_and_concepts.hpp"
+#include "./../Base/staticmatrix_base.hpp"
+#include "./../Permutation/staticmatrix_permutation.hpp"
+#include <cmath>
+#include <cassert>
+#include <type_traits>
+namespace {
+    using namespace klibrary::linear_algebra::alias_and_concepts;
+}
+namespace klibrary::linear_algebra {
+    /*
+     * 部分ピボット選択付きLU分解 PA = LU
+     *
+     * 分解結果は内部の行列1つにLとUをまとめて保持し(Lの対角成分1は保持しない)、ヒープ確保を行わない。
+     * ピボット選択による行の入れ替えはStaticPermutationに記録するのみで行は移動せず、LUのk行は内部の行列のP[k]行に置かれる。
+     * 一度分解すれば右辺を変えて何度でもsolve_in_placeで解くことができる。
+     */
+    template <class ElemT, SizeT N>
+    class StaticMatrixLU {
+        private:
+            StaticMatrixBase<ElemT, N, N> lu_;
+            StaticPermutation<N> permutation_;
+            bool singular_ = true;
+            bool odd_permutation_ = false;
+
+            static auto magnitude(const ElemT& x) {
+                using std::abs;
+                return abs(x);
+            }
+        public:
+            StaticMatrixLU() = default;
+            StaticMatrixLU(const StaticMatrixBase<ElemT, N, N>& matrix) {
+                this->factorize(matrix);
+            }
+
+            // matrixをLU分解する。特異である(ピボットが0になる)場合はfalseを返す
+            bool factorize(const StaticMatrixBase<ElemT, N, N>& matrix) {
+                this->lu_ = matrix;
+                this->permutation_ = StaticPermutation<N>();
+                this->singular_ = false;
+                this->odd_permutation_ = false;
+                const auto& row = this->permutation_.map();
+                for(SizeT k = 0; k < N; ++k) {
+                    SizeT p = k;
+                    auto max = magnitude(this->lu_(row[k], k));
+                    for(SizeT r = k + 1; r < N; ++r) {
+                        const auto candidate = magnitude(this->lu_(row[r], k));
+                        if(max < candidate) {
+                            max = candidate;
+                            p = r;
+                        }
+                    }
+                    if(p != k) {
+                        this->permutation_.swap(k, p);
+                        this->odd_permutation_ = !this->odd_permutation_;
+                    }
+                    const SizeT pivot_row = row[k];
+                    if(this->lu_(pivot_row, k) == ElemT()) {
+                        this->singular_ = true;
+                        continue;
+                    }
+                    const ElemT inverse_pivot = ElemT(1) / this->lu_(pivot_row, k);
+                    for(SizeT r = k + 1; r < N; ++r) {
+                        const SizeT target = row[r];
+                        const ElemT factor = this->lu_(target, k) * inverse_pivot;
+                        this->lu_(target, k) = factor;
+                        for(SizeT c = k + 1; c < N; ++c) {
+                            this->lu_(target, c) -= factor * this->lu_(pivot_row, c);
+                        }
+                    }
+                }
+                return !this->singular_;
+            }
+
+            bool singular() const noexcept {
+                return this->singular_;
+            }
+            // PA = LUとなる置換P
+            const StaticPermutation<N>& permutation() const noexcept {
+                return this->permutation_;
+            }
+
+            // Ax = bを解き、bをxで置き換える (Vectorは添え字演算子を持つ長さNの型)
+            // 置換Pは前進代入の際にPbを読み出すことで適用する
+            template <class Vector>
+            void solve_in_place(Vector& b) const {
+                assert(!this->singular_);
+                const auto& row = this->permutation_.map();
+                Array<std::remove_cvref_t<decltype(b[0])>, N> y;
+                for(SizeT r = 0; r < N; ++r) {
+                    y[r] = b[row[r]];
+                    for(SizeT c = 0; c < r; ++c) {
+                        y[r] -= this->lu_(row[r], c) * y[c];
+                    }
+                }
+                for(SizeT r = N; r-- > 0;) {
+                    for(SizeT c = r + 1; c < N; ++c) {
+                        y[r] -= this->lu_(row[r], c) * y[c];
+                    }
+                    y[r] /= this->lu_(row[r], r);
+                    b[r] = y[r];
+                }
+            }
+
+            // 行列式を返す
+            ElemT determinant() const {
+                auto result = this->odd_permutation_ ? ElemT(-1) : ElemT(1);
+                for(SizeT i = 0; i < N; ++i) {
+                    result *= this->lu_(this->permutation_[i], i);
+                }
+                return result;
+            }
+
+            // 逆行列を返す
+            StaticMatrixBase<ElemT, N, N> inverse() const {
+                StaticMatrixBase<ElemT, N, N> result;
+                Array<ElemT, N> column;
+                for(SizeT c = 0; c < N; ++c) {
+                    column.fill(ElemT());
+                    column[c] = ElemT(1);
+                    this->solve_in_place(column);
+                    for(SizeT r = 0; r < N; ++r) {
+                        result(r, c) = column[r];
+                    }
+                }
+                return result;
+            }
+    };
+}
+#endif // staticmatrix_lu_hpp
@@ -0,0 +1,361 @@
+#ifndef staticmatrix_dispatch_hpp
+#define staticmatrix_dispatch_hpp
+#include "./../AliasAndConcepts/staticmatrix_alias_and_concepts.hpp"
+#include <atomic>
+#include <complex>
+#include <concepts>
+#include <algorithm>
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#endif
+namespace {
+    using namespace klibrary::linear_algebra::alias_and_concepts;
+}
+/*
+ * 実行時の命令セットによる計算核の選択
+ *
+ * 各計算核を命令セットごとに(GCC、Clangのtarget属性により)コンパイルしておき、
+ * 最初の使用時にCPUが対応する最も新しい命令セットの計算核を選択する。
+ * 選択した計算核の表は保持され、以降の呼び出しのオーバーヘッドは間接呼び出し1回のみである。
+ *
+ * 計算核の本体は命令セットによらず共通であり、総和は常に16個のアキュムレータ(MultiAccumulator<16>と同じ順序)で行う。
+ * 計算核の内部では積和の縮約(FMAへの変換)を無効にしている (GCCはoptimize("fp-contract=off")属性、Clangは#pragma clang fp contract(off))。
+ * GCCはC++では既定で縮約を行い、target("avx2,fma")の関数ではFMAが使用可能となるため、無効にしなければ結果がCPUによって異なる。
+ * これにより結果は選択された命令セットおよびコンパイルオプションによらずビット単位で一致する(複素行列の計算核も含む)。
+ * target属性を使用できないコンパイラ(MSVC)およびx86以外では全ての命令セットでScalarの計算核を使用する。
+ */
+namespace klibrary::linear_algebra::dispatch {
+    enum class InstructionSet { Scalar, SSE42, AVX2, AVX512 };
+
+    // 計算核の対象となる要素型
+    template <class T>
+    concept DispatchableElement = std::same_as<T, float> || std::same_as<T, double>;
+
+    // CPUが対応する最も新しい命令セットを返す
+    inline InstructionSet detect_instruction_set() {
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+        __builtin_cpu_init();
+        if(__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512vl") && __builtin_cpu_supports("avx512bw") && __builtin_cpu_supports("avx512dq")) {
+            return InstructionSet::AVX512;
+        }
+        if(__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+            return InstructionSet::AVX2;
+        }
+        if(__builtin_cpu_supports("sse4.2")) {
+            return InstructionSet::SSE42;
+        }
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+        int info[4];
+        __cpuid(info, 1);
+        const bool sse42 = (info[2] >> 20) & 1;
+        const bool fma = (info[2] >> 12) & 1;
+        // OSがAVX(およびAVX-512)のレジスタを保存するか
+        const bool osxsave = (info[2] >> 27) & 1;
+        const unsigned long long xcr0 = osxsave ? _xgetbv(0) : 0;
+        __cpuidex(info, 7, 0);
+        const bool avx2 = (info[1] >> 5) & 1;
+        const bool avx512 = ((info[1] >> 16) & 1) && ((info[1] >> 17) & 1) && ((info[1] >> 30) & 1) && ((info[1] >> 31) & 1);
+        if(avx512 && (xcr0 & 0xE6) == 0xE6) {
+            return InstructionSet::AVX512;
+        }
+        if(avx2 && fma && (xcr0 & 0x6) == 0x6) {
+            return InstructionSet::AVX2;
+        }
+        if(sse42) {
+            return InstructionSet::SSE42;
+        }
+#endif
+        return InstructionSet::Scalar;
+    }
+    inline InstructionSet detected_instruction_set() {
+        static const InstructionSet detected = detect_instruction_set();
+        return detected;
+    }
+
+    /*
+     * 計算核の本体
+     *
+     * 行列は先頭要素へのポインタと行の間隔(leading dimension)で表す。
+     */
+#if defined(__clang__)
+#define KLIBRARY_DISPATCH_INLINE [[gnu::always_inline]] inline
+#define KLIBRARY_DISPATCH_NO_CONTRACT
+#define KLIBRARY_DISPATCH_CONTRACT_OFF _Pragma("clang fp contract(off)")
+#elif defined(__GNUC__)
+// 縮約はインライン展開後に呼び出し側の関数の設定で行われるため、本体と命令セットごとの関数の両方に指定する
+#define KLIBRARY_DISPATCH_INLINE [[gnu::always_inline, gnu::optimize("fp-contract=off")]] inline
+#define KLIBRARY_DISPATCH_NO_CONTRACT __attribute__((optimize("fp-contract=off")))
+#define KLIBRARY_DISPATCH_CONTRACT_OFF
+#else
+#define KLIBRARY_DISPATCH_INLINE inline
+#define KLIBRARY_DISPATCH_NO_CONTRACT
+#define KLIBRARY_DISPATCH_CONTRACT_OFF
+#endif
+    namespace body {
+        constexpr SizeT lanes = 16;
+
+        template <class T>
+        KLIBRARY_DISPATCH_INLINE T reduce_lanes(T (&accumulator)[lanes]) {
+            KLIBRARY_DISPATCH_CONTRACT_OFF
+            for(SizeT width = lanes / 2; width > 0; width /= 2) {
+                for(SizeT l = 0; l < width; ++l) {
+                    accumulator[l] += accumulator[l + width];
+                }
+            }
+            return accumulator[0];
+        }
+        template <class T>
+        KLIBRARY_DISPATCH_INLINE T dot(const T* a, const T* b, const SizeT& n) {
+            KLIBRARY_DISPATCH_CONTRACT_OFF
+            T accumulator[lanes] = {};
+            SizeT i = 0;
+            for(; i + lanes <= n; i += lanes) {
+                for(SizeT l = 0; l < lanes; ++l) {
+                    accumulator[l] += a[i + l] * b[i + l];
+                }
+            }
+            for(SizeT l = 0; l < n - i; ++l) {
+                accumulator[l] += a[i + l] * b[i + l];
+            }
+            return reduce_lanes(accumulator);
+        }
+        template <class T>
+        KLIBRARY_DISPATCH_INLINE T sum_of_squares(const T* a, const SizeT& n) {
+            return dot(a, a, n);
+        }
+        // out = a + b, out = a - b
+        template <class T>
+        KLIBRARY_DISPATCH_INLINE void add(const T* a, const T* b, T* out, const SizeT& n) {
+            for(SizeT i = 0; i < n; ++i) {
+                out[i] = a[i] + b[i];
+            }
+        }
+        template <class T>
+        KLIBRARY_DISPATCH_INLINE void subtract(const T* a, const T* b, T* out, const SizeT& n) {
+            for(SizeT i = 0; i < n; ++i) {
+                out[i] = a[i] - b[i];
+            }
+        }
+        template <class T>
+        KLIBRARY_DISPATCH_INLINE void scale(const T& alpha, T* x, const SizeT& n) {
+            for(SizeT i = 0; i < n; ++i) {
+                x[i] *= alpha;
+            }
+        }
+        // y += alpha * x
+        template <class T>
+        KLIBRARY_DISPATCH_INLINE void axpy(const T& alpha, const T* x, T* y, const SizeT& n) {
+            KLIBRARY_DISPATCH_CONTRACT_OFF
+            for(SizeT i = 0; i < n; ++i) {
+                y[i] += alpha * x[i];
+            }
+        }
+        /*
+         * c = a * b (a: m x k, b: k x nの複素行列。各行列は行の間に隙間なく並んでいるものとする)
+         *
+         * std::complex<T>は実部と虚部が交互に並ぶため、bを実部と虚部の2つの平面に並べ替え、1行分の結果も
+         * 実部・虚部別々の平面に累積する。最内ループは連続したT型の配列同士の積和のみとなりSIMD化される。
+         * 並べ替えの作業領域はスレッドごとに保持し、再利用する。
+         */
+        template <class T>
+        KLIBRARY_DISPATCH_INLINE void complex_gemm(const std::complex<T>* a, const std::complex<T>* b, std::complex<T>* c, const SizeT& m, const SizeT& k, const SizeT& n) {
+            KLIBRARY_DISPATCH_CONTRACT_OFF
+            T* const b_real = workspace<T>(2 * k * n + 2 * n);
+            T* const b_imag = b_real + k * n;
+            T* const real = b_imag + k * n;
+            T* const imag = real + n;
+            for(SizeT i = 0; i < k * n; ++i) {
+                b_real[i] = b[i].real();
+                b_imag[i] = b[i].imag();
+            }
+            for(SizeT r = 0; r < m; ++r) {
+                for(SizeT j = 0; j < n; ++j) {
+                    real[j] = T();
+                    imag[j] = T();
+                }
+                for(SizeT p = 0; p < k; ++p) {
+                    const T ar = a[r * k + p].real();
+                    const T ai = a[r * k + p].imag();
+                    const T* const br = b_real + p * n;
+                    const T* const bi = b_imag + p * n;
+                    for(SizeT j = 0; j < n; ++j) {
+                        real[j] = ar * br[j] + (real[j] - ai * bi[j]);
+                        imag[j] = ar * bi[j] + (imag[j] + ai * br[j]);
+                    }
+                }
+                for(SizeT j = 0; j < n; ++j) {
+                    c[r * n + j] = std::complex<T>(real[j], imag[j]);
+                }
+            }
+        }
+        // Σ a_i x_i (xは実部x_realと虚部x_imagの平面に分割した複素ベクトル)
+        template <class T>
+        KLIBRARY_DISPATCH_INLINE std::complex<T> complex_dot(const std::complex<T>* a, const T* x_real, const T* x_imag, const SizeT& n) {
+            KLIBRARY_DISPATCH_CONTRACT_OFF
+            constexpr SizeT width = 4;
+            // aは実部と虚部が交互に並ぶT型の配列として読む
+            const T* const values = reinterpret_cast<const T*>(a);
+            T real[width] = {}, imag[width] = {};
+            SizeT i = 0;
+            for(; i + width <= n; i += width) {
+                for(SizeT l = 0; l < width; ++l) {
+                    const T ar = values[2 * (i + l)], ai = values[2 * (i + l) + 1];
+                    real[l] = ar * x_real[i + l] + (real[l] - ai * x_imag[i + l]);
+                    imag[l] = ar * x_imag[i + l] + (imag[l] + ai * x_real[i + l]);
+                }
+            }
+            for(SizeT l = 0; l < n - i; ++l) {
+                const T ar = values[2 * (i + l)], ai = values[2 * (i + l) + 1];
+                real[l] = ar * x_real[i + l] + (real[l] - ai * x_imag[i + l]);
+                imag[l] = ar * x_imag[i + l] + (imag[l] + ai * x_real[i + l]);
+            }
+            return std::complex<T>((real[0] + real[1]) + (real[2] + real[3]), (imag[0] + imag[1]) + (imag[2] + imag[3]));
+        }
+        // c = a * b (a: m x k, b: k x n)。kとnについて64要素ずつブロック化し、各要素は積をkの昇順に加える
+        template <class T>
+        KLIBRARY_DISPATCH_INLINE void gemm(const T* a, const SizeT& lda, const T* b, const SizeT& ldb, T* c, const SizeT& ldc, const SizeT& m, const SizeT& k, const SizeT& n) {
+            KLIBRARY_DISPATCH_CONTRACT_OFF
+            constexpr SizeT block = 64;
+            for(SizeT r = 0; r < m; ++r) {
+                for(SizeT j = 0; j < n; ++j) {
+                    c[r * ldc + j] = T();
+                }
+            }
+            for(SizeT kk = 0; kk < k; kk += block) {
+                const SizeT k_end = std::min(k, kk + block);
+                for(SizeT jj = 0; jj < n; jj += block) {
+                    const SizeT j_end = std::min(n, jj + block);
+                    for(SizeT r = 0; r < m; ++r) {
+                        T* const c_row = c + r * ldc;
+                        for(SizeT p = kk; p < k_end; ++p) {
+                            const T x = a[r * lda + p];
+                            const T* const b_row = b + p * ldb;
+                            for(SizeT j = jj; j < j_end; ++j) {
+                                c_row[j] += x * b_row[j];
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    // 命令セットごとの計算核の表
+    template <DispatchableElement T>
+    struct Kernels {
+        T       (*dot)(const T*, const T*, const SizeT&);
+        T       (*sum_of_squares)(const T*, const SizeT&);
+        void    (*add)(const T*, const T*, T*, const SizeT&);
+        void    (*subtract)(const T*, const T*, T*, const SizeT&);
+        void    (*scale)(const T&, T*, const SizeT&);
+        void    (*axpy)(const T&, const T*, T*, const SizeT&);
+        void    (*gemm)(const T*, const SizeT&, const T*, const SizeT&, T*, const SizeT&, const SizeT&, const SizeT&, const SizeT&);
+        void    (*complex_gemm)(const std::complex<T>*, const std::complex<T>*, std::complex<T>*, const SizeT&, const SizeT&, const SizeT&);
+        std::complex<T> (*complex_dot)(const std::complex<T>*, const T*, const T*, const SizeT&);
+    };
+
+    // 計算核の本体をtarget属性付きの関数として実体化する (本体は関数内にインライン展開され、その命令セットでベクトル化される)
+#define KLIBRARY_DISPATCH_KERNELS(isa, attribute)                                                                                                                  \
+    template <DispatchableElement T>                                                                                                                               \
+    struct isa {                                                                                                                                                   \
+        attribute KLIBRARY_DISPATCH_NO_CONTRACT static T dot(const T* a, const T* b, const SizeT& n) { return body::dot(a, b, n); }                                \
+        attribute KLIBRARY_DISPATCH_NO_CONTRACT static T sum_of_squares(const T* a, const SizeT& n) { return body::sum_of_squares(a, n); }                         \
+        attribute KLIBRARY_DISPATCH_NO_CONTRACT static void add(const T* a, const T* b, T* out, const SizeT& n) { body::add(a, b, out, n); }                       \
+        attribute KLIBRARY_DISPATCH_NO_CONTRACT static void subtract(const T* a, const T* b, T* out, const SizeT& n) { body::subtract(a, b, out, n); }             \
+        attribute KLIBRARY_DISPATCH_NO_CONTRACT static void scale(const T& alpha, T* x, const SizeT& n) { body::scale(alpha, x, n); }                              \
+        attribute KLIBRARY_DISPATCH_NO_CONTRACT static void axpy(const T& alpha, const T* x, T* y, const SizeT& n) { body::axpy(alpha, x, y, n); }                 \
+        attribute KLIBRARY_DISPATCH_NO_CONTRACT static void gemm(const T* a, const SizeT& lda, const T* b, const SizeT& ldb, T* c, const SizeT& ldc,               \
+                                                                 const SizeT& m, const SizeT& k, const SizeT& n) { body::gemm(a, lda, b, ldb, c, ldc, m, k, n); }  \
+        attribute KLIBRARY_DISPATCH_NO_CONTRACT static void complex_gemm(const std::complex<T>* a, const std::complex<T>* b, std::complex<T>* c,                   \
+                                                                         const SizeT& m, const SizeT& k, const SizeT& n) { body::complex_gemm(a, b, c, m, k, n); } \
+        attribute KLIBRARY_DISPATCH_NO_CONTRACT static std::complex<T> complex_dot(const std::complex<T>* a, const T* x_real, const T* x_imag, const SizeT& n) {   \
+            return body::complex_dot(a, x_real, x_imag, n);                                                                                                        \
+        }                                                                                                                                                          \
+        static constexpr Kernels<T> table = {dot, sum_of_squares, add, subtract, scale, axpy, gemm, complex_gemm, complex_dot};                                    \
+    };
+
+    namespace target {
+        KLIBRARY_DISPATCH_KERNELS(Scalar, )
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+        KLIBRARY_DISPATCH_KERNELS(SSE42, __attribute__((target("sse4.2"))))
+        KLIBRARY_DISPATCH_KERNELS(AVX2, __attribute__((target("avx2,fma"))))
+        KLIBRARY_DISPATCH_KERNELS(AVX512, __attribute__((target("avx512f,avx512vl,avx512bw,avx512dq,fma"))))
+#else
+        template <DispatchableElement T> using SSE42  = Scalar<T>;
+        template <DispatchableElement T> using AVX2   = Scalar<T>;
+        template <DispatchableElement T> using AVX512 = Scalar<T>;
+#endif
+    }
+#undef KLIBRARY_DISPATCH_KERNELS
+#undef KLIBRARY_DISPATCH_INLINE
+#undef KLIBRARY_DISPATCH_NO_CONTRACT
+#undef KLIBRARY_DISPATCH_CONTRACT_OFF
+
+    template <DispatchableElement T>
+    const Kernels<T>& kernels_for(const InstructionSet& isa) {
+        switch(isa) {
+        case InstructionSet::AVX512:
+            return target::AVX512<T>::table;
+        case InstructionSet::AVX2:
+            return target::AVX2<T>::table;
+        case InstructionSet::SSE42:
+            return target::SSE42<T>::table;
+        default:
+            return target::Scalar<T>::table;
+        }
+    }
+
+    namespace state {
+        inline std::atomic<InstructionSet>& active() {
+            static std::atomic<InstructionSet> isa(detected_instruction_set());
+            return isa;
+        }
+        template <DispatchableElement T>
+        std::atomic<const Kernels<T>*>& kernels() {
+            static std::atomic<const Kernels<T>*> table(&kernels_for<T>(active().load()));
+            return table;
+        }
+    }
+
+    // 現在選択されている命令セット
+    inline InstructionSet active_instruction_set() {
+        return state::active().load(std::memory_order_relaxed);
+    }
+
+    /*
+     * 使用する命令セットを変更し、変更前の命令セットを返す (テスト用)
+     * CPUが対応しない命令セットを指定した場合はdetected_instruction_set()に制限される。
+     * 他のスレッドが計算核を実行中に呼び出した場合、そのスレッドは次の呼び出しから新しい計算核を使用する。
+     */
+    inline InstructionSet set_instruction_set(const InstructionSet& isa) {
+        const InstructionSet selected = std::min(isa, detected_instruction_set());
+        const InstructionSet previous = state::active().exchange(selected);
+        state::kernels<float>().store(&kernels_for<float>(selected));
+        state::kernels<double>().store(&kernels_for<double>(selected));
+        return previous;
+    }
+    // CPUが対応する最も新しい命令セットに戻す
+    inline void reset_instruction_set() {
+        set_instruction_set(detected_instruction_set());
+    }
+
+    // 選択されている計算核の表
+    template <DispatchableElement T>
+    const Kernels<T>& kernels() {
+        return *state::kernels<T>().load(std::memory_order_relaxed);
+    }
+
+    // 計算核の呼び出しが間接呼び出しのオーバーヘッドに見合う要素数
+    inline constexpr SizeT threshold = 64;
+
+    // c = a * b (複素行列。Tがfloat、doubleの場合は選択されている計算核、それ以外は本体で計算する)
+    template <class T>
+    void complex_gemm(const std::complex<T>* a, const std::complex<T>* b, std::complex<T>* c, const SizeT& m, const SizeT& k, const SizeT& n) {
+        if constexpr(DispatchableElement<T>) {
+            kernels<T>().complex_gemm(a, b, c, m, k, n);
+        } else {
+            body::complex_gemm(a, b, c, m, k, n);
+        }
+    }
+}
+#endif // staticmatrix_dispatch_hpp
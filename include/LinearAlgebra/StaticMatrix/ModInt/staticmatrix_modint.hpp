@@ -0,0 +1,124 @@
+#ifndef staticmatrix_modint_hpp
+#define staticmatrix_modint_hpp
+#include "./../AliasAndConcepts/staticmatrix_alias_and_concepts.hpp"
+#include <cstdint>
+#include <concepts>
+#include <iostream>
+namespace klibrary::linear_algebra {
+    /*
+     * 法Modulusの剰余環の元 (Montgomery表現)
+     *
+     * 値xをx * 2^32 mod Modulusとして保持し、乗算を除算なしのMontgomery還元で行う。
+     * Modulusは2^30未満の奇数であり、除算(逆元)はModulusが素数である場合のみ正しい。
+     *
+     * 行列の要素型として使用した場合、multiply_into(およびpow)の内積では積を64bitのまま加算し、
+     * 1要素あたり1回だけ還元する(遅延還元)。このためにlazy_product、lazy_add、lazy_reduceを提供する。
+     */
+    template <std::uint32_t Modulus>
+    class ModInt {
+        private:
+            static_assert(Modulus % 2 == 1 && Modulus < (std::uint32_t(1) << 30));
+
+            // -Modulus^-1 mod 2^32 (Newton法により求める)
+            static constexpr std::uint32_t negative_inverse = [] {
+                std::uint32_t inverse = Modulus;
+                for(int i = 0; i < 5; ++i) {
+                    inverse *= 2 - Modulus * inverse;
+                }
+                return -inverse;
+            }();
+            // 2^64 mod Modulus
+            static constexpr std::uint32_t r2 = [] {
+                const std::uint64_t r = (std::uint64_t(1) << 32) % Modulus;
+                return static_cast<std::uint32_t>(r * r % Modulus);
+            }();
+            // 遅延還元の累積値の上限 (Modulus * 2^32 未満であればreduceできる)
+            static constexpr std::uint64_t lazy_bound = std::uint64_t(Modulus) << 32;
+
+            std::uint32_t value_ = 0;
+
+            // t * 2^-32 mod Modulus (t < Modulus * 2^32)
+            static constexpr std::uint32_t reduce(const std::uint64_t& t) noexcept {
+                const std::uint32_t u = static_cast<std::uint32_t>(t) * negative_inverse;
+                const auto result = static_cast<std::uint32_t>((t + std::uint64_t(u) * Modulus) >> 32);
+                return result >= Modulus ? result - Modulus : result;
+            }
+            static constexpr ModInt from_raw(const std::uint32_t& raw) noexcept {
+                ModInt result;
+                result.value_ = raw;
+                return result;
+            }
+        public:
+            using Wide = std::uint64_t;
+
+            constexpr ModInt() noexcept = default;
+            template <std::integral T>
+            constexpr ModInt(const T& x) noexcept {
+                std::int64_t normalized;
+                if constexpr(std::signed_integral<T>) {
+                    normalized = static_cast<std::int64_t>(x % static_cast<std::int64_t>(Modulus));
+                    normalized += normalized < 0 ? Modulus : 0;
+                } else {
+                    normalized = static_cast<std::int64_t>(x % Modulus);
+                }
+                this->value_ = reduce(static_cast<std::uint64_t>(normalized) * r2);
+            }
+
+            static constexpr std::uint32_t modulus() noexcept { return Modulus; }
+            // 通常の表現での値 [0, Modulus)
+            constexpr std::uint32_t value() const noexcept { return reduce(this->value_); }
+
+            constexpr ModInt& operator+=(const ModInt& x) noexcept {
+                this->value_ += x.value_;
+                this->value_ -= this->value_ >= Modulus ? Modulus : 0;
+                return (*this);
+            }
+            constexpr ModInt& operator-=(const ModInt& x) noexcept {
+                this->value_ += this->value_ < x.value_ ? Modulus - x.value_ : -x.value_;
+                return (*this);
+            }
+            constexpr ModInt& operator*=(const ModInt& x) noexcept {
+                this->value_ = reduce(std::uint64_t(this->value_) * x.value_);
+                return (*this);
+            }
+            constexpr ModInt& operator/=(const ModInt& x) noexcept {
+                return (*this) *= x.inverse();
+            }
+            constexpr ModInt pow(std::uint64_t k) const noexcept {
+                ModInt result = 1, base = (*this);
+                for(; k > 0; k >>= 1) {
+                    if(k & 1) {
+                        result *= base;
+                    }
+                    base *= base;
+                }
+                return result;
+            }
+            // Fermatの小定理による逆元
+            constexpr ModInt inverse() const noexcept {
+                return this->pow(Modulus - 2);
+            }
+
+            friend constexpr ModInt operator+(const ModInt& x) noexcept { return x; }
+            friend constexpr ModInt operator-(const ModInt& x) noexcept { return ModInt() -= x; }
+            friend constexpr ModInt operator+(ModInt lhs, const ModInt& rhs) noexcept { return lhs += rhs; }
+            friend constexpr ModInt operator-(ModInt lhs, const ModInt& rhs) noexcept { return lhs -= rhs; }
+            friend constexpr ModInt operator*(ModInt lhs, const ModInt& rhs) noexcept { return lhs *= rhs; }
+            friend constexpr ModInt operator/(ModInt lhs, const ModInt& rhs) noexcept { return lhs /= rhs; }
+            friend constexpr bool operator==(const ModInt& lhs, const ModInt& rhs) noexcept { return lhs.value_ == rhs.value_; }
+            friend std::ostream& operator<<(std::ostream& out, const ModInt& x) { return out << x.value(); }
+
+            // 遅延還元: 積を還元せずに返し (Modulus^2未満)、累積値をlazy_bound未満に保ちながら加算し、最後に1度だけ還元する
+            static constexpr Wide lazy_product(const ModInt& lhs, const ModInt& rhs) noexcept {
+                return std::uint64_t(lhs.value_) * rhs.value_;
+            }
+            static constexpr void lazy_add(Wide& accumulator, const Wide& product) noexcept {
+                accumulator += product;
+                accumulator -= accumulator >= lazy_bound ? lazy_bound : 0;
+            }
+            static constexpr ModInt lazy_reduce(const Wide& accumulator) noexcept {
+                return from_raw(reduce(accumulator));
+            }
+    };
+}
+#endif // staticmatrix_modint_hpp
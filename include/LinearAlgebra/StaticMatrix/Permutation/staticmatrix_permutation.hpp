@@ -0,0 +1,171 @@
+#ifndef staticmatrix_permutation_hpp
+#define staticmatrix_permutation_hpp
+#include "./../AliasAndConcepts/staticmatrix_alias_and_concepts.hpp"
+#include "./../Base/staticmatrix_base.hpp"
+#include <array>
+#include <cassert>
+#include <utility>
+#include <algorithm>
+namespace {
+    using namespace klibrary::linear_algebra::alias_and_concepts;
+}
+namespace klibrary::linear_algebra {
+    /*
+     * N次の置換行列
+     *
+     * 置換行列Pを(P x)_i = x_{P[i]}となる添え字の配列として保持する。すなわちP(i, P[i]) = 1である。
+     * 行の入れ替え(swap)は添え字の入れ替えのみで記録し、行列の要素は移動しない。記録した置換は
+     * 行列との積(P * A、A * P)やpermute_rows_in_placeにより1パスで適用する。積・逆置換はO(N)で求める。
+     */
+    template <SizeT N>
+    class StaticPermutation {
+        private:
+            Array<SizeT, N> map_;
+        public:
+            // 恒等置換
+            StaticPermutation() {
+                for(SizeT i = 0; i < N; ++i) {
+                    this->map_[i] = i;
+                }
+            }
+            // (P x)_i = x_{map[i]}となる置換 (mapは0, ..., N - 1の並べ替えでなければならない)
+            StaticPermutation(const Array<SizeT, N>& map) : map_(map) {}
+
+            SizeT operator[](const SizeT& i) const {
+                assert(i < N);
+                return this->map_[i];
+            }
+            const Array<SizeT, N>& map() const noexcept {
+                return this->map_;
+            }
+            bool operator==(const StaticPermutation&) const = default;
+
+            // P <- S_ij P (Pを適用した後にi行とj行を入れ替える)
+            auto& swap(const SizeT& i, const SizeT& j) {
+                assert(i < N && j < N);
+                std::swap(this->map_[i], this->map_[j]);
+                return (*this);
+            }
+            // 逆置換 (転置行列) P^-1 = P^T
+            StaticPermutation inverse() const {
+                StaticPermutation result;
+                for(SizeT i = 0; i < N; ++i) {
+                    result.map_[this->map_[i]] = i;
+                }
+                return result;
+            }
+            // 置換の符号 (行列式)。巡回置換の分解により求める
+            int sign() const {
+                Array<bool, N> visited{};
+                bool odd = false;
+                for(SizeT s = 0; s < N; ++s) {
+                    if(visited[s]) {
+                        continue;
+                    }
+                    for(SizeT i = s; !visited[i]; i = this->map_[i]) {
+                        visited[i] = true;
+                        odd = (i != s) ? !odd : odd;
+                    }
+                }
+                return odd ? -1 : 1;
+            }
+            bool is_identity() const {
+                for(SizeT i = 0; i < N; ++i) {
+                    if(this->map_[i] != i) {
+                        return false;
+                    }
+                }
+                return true;
+            }
+
+            // 合成 (P * Q) x = P (Q x)
+            StaticPermutation operator*(const StaticPermutation& rhs) const {
+                StaticPermutation result;
+                for(SizeT i = 0; i < N; ++i) {
+                    result.map_[i] = rhs.map_[this->map_[i]];
+                }
+                return result;
+            }
+            auto& operator*=(const StaticPermutation& rhs) {
+                (*this) = (*this) * rhs;
+                return (*this);
+            }
+
+            // result = P * matrix (resultのi行はmatrixのP[i]行)。resultはmatrixと別の行列でなければならない
+            template <class ElemT, SizeT Cols>
+            void permute_rows(const StaticMatrixBase<ElemT, N, Cols>& matrix, StaticMatrixBase<ElemT, N, Cols>& result) const {
+                assert(static_cast<const void*>(&matrix) != &result);
+                for(SizeT i = 0; i < N; ++i) {
+                    const ElemT* const source = &matrix(this->map_[i], 0);
+                    std::copy(source, source + Cols, &result(i, 0));
+                }
+            }
+            // result = matrix * P (matrixのk列はresultのP[k]列へ移る)。resultはmatrixと別の行列でなければならない
+            template <class ElemT, SizeT Rows>
+            void permute_cols(const StaticMatrixBase<ElemT, Rows, N>& matrix, StaticMatrixBase<ElemT, Rows, N>& result) const {
+                assert(static_cast<const void*>(&matrix) != &result);
+                for(SizeT r = 0; r < Rows; ++r) {
+                    for(SizeT k = 0; k < N; ++k) {
+                        result(r, this->map_[k]) = matrix(r, k);
+                    }
+                }
+            }
+            // matrix <- P * matrix (巡回置換ごとに各行を1度だけ移動する)
+            template <class ElemT, SizeT Cols>
+            void permute_rows_in_place(StaticMatrixBase<ElemT, N, Cols>& matrix) const {
+                Array<bool, N> visited{};
+                Array<ElemT, Cols> temp;
+                for(SizeT s = 0; s < N; ++s) {
+                    if(visited[s] || this->map_[s] == s) {
+                        continue;
+                    }
+                    std::copy(&matrix(s, 0), &matrix(s, 0) + Cols, temp.begin());
+                    SizeT i = s;
+                    while(true) {
+                        visited[i] = true;
+                        const SizeT j = this->map_[i];
+                        if(j == s) {
+                            std::copy(temp.begin(), temp.end(), &matrix(i, 0));
+                            break;
+                        }
+                        std::copy(&matrix(j, 0), &matrix(j, 0) + Cols, &matrix(i, 0));
+                        i = j;
+                    }
+                }
+            }
+            // y = P x (x, yは添え字演算子を持つ長さNの型)
+            template <class VectorIn, class VectorOut>
+            void apply(const VectorIn& x, VectorOut& y) const {
+                assert(static_cast<const void*>(&x) != &y);
+                for(SizeT i = 0; i < N; ++i) {
+                    y[i] = x[this->map_[i]];
+                }
+            }
+
+            // 置換行列を要素型ElemTの行列として返す
+            template <class ElemT>
+            StaticMatrixBase<ElemT, N, N> to_matrix() const {
+                StaticMatrixBase<ElemT, N, N> result;
+                for(SizeT i = 0; i < N; ++i) {
+                    result(i, this->map_[i]) = ElemT(1);
+                }
+                return result;
+            }
+    };
+
+    // P * matrix (行列を作らずに行を並べ替える)
+    template <SizeT N, class ElemT, SizeT Cols>
+    StaticMatrixBase<ElemT, N, Cols> operator*(const StaticPermutation<N>& permutation, const StaticMatrixBase<ElemT, N, Cols>& matrix) {
+        StaticMatrixBase<ElemT, N, Cols> result;
+        permutation.permute_rows(matrix, result);
+        return result;
+    }
+    // matrix * P (行列を作らずに列を並べ替える)
+    template <SizeT N, class ElemT, SizeT Rows>
+    StaticMatrixBase<ElemT, Rows, N> operator*(const StaticMatrixBase<ElemT, Rows, N>& matrix, const StaticPermutation<N>& permutation) {
+        StaticMatrixBase<ElemT, Rows, N> result;
+        permutation.permute_cols(matrix, result);
+        return result;
+    }
+}
+#endif // staticmatrix_permutation_hpp
@@ -0,0 +1,255 @@
+#ifndef staticmatrix_power_hpp
+#define staticmatrix_power_hpp
+#include "./../AliasAndConcepts/staticmatrix_alias_and_concepts.hpp"
+#include "./../Base/staticmatrix_base.hpp"
+#include "./../Decomposition/staticmatrix_lu.hpp"
+#include "./../Complex/staticmatrix_complex.hpp"
+#include "./../Dispatch/staticmatrix_dispatch.hpp"
+#include <array>
+#include <cmath>
+#include <cassert>
+#include <cstdint>
+#include <algorithm>
+namespace {
+    using namespace klibrary::linear_algebra::alias_and_concepts;
+}
+namespace klibrary::linear_algebra {
+    // 内積を還元せずに累積できる要素型 (ModInt等)
+    template <class ElemT>
+    concept LazyReducible = requires(const ElemT& a, typename ElemT::Wide& accumulator) {
+        { ElemT::lazy_product(a, a) } -> std::convertible_to<typename ElemT::Wide>;
+        ElemT::lazy_add(accumulator, ElemT::lazy_product(a, a));
+        { ElemT::lazy_reduce(accumulator) } -> std::convertible_to<ElemT>;
+    };
+
+    /*
+     * result = lhs * rhs
+     *
+     * 一時行列を作らずにresultへ直接書き込む。ループはr, m, cの順であり、最内ループでrhsとresultの行を連続にアクセスする。
+     * 要素型がLazyReducibleである場合は1行分の累積値を還元せずに保持し、最後に1度だけ還元する。
+     * 要素型がstd::complexである場合は実部・虚部を分割した形式の計算核(split_complex::multiply)を使用する。
+     * 要素型がfloat、doubleである場合は実行時に選択された計算核(dispatch::Kernels::gemm)を使用する。結果は選択された命令セットによらず一致する。
+     * resultはlhs、rhsと別の行列でなければならない。
+     */
+    template <class ElemT, SizeT Rows, SizeT Mids, SizeT Cols>
+    void multiply_into(
+        const StaticMatrixBase<ElemT, Rows, Mids>& lhs,
+        const StaticMatrixBase<ElemT, Mids, Cols>& rhs,
+        StaticMatrixBase<ElemT, Rows, Cols>& result
+    ) {
+        assert(static_cast<const void*>(&lhs) != &result && static_cast<const void*>(&rhs) != &result);
+        if constexpr(IsComplex<ElemT>) {
+            split_complex::multiply(lhs, rhs, result);
+            return;
+        }
+        if constexpr(dispatch::DispatchableElement<ElemT>) {
+            dispatch::kernels<ElemT>().gemm(&lhs[0], Mids, &rhs[0], Cols, &result[0], Cols, Rows, Mids, Cols);
+            return;
+        }
+        for(SizeT r = 0; r < Rows; ++r) {
+            if constexpr(LazyReducible<ElemT>) {
+                Array<typename ElemT::Wide, Cols> accumulator{};
+                for(SizeT m = 0; m < Mids; ++m) {
+                    const ElemT a = lhs(r, m);
+                    for(SizeT c = 0; c < Cols; ++c) {
+                        ElemT::lazy_add(accumulator[c], ElemT::lazy_product(a, rhs(m, c)));
+                    }
+                }
+                for(SizeT c = 0; c < Cols; ++c) {
+                    result(r, c) = ElemT::lazy_reduce(accumulator[c]);
+                }
+            } else {
+                for(SizeT c = 0; c < Cols; ++c) {
+                    result(r, c) = ElemT();
+                }
+                for(SizeT m = 0; m < Mids; ++m) {
+                    const ElemT a = lhs(r, m);
+                    for(SizeT c = 0; c < Cols; ++c) {
+                        result(r, c) += a * rhs(m, c);
+                    }
+                }
+            }
+        }
+    }
+
+    /*
+     * y = matrix * x
+     *
+     * x, yは添え字演算子を持つ長さCols, Rowsの型 (StaticColVector、std::array等) である。
+     * 要素型がstd::complexである場合はsplit_complex::multiply_vectorを使用する。
+     */
+    template <class ElemT, SizeT Rows, SizeT Cols, class VectorIn, class VectorOut>
+    void multiply_vector_into(const StaticMatrixBase<ElemT, Rows, Cols>& matrix, const VectorIn& x, VectorOut& y) {
+        assert(static_cast<const void*>(&x) != &y);
+        if constexpr(IsComplex<ElemT>) {
+            split_complex::multiply_vector(matrix, x, y);
+        } else {
+            for(SizeT r = 0; r < Rows; ++r) {
+                ElemT sum = ElemT();
+                for(SizeT c = 0; c < Cols; ++c) {
+                    sum += matrix(r, c) * x[c];
+                }
+                y[r] = sum;
+            }
+        }
+    }
+
+    /*
+     * matrix^k (二分累乗法)
+     *
+     * 3つの作業行列を指す添え字を入れ替えながらmultiply_intoで積を求めるため、乗算ごとの行列のコピーや初期化は行わない。
+     * 乗算の回数は floor(log2 k) + popcount(k) - 1 である。k = 0 の場合は単位行列を返す。
+     */
+    template <class ElemT, SizeT N>
+    StaticMatrixBase<ElemT, N, N> pow(const StaticMatrixBase<ElemT, N, N>& matrix, std::uint64_t k) {
+        Array<StaticMatrixBase<ElemT, N, N>, 3> buffers;
+        SizeT result = 0, base = 1, spare = 2;
+        bool first = true;
+        buffers[base] = matrix;
+        while(k > 0) {
+            if(k & 1) {
+                if(first) {
+                    buffers[result] = buffers[base];
+                    first = false;
+                } else {
+                    multiply_into(buffers[result], buffers[base], buffers[spare]);
+                    std::swap(result, spare);
+                }
+            }
+            k >>= 1;
+            if(k > 0) {
+                multiply_into(buffers[base], buffers[base], buffers[spare]);
+                std::swap(base, spare);
+            }
+        }
+        if(first) {
+            for(SizeT i = 0; i < N; ++i) {
+                buffers[result](i, i) = ElemT(1);
+            }
+        }
+        return buffers[result];
+    }
+
+    /*
+     * 行列指数関数 exp(matrix)
+     *
+     * Higham (2005) のスケーリングと2乗法による。1-ノルムに応じて次数3, 5, 7, 9, 13のPadé近似を選び、
+     * 13次でも誤差の上限を超える場合は matrix / 2^s に13次のPadé近似を適用してから s 回2乗する。
+     * Padé近似の分母の連立方程式はStaticMatrixLUで解く。ElemTは浮動小数点型である。
+     */
+    template <class ElemT, SizeT N>
+    StaticMatrixBase<ElemT, N, N> expm(const StaticMatrixBase<ElemT, N, N>& matrix) {
+        static_assert(FloatingPoint<ElemT>);
+        using Matrix = StaticMatrixBase<ElemT, N, N>;
+        constexpr Array<double, 14> b = {
+            64764752532480000.0, 32382376266240000.0, 7771770303897600.0, 1187353796428800.0,
+            129060195264000.0, 10559470521600.0, 670442572800.0, 33522128640.0,
+            1323241920.0, 40840800.0, 960960.0, 16380.0, 182.0, 1.0
+        };
+        // 各次数のPadé近似の係数 (Higham (2005) Table 10.2)
+        constexpr Array<Array<double, 10>, 4> low_order = {{
+            {120.0, 60.0, 12.0, 1.0},
+            {30240.0, 15120.0, 3360.0, 420.0, 30.0, 1.0},
+            {17297280.0, 8648640.0, 1995840.0, 277200.0, 25200.0, 1512.0, 56.0, 1.0},
+            {17643225600.0, 8821612800.0, 2075673600.0, 302702400.0, 30270240.0, 2162160.0, 110880.0, 3960.0, 90.0, 1.0}
+        }};
+        constexpr Array<double, 4> theta = {1.495585217958292e-2, 2.539398330063230e-1, 9.504178996162932e-1, 2.097847961257068e0};
+        constexpr double theta13 = 5.371920351148152e0;
+
+        ElemT norm = 0;
+        for(SizeT c = 0; c < N; ++c) {
+            ElemT sum = 0;
+            for(SizeT r = 0; r < N; ++r) {
+                sum += std::abs(matrix(r, c));
+            }
+            norm = std::max(norm, sum);
+        }
+
+        Matrix a = matrix;
+        int squarings = 0;
+        Matrix u, v, work;
+        Matrix a2;
+        multiply_into(a, a, a2);
+
+        SizeT order = 0;
+        while(order < theta.size() && !(norm <= theta[order])) {
+            ++order;
+        }
+        if(order < theta.size()) {
+            // 次数 m = 2 * order + 3: U = A Σ b_{2k+1} A^{2k}, V = Σ b_{2k} A^{2k}
+            const auto& coefficient = low_order[order];
+            const SizeT terms = order + 2;
+            Matrix power;
+            for(SizeT i = 0; i < N; ++i) {
+                power(i, i) = 1;
+            }
+            for(SizeT k = 0; k < terms; ++k) {
+                for(SizeT i = 0; i < N * N; ++i) {
+                    work[i] += static_cast<ElemT>(coefficient[2 * k + 1]) * power[i];
+                    v[i] += static_cast<ElemT>(coefficient[2 * k]) * power[i];
+                }
+                if(k + 1 < terms) {
+                    multiply_into(power, a2, u);
+                    power = u;
+                }
+            }
+            multiply_into(a, work, u);
+        } else {
+            if(norm > theta13) {
+                squarings = static_cast<int>(std::ceil(std::log2(norm / theta13)));
+                const ElemT scale = std::ldexp(ElemT(1), -squarings);
+                a *= scale;
+                a2 *= scale * scale;
+            }
+            Matrix a4, a6;
+            multiply_into(a2, a2, a4);
+            multiply_into(a4, a2, a6);
+            for(SizeT i = 0; i < N * N; ++i) {
+                work[i] = b[13] * a6[i] + b[11] * a4[i] + b[9] * a2[i];
+                v[i] = b[12] * a6[i] + b[10] * a4[i] + b[8] * a2[i];
+            }
+            multiply_into(a6, work, u);
+            for(SizeT i = 0; i < N * N; ++i) {
+                work[i] = u[i] + b[7] * a6[i] + b[5] * a4[i] + b[3] * a2[i];
+            }
+            for(SizeT i = 0; i < N; ++i) {
+                work(i, i) += b[1];
+            }
+            multiply_into(a6, v, u);
+            for(SizeT i = 0; i < N * N; ++i) {
+                v[i] = u[i] + b[6] * a6[i] + b[4] * a4[i] + b[2] * a2[i];
+            }
+            for(SizeT i = 0; i < N; ++i) {
+                v(i, i) += b[0];
+            }
+            multiply_into(a, work, u);
+        }
+
+        // (V - U) X = V + U
+        for(SizeT i = 0; i < N * N; ++i) {
+            const ElemT sum = v[i] + u[i];
+            work[i] = v[i] - u[i];
+            v[i] = sum;
+        }
+        const StaticMatrixLU<ElemT, N> lu(work);
+        Array<ElemT, N> column;
+        for(SizeT c = 0; c < N; ++c) {
+            for(SizeT r = 0; r < N; ++r) {
+                column[r] = v(r, c);
+            }
+            lu.solve_in_place(column);
+            for(SizeT r = 0; r < N; ++r) {
+                u(r, c) = column[r];
+            }
+        }
+
+        Matrix* result = &u;
+        Matrix* spare = &work;
+        for(int s = 0; s < squarings; ++s) {
+            multiply_into(*result, *result, *spare);
+            std::swap(result, spare);
+        }
+        return *result;
+    }
+}
+#endif // staticmatrix_power_hpp
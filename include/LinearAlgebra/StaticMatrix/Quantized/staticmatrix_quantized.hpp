@@ -0,0 +1,359 @@
+#ifndef staticmatrix_quantized_hpp
+#define staticmatrix_quantized_hpp
+#include "./../AliasAndConcepts/staticmatrix_alias_and_concepts.hpp"
+#include "./../Base/staticmatrix_base.hpp"
+#include <cmath>
+#include <limits>
+#include <cstdint>
+#include <cassert>
+#include <concepts>
+#include <algorithm>
+#include "./../Dispatch/staticmatrix_dispatch.hpp"
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define KLIBRARY_QUANTIZED_X86
+// AVX-VNNIのtarget属性と組み込み関数に対応するコンパイラ
+#if (defined(__clang__) && __clang_major__ >= 12) || (!defined(__clang__) && __GNUC__ >= 11)
+#define KLIBRARY_QUANTIZED_VNNI
+#endif
+#endif
+namespace {
+    using namespace klibrary::linear_algebra::alias_and_concepts;
+}
+namespace klibrary::linear_algebra {
+    // 量子化された要素型
+    template <class Q>
+    concept QuantizedElement = std::same_as<Q, std::int8_t> || std::same_as<Q, std::uint8_t> || std::same_as<Q, std::int16_t>;
+
+    /*
+     * アフィン量子化のパラメータ
+     *
+     * 量子化値qは実数値 scale * (q - zero_point) を表す。
+     */
+    struct Quantization {
+        float           scale       = 1;
+        std::int32_t    zero_point  = 0;
+    };
+
+    // [min, max]を量子化値の範囲全体に対応させるパラメータを返す (0は誤差なく表される)
+    template <QuantizedElement Q>
+    Quantization choose_quantization(float min, float max) {
+        constexpr float q_min = std::numeric_limits<Q>::min();
+        constexpr float q_max = std::numeric_limits<Q>::max();
+        min = std::min(min, 0.0f);
+        max = std::max(max, 0.0f);
+        if(min == max) {
+            return {1, 0};
+        }
+        const float scale = (max - min) / (q_max - q_min);
+        const auto zero_point = static_cast<std::int32_t>(std::clamp(std::nearbyint(q_min - min / scale), q_min, q_max));
+        return {scale, zero_point};
+    }
+
+    // xを量子化する (範囲外の値は飽和させる)
+    template <QuantizedElement Q>
+    Q quantize(const float& x, const Quantization& quantization) {
+        constexpr float q_min = std::numeric_limits<Q>::min();
+        constexpr float q_max = std::numeric_limits<Q>::max();
+        const float q = std::nearbyint(x / quantization.scale) + static_cast<float>(quantization.zero_point);
+        return static_cast<Q>(std::clamp(q, q_min, q_max));
+    }
+
+    /*
+     * matrixを行ごとに量子化してresultに書き込み、各行のパラメータを返す
+     * (quantize_colsは列ごと)。行列積の左オペランドは行ごと、右オペランドは列ごとに量子化する。
+     */
+    template <QuantizedElement Q, SizeT Rows, SizeT Cols>
+    Array<Quantization, Rows> quantize_rows(const StaticMatrixBase<float, Rows, Cols>& matrix, StaticMatrixBase<Q, Rows, Cols>& result) {
+        Array<Quantization, Rows> quantization;
+        for(SizeT r = 0; r < Rows; ++r) {
+            float min = 0, max = 0;
+            for(SizeT c = 0; c < Cols; ++c) {
+                min = std::min(min, matrix(r, c));
+                max = std::max(max, matrix(r, c));
+            }
+            quantization[r] = choose_quantization<Q>(min, max);
+            for(SizeT c = 0; c < Cols; ++c) {
+                result(r, c) = quantize<Q>(matrix(r, c), quantization[r]);
+            }
+        }
+        return quantization;
+    }
+    template <QuantizedElement Q, SizeT Rows, SizeT Cols>
+    Array<Quantization, Cols> quantize_cols(const StaticMatrixBase<float, Rows, Cols>& matrix, StaticMatrixBase<Q, Rows, Cols>& result) {
+        Array<Quantization, Cols> quantization;
+        for(SizeT c = 0; c < Cols; ++c) {
+            float min = 0, max = 0;
+            for(SizeT r = 0; r < Rows; ++r) {
+                min = std::min(min, matrix(r, c));
+                max = std::max(max, matrix(r, c));
+            }
+            quantization[c] = choose_quantization<Q>(min, max);
+        }
+        for(SizeT r = 0; r < Rows; ++r) {
+            for(SizeT c = 0; c < Cols; ++c) {
+                result(r, c) = quantize<Q>(matrix(r, c), quantization[c]);
+            }
+        }
+        return quantization;
+    }
+}
+// 量子化された行列積の計算核
+namespace klibrary::linear_algebra::quantized {
+    inline std::int32_t dot_scalar(const auto* a, const auto* b, const SizeT& n) {
+        std::int32_t sum = 0;
+        for(SizeT i = 0; i < n; ++i) {
+            sum += static_cast<std::int32_t>(a[i]) * static_cast<std::int32_t>(b[i]);
+        }
+        return sum;
+    }
+
+    template <QuantizedElement QA, QuantizedElement QB>
+    using DotKernel = std::int32_t (*)(const QA*, const QB*, const SizeT&);
+
+    /*
+     * 命令セットごとの内積の計算核 (GCC、Clangのtarget属性によりコンパイルする)
+     *
+     * - AVX-VNNI / AVX-512 VNNI : uint8 x int8 はvpdpbusdで32要素ずつ積和する
+     * - AVX2 (AVX-512)          : 16bitに拡張してvpmaddwdで16要素ずつ積和する (中間結果は飽和しない)
+     * - Scalar (SSE4.2)         : スカラー
+     *
+     * 整数演算であるため、結果は命令セットによらず一致する。
+     */
+    namespace target {
+        template <QuantizedElement QA, QuantizedElement QB>
+        std::int32_t scalar(const QA* a, const QB* b, const SizeT& n) {
+            return dot_scalar(a, b, n);
+        }
+#if defined(KLIBRARY_QUANTIZED_X86)
+        [[gnu::always_inline]] __attribute__((target("avx2"))) inline std::int32_t horizontal_sum(const __m256i& v) {
+            const __m128i half = _mm_add_epi32(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+            const __m128i quarter = _mm_add_epi32(half, _mm_shuffle_epi32(half, _MM_SHUFFLE(1, 0, 3, 2)));
+            return _mm_cvtsi128_si32(_mm_add_epi32(quarter, _mm_shuffle_epi32(quarter, _MM_SHUFFLE(2, 3, 0, 1))));
+        }
+        // 16要素を16bitに拡張して読み込む
+        template <class Q>
+        [[gnu::always_inline]] __attribute__((target("avx2"))) inline __m256i load_widened(const Q* p) {
+            if constexpr(std::same_as<Q, std::int16_t>) {
+                return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+            } else if constexpr(std::same_as<Q, std::uint8_t>) {
+                return _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)));
+            } else {
+                return _mm256_cvtepi8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)));
+            }
+        }
+        // i要素目から16要素ずつ積和し、残りをスカラーで加える
+        template <class QA, class QB>
+        [[gnu::always_inline]] __attribute__((target("avx2"))) inline std::int32_t madd_tail(const QA* a, const QB* b, SizeT i, const SizeT& n, __m256i accumulator) {
+            for(; i + 16 <= n; i += 16) {
+                accumulator = _mm256_add_epi32(accumulator, _mm256_madd_epi16(load_widened(a + i), load_widened(b + i)));
+            }
+            return horizontal_sum(accumulator) + dot_scalar(a + i, b + i, n - i);
+        }
+
+        template <QuantizedElement QA, QuantizedElement QB>
+        __attribute__((target("avx2"))) std::int32_t avx2(const QA* a, const QB* b, const SizeT& n) {
+            return madd_tail(a, b, 0, n, _mm256_setzero_si256());
+        }
+#if defined(KLIBRARY_QUANTIZED_VNNI)
+        __attribute__((target("avx2,avxvnni"))) inline std::int32_t avx_vnni(const std::uint8_t* a, const std::int8_t* b, const SizeT& n) {
+            SizeT i = 0;
+            __m256i accumulator = _mm256_setzero_si256();
+            for(; i + 32 <= n; i += 32) {
+                const __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+                const __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+                accumulator = _mm256_dpbusd_avx_epi32(accumulator, va, vb);
+            }
+            return madd_tail(a, b, i, n, accumulator);
+        }
+        __attribute__((target("avx512f,avx512vl,avx512bw,avx512dq,avx512vnni"))) inline std::int32_t avx512_vnni(const std::uint8_t* a, const std::int8_t* b, const SizeT& n) {
+            SizeT i = 0;
+            __m256i accumulator = _mm256_setzero_si256();
+            for(; i + 32 <= n; i += 32) {
+                const __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+                const __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+                accumulator = _mm256_dpbusd_epi32(accumulator, va, vb);
+            }
+            return madd_tail(a, b, i, n, accumulator);
+        }
+#endif
+#endif
+    }
+
+    // VNNI命令に対応しているか (AVX-VNNI、AVX-512 VNNIの順)
+    inline bool supports_avx_vnni() {
+#if defined(KLIBRARY_QUANTIZED_VNNI)
+        static const bool supported = (__builtin_cpu_init(), __builtin_cpu_supports("avxvnni") != 0);
+        return supported;
+#else
+        return false;
+#endif
+    }
+    inline bool supports_avx512_vnni() {
+#if defined(KLIBRARY_QUANTIZED_VNNI)
+        static const bool supported = (__builtin_cpu_init(), __builtin_cpu_supports("avx512vnni") != 0 && __builtin_cpu_supports("avx512vl") != 0);
+        return supported;
+#else
+        return false;
+#endif
+    }
+
+    // dispatch::active_instruction_set()で選択されている命令セットの内積の計算核
+    template <QuantizedElement QA, QuantizedElement QB>
+    DotKernel<QA, QB> dot_kernel() {
+#if defined(KLIBRARY_QUANTIZED_X86)
+        constexpr bool byte_product = std::same_as<QA, std::uint8_t> && std::same_as<QB, std::int8_t>;
+        switch(dispatch::active_instruction_set()) {
+        case dispatch::InstructionSet::AVX512:
+#if defined(KLIBRARY_QUANTIZED_VNNI)
+            if constexpr(byte_product) {
+                if(supports_avx512_vnni()) {
+                    return target::avx512_vnni;
+                }
+            }
+#endif
+            [[fallthrough]];
+        case dispatch::InstructionSet::AVX2:
+#if defined(KLIBRARY_QUANTIZED_VNNI)
+            if constexpr(byte_product) {
+                if(supports_avx_vnni()) {
+                    return target::avx_vnni;
+                }
+            }
+#endif
+            return target::avx2<QA, QB>;
+        default:
+            return target::scalar<QA, QB>;
+        }
+#else
+        return target::scalar<QA, QB>;
+#endif
+    }
+
+    /*
+     * Σ a_i b_i (32bit整数で累積する)
+     *
+     * 実行時に選択された命令セットの計算核を使用する。多数の内積を求める場合はdot_kernel()を1度だけ呼び出して使用する。
+     * int16 x int16 では -32768 * -32768 の組が2つ続く場合のみ32bitの中間結果が桁あふれする。
+     */
+    template <QuantizedElement QA, QuantizedElement QB>
+    std::int32_t dot(const QA* a, const QB* b, const SizeT& n) {
+        return dot_kernel<QA, QB>()(a, b, n);
+    }
+}
+#undef KLIBRARY_QUANTIZED_X86
+#undef KLIBRARY_QUANTIZED_VNNI
+namespace klibrary::linear_algebra {
+    /*
+     * result(r, c) = Σ_m (lhs(r, m) - z_r) (rhs(m, c) - z_c)
+     *
+     * z_rはlhs_quantization[r]、z_cはrhs_quantization[c]の零点である。積は32bit整数で累積し、
+     * 零点の寄与は Σ ab - z_c Σ a - z_r Σ b + M z_r z_c と展開して行和・列和から補正するため、
+     * 計算核は量子化値そのものの内積のみを計算する。rhsは転置してスレッドごとの作業領域に並べ替え、
+     * 各要素を連続した2つの配列の内積(quantized::dot_kernel)として求める。
+     * int8の場合、Mids < 2^17 であれば累積値は桁あふれしない。
+     */
+    template <QuantizedElement QA, QuantizedElement QB, SizeT Rows, SizeT Mids, SizeT Cols>
+    void quantized_multiply_into(
+        const StaticMatrixBase<QA, Rows, Mids>& lhs,
+        const Array<Quantization, Rows>& lhs_quantization,
+        const StaticMatrixBase<QB, Mids, Cols>& rhs,
+        const Array<Quantization, Cols>& rhs_quantization,
+        StaticMatrixBase<std::int32_t, Rows, Cols>& result
+    ) {
+        QB* const packed = workspace<QB>(Mids * Cols);
+        Array<std::int32_t, Cols> col_sums{};
+        for(SizeT m = 0; m < Mids; ++m) {
+            for(SizeT c = 0; c < Cols; ++c) {
+                packed[c * Mids + m] = rhs(m, c);
+                col_sums[c] += rhs(m, c);
+            }
+        }
+        const auto mids = static_cast<std::int32_t>(Mids);
+        const auto dot = quantized::dot_kernel<QA, QB>();
+        for(SizeT r = 0; r < Rows; ++r) {
+            const QA* const row = &lhs(r, 0);
+            std::int32_t row_sum = 0;
+            for(SizeT m = 0; m < Mids; ++m) {
+                row_sum += row[m];
+            }
+            const std::int32_t zr = lhs_quantization[r].zero_point;
+            for(SizeT c = 0; c < Cols; ++c) {
+                const std::int32_t zc = rhs_quantization[c].zero_point;
+                result(r, c) = dot(row, packed + c * Mids, Mids) - zc * row_sum - zr * col_sums[c] + mids * zr * zc;
+            }
+        }
+    }
+
+    /*
+     * y[r] = Σ_c (matrix(r, c) - z_r) (x[c] - z_x)
+     *
+     * xは長さColsの量子化値の配列、z_xはその零点である。
+     */
+    template <QuantizedElement QA, QuantizedElement QB, SizeT Rows, SizeT Cols>
+    void quantized_multiply_vector_into(
+        const StaticMatrixBase<QA, Rows, Cols>& matrix,
+        const Array<Quantization, Rows>& matrix_quantization,
+        const Array<QB, Cols>& x,
+        const Quantization& x_quantization,
+        Array<std::int32_t, Rows>& y
+    ) {
+        std::int32_t x_sum = 0;
+        for(SizeT c = 0; c < Cols; ++c) {
+            x_sum += x[c];
+        }
+        const auto cols = static_cast<std::int32_t>(Cols);
+        const std::int32_t zx = x_quantization.zero_point;
+        const auto dot = quantized::dot_kernel<QA, QB>();
+        for(SizeT r = 0; r < Rows; ++r) {
+            const QA* const row = &matrix(r, 0);
+            std::int32_t row_sum = 0;
+            for(SizeT c = 0; c < Cols; ++c) {
+                row_sum += row[c];
+            }
+            const std::int32_t zr = matrix_quantization[r].zero_point;
+            y[r] = dot(row, x.data(), Cols) - zx * row_sum - zr * x_sum + cols * zr * zx;
+        }
+    }
+
+    /*
+     * 32bit整数の累積値を出力のパラメータoutputで再量子化する
+     *
+     * result(r, c) = output.zero_point + round(accumulator(r, c) * s_r * s_c / output.scale) (飽和させる)
+     * 倍率 s_r * s_c / output.scale は要素ごとにdoubleで計算する。
+     */
+    template <QuantizedElement QOut, SizeT Rows, SizeT Cols>
+    void requantize_into(
+        const StaticMatrixBase<std::int32_t, Rows, Cols>& accumulator,
+        const Array<Quantization, Rows>& lhs_quantization,
+        const Array<Quantization, Cols>& rhs_quantization,
+        const Quantization& output,
+        StaticMatrixBase<QOut, Rows, Cols>& result
+    ) {
+        constexpr double q_min = std::numeric_limits<QOut>::min();
+        constexpr double q_max = std::numeric_limits<QOut>::max();
+        for(SizeT r = 0; r < Rows; ++r) {
+            const double row_scale = static_cast<double>(lhs_quantization[r].scale) / output.scale;
+            for(SizeT c = 0; c < Cols; ++c) {
+                const double q = std::nearbyint(accumulator(r, c) * row_scale * rhs_quantization[c].scale) + output.zero_point;
+                result(r, c) = static_cast<QOut>(std::clamp(q, q_min, q_max));
+            }
+        }
+    }
+
+    // 32bit整数の累積値を実数値 accumulator(r, c) * s_r * s_c に戻す
+    template <SizeT Rows, SizeT Cols>
+    void dequantize_into(
+        const StaticMatrixBase<std::int32_t, Rows, Cols>& accumulator,
+        const Array<Quantization, Rows>& lhs_quantization,
+        const Array<Quantization, Cols>& rhs_quantization,
+        StaticMatrixBase<float, Rows, Cols>& result
+    ) {
+        for(SizeT r = 0; r < Rows; ++r) {
+            for(SizeT c = 0; c < Cols; ++c) {
+                result(r, c) = static_cast<float>(accumulator(r, c)) * lhs_quantization[r].scale * rhs_quantization[c].scale;
+            }
+        }
+    }
+}
+#endif // staticmatrix_quantized_hpp
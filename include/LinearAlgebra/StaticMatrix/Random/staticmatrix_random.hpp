@@ -0,0 +1,305 @@
+#ifndef staticmatrix_random_hpp
+#define staticmatrix_random_hpp
+#include "./../AliasAndConcepts/staticmatrix_alias_and_concepts.hpp"
+#include "./../Base/staticmatrix_base.hpp"
+#include <cmath>
+#include <limits>
+#include <cstdint>
+#include <numbers>
+#include <algorithm>
+namespace {
+    using namespace klibrary::linear_algebra::alias_and_concepts;
+}
+namespace klibrary::linear_algebra {
+    /*
+     * カウンタベースの乱数生成器 Philox4x32-10 (Salmon et al., 2011)
+     *
+     * 128bitのカウンタ(ブロック番号64bit、ストリーム番号64bit)を64bitの鍵(シード)で10ラウンド暗号化し、1ブロックあたり32bitの乱数を4つ生成する。
+     * 状態はカウンタのみであるため、任意の位置へのスキップ(discard)が定数時間で行え、ストリーム番号の異なる生成器は互いに独立な系列を生成する。
+     * スレッドごとにストリーム番号を変えた生成器を使用すれば、スレッド数や実行順序に依らず同じ結果が得られる。
+     *
+     * 出力の系列はブロック0, 1, 2, ...の乱数を順に並べたものであり、operator()とgenerateはこの系列から同じ順に乱数を取り出す。
+     * generateは複数のブロックをまとめて計算し、ラウンドの計算はブロックについてSIMD化される。
+     * UniformRandomBitGeneratorの要件を満たすため、<random>の分布と組み合わせて使用することもできる。
+     */
+    class Philox4x32 {
+        public:
+            using result_type = std::uint32_t;
+            using Block = Array<std::uint32_t, 4>;
+            using Key = Array<std::uint32_t, 2>;
+
+            static constexpr std::uint64_t default_seed = 20111115;
+            // generateで同時に計算するブロック数
+            static constexpr SizeT lanes = 16;
+        private:
+            static constexpr std::uint32_t multiplier0 = 0xD2511F53;
+            static constexpr std::uint32_t multiplier1 = 0xCD9E8D57;
+            static constexpr std::uint32_t weyl0 = 0x9E3779B9;
+            static constexpr std::uint32_t weyl1 = 0xBB67AE85;
+
+            Key key_;
+            std::uint64_t stream_;
+            std::uint64_t counter_ = 0;     // 次に計算するブロック番号
+            Block buffer_ = {};
+            SizeT index_ = 4;               // buffer_の次に取り出す位置
+
+            // ブロック番号first, first + 1, ..., first + Count - 1の乱数をoutへ順に書き込む
+            template <SizeT Count>
+            void blocks(const std::uint64_t& first, std::uint32_t* out) const {
+                std::uint32_t c0[Count], c1[Count], c2[Count], c3[Count];
+                for(SizeT l = 0; l < Count; ++l) {
+                    const std::uint64_t counter = first + l;
+                    c0[l] = static_cast<std::uint32_t>(counter);
+                    c1[l] = static_cast<std::uint32_t>(counter >> 32);
+                    c2[l] = static_cast<std::uint32_t>(this->stream_);
+                    c3[l] = static_cast<std::uint32_t>(this->stream_ >> 32);
+                }
+                std::uint32_t k0 = this->key_[0], k1 = this->key_[1];
+                for(int round = 0; round < 10; ++round) {
+                    // GCCはこのループを先に完全展開するとSIMD化できないため、展開を抑止する
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC unroll 1
+#endif
+                    for(SizeT l = 0; l < Count; ++l) {
+                        const std::uint64_t p0 = std::uint64_t(multiplier0) * c0[l];
+                        const std::uint64_t p1 = std::uint64_t(multiplier1) * c2[l];
+                        const std::uint32_t next0 = static_cast<std::uint32_t>(p1 >> 32) ^ c1[l] ^ k0;
+                        const std::uint32_t next2 = static_cast<std::uint32_t>(p0 >> 32) ^ c3[l] ^ k1;
+                        c1[l] = static_cast<std::uint32_t>(p1);
+                        c3[l] = static_cast<std::uint32_t>(p0);
+                        c0[l] = next0;
+                        c2[l] = next2;
+                    }
+                    k0 += weyl0;
+                    k1 += weyl1;
+                }
+                for(SizeT l = 0; l < Count; ++l) {
+                    out[4 * l + 0] = c0[l];
+                    out[4 * l + 1] = c1[l];
+                    out[4 * l + 2] = c2[l];
+                    out[4 * l + 3] = c3[l];
+                }
+            }
+        public:
+            /*
+             * 引数
+             * - seed   : 鍵 (64bit)
+             * - stream : ストリーム番号。同じシードでストリーム番号の異なる生成器は独立な系列を生成する
+             */
+            explicit Philox4x32(const std::uint64_t& seed = default_seed, const std::uint64_t& stream = 0)
+                : key_{static_cast<std::uint32_t>(seed), static_cast<std::uint32_t>(seed >> 32)}, stream_(stream) {}
+
+            // 鍵keyでカウンタcounterを暗号化したブロック (Random123の参照実装と同じ値を返す)
+            static Block block(const Key& key, Block counter) {
+                std::uint32_t k0 = key[0], k1 = key[1];
+                for(int round = 0; round < 10; ++round) {
+                    const std::uint64_t p0 = std::uint64_t(multiplier0) * counter[0];
+                    const std::uint64_t p1 = std::uint64_t(multiplier1) * counter[2];
+                    counter = {
+                        static_cast<std::uint32_t>(p1 >> 32) ^ counter[1] ^ k0, static_cast<std::uint32_t>(p1),
+                        static_cast<std::uint32_t>(p0 >> 32) ^ counter[3] ^ k1, static_cast<std::uint32_t>(p0)
+                    };
+                    k0 += weyl0;
+                    k1 += weyl1;
+                }
+                return counter;
+            }
+
+            static constexpr result_type min() {
+                return std::numeric_limits<result_type>::min();
+            }
+            static constexpr result_type max() {
+                return std::numeric_limits<result_type>::max();
+            }
+            std::uint64_t stream() const noexcept {
+                return this->stream_;
+            }
+            // 同じシードでストリーム番号がstreamの生成器を返す (系列の先頭から生成する)
+            Philox4x32 split(const std::uint64_t& stream) const {
+                Philox4x32 engine(*this);
+                engine.stream_ = stream;
+                engine.counter_ = 0;
+                engine.index_ = 4;
+                return engine;
+            }
+
+            result_type operator()() {
+                if(this->index_ == 4) {
+                    this->blocks<1>(this->counter_++, this->buffer_.data());
+                    this->index_ = 0;
+                }
+                return this->buffer_[this->index_++];
+            }
+            // 乱数をn個読み飛ばす
+            void discard(std::uint64_t n) {
+                const std::uint64_t buffered = 4 - this->index_;
+                if(n <= buffered) {
+                    this->index_ += n;
+                    return;
+                }
+                n -= buffered;
+                this->counter_ += n / 4;
+                this->index_ = 4;
+                if(n % 4 != 0) {
+                    this->blocks<1>(this->counter_++, this->buffer_.data());
+                    this->index_ = n % 4;
+                }
+            }
+            // 続くn個の乱数をoutへ書き込む
+            void generate(std::uint32_t* out, SizeT n) {
+                while(n > 0 && this->index_ < 4) {
+                    *out++ = this->buffer_[this->index_++];
+                    --n;
+                }
+                for(; n >= 4 * lanes; n -= 4 * lanes, out += 4 * lanes) {
+                    this->blocks<lanes>(this->counter_, out);
+                    this->counter_ += lanes;
+                }
+                for(; n >= 4; n -= 4, out += 4) {
+                    this->blocks<1>(this->counter_++, out);
+                }
+                if(n > 0) {
+                    this->blocks<1>(this->counter_++, this->buffer_.data());
+                    std::copy(this->buffer_.begin(), this->buffer_.begin() + n, out);
+                    this->index_ = n;
+                }
+            }
+    };
+
+    namespace random_matrix {
+        // 一度に変換する乱数の個数
+        inline constexpr SizeT chunk = 256;
+
+        // [0, 1)の一様乱数 (floatは24bit、doubleは53bitの精度を持つ)。wordsは1要素あたりfloatでは1個、doubleでは2個
+        template <FloatingPoint T>
+        inline T unit(const std::uint32_t* words, const SizeT& i) {
+            if constexpr(sizeof(T) <= sizeof(std::uint32_t)) {
+                return static_cast<T>(words[i] >> 8) * static_cast<T>(0x1.0p-24);
+            } else {
+                const std::uint64_t bits = (std::uint64_t(words[2 * i]) << 32 | words[2 * i + 1]) >> 11;
+                return static_cast<T>(bits) * static_cast<T>(0x1.0p-53);
+            }
+        }
+        template <FloatingPoint T>
+        inline constexpr SizeT words_per_value = sizeof(T) <= sizeof(std::uint32_t) ? 1 : 2;
+
+        // outへ[low, high)の一様乱数をn個書き込む
+        template <FloatingPoint T>
+        void fill_uniform(Philox4x32& engine, T* out, SizeT n, const T& low, const T& high) {
+            std::uint32_t words[chunk];
+            constexpr SizeT per_chunk = chunk / words_per_value<T>;
+            const T width = high - low;
+            while(n > 0) {
+                const SizeT count = std::min(n, per_chunk);
+                engine.generate(words, count * words_per_value<T>);
+                for(SizeT i = 0; i < count; ++i) {
+                    out[i] = low + width * unit<T>(words, i);
+                }
+                out += count;
+                n -= count;
+            }
+        }
+        // outへ平均mean、標準偏差stddevの正規乱数をn個書き込む (Box-Muller法。乱数は2個ずつ生成し、nが奇数の場合は最後の1個を捨てる)
+        template <FloatingPoint T>
+        void fill_normal(Philox4x32& engine, T* out, SizeT n, const T& mean, const T& stddev) {
+            std::uint32_t words[chunk];
+            constexpr SizeT pairs_per_chunk = chunk / (2 * words_per_value<T>);
+            constexpr T two_pi = 2 * std::numbers::pi_v<T>;
+            while(n > 0) {
+                const SizeT pairs = std::min((n + 1) / 2, pairs_per_chunk);
+                engine.generate(words, 2 * pairs * words_per_value<T>);
+                for(SizeT i = 0; i < pairs; ++i) {
+                    // 1 - unitは(0, 1]に含まれるためlogは有限である
+                    const T radius = stddev * std::sqrt(-2 * std::log(T(1) - unit<T>(words, 2 * i)));
+                    const T angle = two_pi * unit<T>(words, 2 * i + 1);
+                    out[2 * i] = mean + radius * std::cos(angle);
+                    if(2 * i + 1 < n) {
+                        out[2 * i + 1] = mean + radius * std::sin(angle);
+                    }
+                }
+                const SizeT written = std::min(n, 2 * pairs);
+                out += written;
+                n -= written;
+            }
+        }
+
+        /*
+         * matrixを正規乱数の行列のQR分解の直交行列Qで置き換える
+         *
+         * Householder変換でQRを求め、Rの対角成分の符号をQの列に掛けることでQがHaar測度に従うようにする (Mezzadri, 2007)。
+         */
+        template <FloatingPoint ElemT, SizeT N>
+        void orthogonalize(StaticMatrixBase<ElemT, N, N>& matrix) {
+            // reflectors[k * N + i] (i >= k): k番目のHouseholderベクトル
+            ElemT* const reflectors = workspace<ElemT>(N * N + N);
+            ElemT* const signs = reflectors + N * N;
+            for(SizeT k = 0; k < N; ++k) {
+                ElemT* const v = reflectors + k * N;
+                ElemT norm = 0;
+                for(SizeT i = k; i < N; ++i) {
+                    v[i] = matrix(i, k);
+                    norm += v[i] * v[i];
+                }
+                norm = std::sqrt(norm);
+                // R(k, k) = -sign(x_0) ||x||
+                signs[k] = v[k] < 0 ? ElemT(1) : ElemT(-1);
+                v[k] -= signs[k] * norm;
+                ElemT v_norm = 0;
+                for(SizeT i = k; i < N; ++i) {
+                    v_norm += v[i] * v[i];
+                }
+                if(v_norm == 0) {
+                    continue;
+                }
+                v_norm = std::sqrt(v_norm);
+                for(SizeT i = k; i < N; ++i) {
+                    v[i] /= v_norm;
+                }
+                for(SizeT c = k; c < N; ++c) {
+                    ElemT projection = 0;
+                    for(SizeT i = k; i < N; ++i) {
+                        projection += v[i] * matrix(i, c);
+                    }
+                    for(SizeT i = k; i < N; ++i) {
+                        matrix(i, c) -= 2 * projection * v[i];
+                    }
+                }
+            }
+            // Q = H_0 H_1 ... H_{N-1} diag(signs)
+            for(SizeT i = 0; i < N * N; ++i) {
+                matrix[i] = ElemT();
+            }
+            for(SizeT i = 0; i < N; ++i) {
+                matrix(i, i) = signs[i];
+            }
+            for(SizeT k = N; k-- > 0;) {
+                const ElemT* const v = reflectors + k * N;
+                for(SizeT c = 0; c < N; ++c) {
+                    ElemT projection = 0;
+                    for(SizeT i = k; i < N; ++i) {
+                        projection += v[i] * matrix(i, c);
+                    }
+                    for(SizeT i = k; i < N; ++i) {
+                        matrix(i, c) -= 2 * projection * v[i];
+                    }
+                }
+            }
+        }
+
+        // matrix = Q diag(eigenvalues) Q^T (対称性を保つため上三角を計算して下三角へ写す)
+        template <FloatingPoint ElemT, SizeT N>
+        void congruence(StaticMatrixBase<ElemT, N, N>& matrix, const StaticMatrixBase<ElemT, N, N>& q, const ElemT* eigenvalues) {
+            for(SizeT r = 0; r < N; ++r) {
+                for(SizeT c = r; c < N; ++c) {
+                    ElemT sum = 0;
+                    for(SizeT k = 0; k < N; ++k) {
+                        sum += q(r, k) * eigenvalues[k] * q(c, k);
+                    }
+                    matrix(r, c) = sum;
+                    matrix(c, r) = sum;
+                }
+            }
+        }
+    }
+}
+#endif // staticmatrix_random_hpp
@@ -0,0 +1,159 @@
+#ifndef staticmatrix_reduction_hpp
+#define staticmatrix_reduction_hpp
+#include "./../AliasAndConcepts/staticmatrix_alias_and_concepts.hpp"
+#include <array>
+#include <cmath>
+namespace {
+    using namespace klibrary::linear_algebra::alias_and_concepts;
+}
+// 総和(リダクション)の計算方法を指定するポリシー
+namespace klibrary::linear_algebra::reduction {
+    /*
+     * 逐次加算
+     *
+     * 先頭から順に1つのアキュムレータへ加算する。従来の実装と同じ結果を返す。
+     */
+    struct Sequential {
+        template <class T, class Term>
+        static T sum(const SizeT& n, const Term& term) {
+            auto result = T();
+            for(SizeT i = 0; i < n; ++i) {
+                result += static_cast<T>(term(i));
+            }
+            return result;
+        }
+    };
+
+    /*
+     * 複数アキュムレータによる加算
+     *
+     * Lanes個の独立したアキュムレータに加算することで依存チェーンを分割し、
+     * 命令レベル並列性とコンパイラによるSIMD化を可能にする。
+     */
+    template <SizeT Lanes = 8>
+    struct MultiAccumulator {
+        static_assert(Lanes != 0 && (Lanes & (Lanes - 1)) == 0);
+
+        template <class T, class Term>
+        static T sum(const SizeT& n, const Term& term) {
+            Array<T, Lanes> accumulator;
+            accumulator.fill(T());
+
+            SizeT i = 0;
+            for(; i + Lanes <= n; i += Lanes) {
+                for(SizeT l = 0; l < Lanes; ++l) {
+                    accumulator[l] += static_cast<T>(term(i + l));
+                }
+            }
+            for(SizeT l = 0; l < n - i; ++l) {
+                accumulator[l] += static_cast<T>(term(i + l));
+            }
+            // アキュムレータ同士も木状に足し合わせる
+            for(SizeT width = Lanes / 2; width > 0; width /= 2) {
+                for(SizeT l = 0; l < width; ++l) {
+                    accumulator[l] += accumulator[l + width];
+                }
+            }
+            return accumulator[0];
+        }
+    };
+
+    /*
+     * 実行時に選択された計算核による加算
+     *
+     * 要素がfloat、doubleで連続に並ぶ内積・2-ノルムはdispatch::kernelsの計算核(SSE4.2、AVX2、AVX-512)で計算する。
+     * 加算の順序はMultiAccumulator<16>と同じであり、それ以外の場合はMultiAccumulator<16>として動作する。
+     */
+    struct Vectorized : MultiAccumulator<16> {};
+
+    /*
+     * 対ごと加算 (pairwise summation)
+     *
+     * 区間を再帰的に二等分して足し合わせる。丸め誤差の増加はO(log n)に抑えられる。
+     * BlockSize以下の区間はMultiAccumulatorで加算する。
+     */
+    template <SizeT BlockSize = 64>
+    struct Pairwise {
+        static_assert(BlockSize != 0);
+
+        template <class T, class Term>
+        static T sum(const SizeT& n, const Term& term) {
+            return sum_range<T>(0, n, term);
+        }
+        private:
+            template <class T, class Term>
+            static T sum_range(const SizeT& first, const SizeT& last, const Term& term) {
+                const SizeT n = last - first;
+                if(n <= BlockSize) {
+                    return MultiAccumulator<8>::template sum<T>(n, [&](const SizeT& i){ return term(first + i); });
+                }
+                const SizeT mid = first + n / 2;
+                return sum_range<T>(first, mid, term) + sum_range<T>(mid, last, term);
+            }
+    };
+
+    /*
+     * Neumaierの補償加算
+     *
+     * 加算で失われた下位ビットを補正項として保持し、作業精度に依らず誤差をほぼ1ulpに抑える。
+     * Lanes個の補償付きアキュムレータを用いて依存チェーンを分割する。
+     * 浮動小数点型以外ではMultiAccumulatorと同じ動作になる。
+     *
+     * -ffast-math等の結合則を仮定する最適化下では補正項が消去されるため使用しないこと。
+     */
+    template <SizeT Lanes = 4>
+    struct Compensated {
+        static_assert(Lanes != 0);
+
+        template <class T, class Term>
+        static T sum(const SizeT& n, const Term& term) {
+            if constexpr(!FloatingPoint<T>) {
+                return MultiAccumulator<8>::template sum<T>(n, term);
+            } else {
+                Array<T, Lanes> sum;
+                Array<T, Lanes> compensation;
+                sum.fill(T());
+                compensation.fill(T());
+
+                SizeT i = 0;
+                for(; i + Lanes <= n; i += Lanes) {
+                    for(SizeT l = 0; l < Lanes; ++l) {
+                        add(sum[l], compensation[l], static_cast<T>(term(i + l)));
+                    }
+                }
+                for(SizeT l = 0; l < n - i; ++l) {
+                    add(sum[l], compensation[l], static_cast<T>(term(i + l)));
+                }
+
+                auto result = T();
+                auto result_compensation = T();
+                for(SizeT l = 0; l < Lanes; ++l) {
+                    add(result, result_compensation, sum[l]);
+                    add(result, result_compensation, compensation[l]);
+                }
+                return result + result_compensation;
+            }
+        }
+        private:
+            template <class T>
+            static void add(T& sum, T& compensation, const T& x) {
+                const T t = sum + x;
+                if(std::abs(sum) >= std::abs(x)) {
+                    compensation += (sum - t) + x;
+                } else {
+                    compensation += (x - t) + sum;
+                }
+                sum = t;
+            }
+    };
+
+    template <class Policy>
+    concept ReductionPolicy = requires(SizeT n) {
+        { Policy::template sum<DefaultFPType>(n, [](const SizeT&){ return DefaultFPType(); }) } -> std::convertible_to<DefaultFPType>;
+    };
+}
+namespace klibrary::linear_algebra {
+    // 総和ポリシーの既定値
+    using DefaultReduction = reduction::Sequential;
+}
+#endif // staticmatrix_reduction_hpp
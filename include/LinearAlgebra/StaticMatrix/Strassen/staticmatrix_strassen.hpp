@@ -0,0 +1,318 @@
+#ifndef staticmatrix_strassen_hpp
+#define staticmatrix_strassen_hpp
+#include "./../AliasAndConcepts/staticmatrix_alias_and_concepts.hpp"
+#include "./../Base/staticmatrix_base.hpp"
+#include "./../Dispatch/staticmatrix_dispatch.hpp"
+#include "./../../../Parallel/parallel_for.hpp"
+#include <vector>
+#include <cassert>
+#include <algorithm>
+namespace {
+    using namespace klibrary::linear_algebra::alias_and_concepts;
+}
+// Strassen-Winograd法の実装 (行列は先頭要素へのポインタと行の間隔で表す)
+namespace klibrary::linear_algebra::strassen {
+    template <class T>
+    struct View {
+        T* data;
+        SizeT stride;
+
+        T& operator()(const SizeT& r, const SizeT& c) const {
+            return this->data[r * this->stride + c];
+        }
+        View block(const SizeT& r, const SizeT& c) const {
+            return {this->data + r * this->stride + c, this->stride};
+        }
+        operator View<const T>() const {
+            return {this->data, this->stride};
+        }
+    };
+
+    // 古典的な乗算のブロックの大きさ
+    inline constexpr SizeT block_size = 64;
+
+    // c = a * b (a: m x k, b: k x n)。kとnについてブロック化し、最内ループでbとcの行を連続にアクセスする
+    // float、doubleでは同じ順序で計算する実行時に選択された計算核を使用する
+    template <class ElemT>
+    void multiply_blocked(View<const ElemT> a, View<const ElemT> b, View<ElemT> c, const SizeT& m, const SizeT& k, const SizeT& n) {
+        if constexpr(dispatch::DispatchableElement<ElemT>) {
+            dispatch::kernels<ElemT>().gemm(a.data, a.stride, b.data, b.stride, c.data, c.stride, m, k, n);
+            return;
+        }
+        for(SizeT r = 0; r < m; ++r) {
+            for(SizeT j = 0; j < n; ++j) {
+                c(r, j) = ElemT();
+            }
+        }
+        for(SizeT kk = 0; kk < k; kk += block_size) {
+            const SizeT k_end = std::min(k, kk + block_size);
+            for(SizeT jj = 0; jj < n; jj += block_size) {
+                const SizeT j_end = std::min(n, jj + block_size);
+                for(SizeT r = 0; r < m; ++r) {
+                    for(SizeT p = kk; p < k_end; ++p) {
+                        const ElemT x = a(r, p);
+                        for(SizeT j = jj; j < j_end; ++j) {
+                            c(r, j) += x * b(p, j);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    // out = x + y, out = x - y (h x h)
+    template <class ElemT>
+    void add(View<const ElemT> x, View<const ElemT> y, View<ElemT> out, const SizeT& h) {
+        for(SizeT r = 0; r < h; ++r) {
+            for(SizeT c = 0; c < h; ++c) {
+                out(r, c) = x(r, c) + y(r, c);
+            }
+        }
+    }
+    template <class ElemT>
+    void subtract(View<const ElemT> x, View<const ElemT> y, View<ElemT> out, const SizeT& h) {
+        for(SizeT r = 0; r < h; ++r) {
+            for(SizeT c = 0; c < h; ++c) {
+                out(r, c) = x(r, c) - y(r, c);
+            }
+        }
+    }
+
+    // n x n の積を逐次に計算する場合に必要な作業領域の要素数
+    inline SizeT workspace_size(const SizeT& n, const SizeT& crossover) {
+        if(n <= crossover) {
+            return 0;
+        }
+        if(n % 2 == 1) {
+            return workspace_size(n - 1, crossover);
+        }
+        const SizeT h = n / 2;
+        return 2 * h * h + workspace_size(h, crossover);
+    }
+    // 最上位の7つの積を並列に計算する場合に必要な作業領域の要素数
+    inline SizeT parallel_workspace_size(const SizeT& n, const SizeT& crossover) {
+        if(n <= crossover) {
+            return 0;
+        }
+        if(n % 2 == 1) {
+            return parallel_workspace_size(n - 1, crossover);
+        }
+        const SizeT h = n / 2;
+        return 11 * h * h + 7 * workspace_size(h, crossover);
+    }
+
+    // nが奇数の場合: 左上の(n - 1) x (n - 1)の積を求めた後、最終行・最終列の寄与を古典的に加える
+    template <class ElemT>
+    void peel(View<const ElemT> a, View<const ElemT> b, View<ElemT> c, const SizeT& n) {
+        const SizeT m = n - 1;
+        for(SizeT r = 0; r < m; ++r) {
+            const ElemT x = a(r, m);
+            for(SizeT j = 0; j < m; ++j) {
+                c(r, j) += x * b(m, j);
+            }
+        }
+        for(SizeT r = 0; r < m; ++r) {
+            ElemT sum = ElemT();
+            for(SizeT p = 0; p < n; ++p) {
+                sum += a(r, p) * b(p, m);
+            }
+            c(r, m) = sum;
+        }
+        for(SizeT j = 0; j < n; ++j) {
+            c(m, j) = ElemT();
+        }
+        for(SizeT p = 0; p < n; ++p) {
+            const ElemT x = a(m, p);
+            for(SizeT j = 0; j < n; ++j) {
+                c(m, j) += x * b(p, j);
+            }
+        }
+    }
+
+    /*
+     * c = a * b (n x n) を逐次に計算する
+     *
+     * 1段あたりh x hの作業行列X, Yの2つのみを用いるBoyer-Dumas-Pernet-Zhou (2009)の順序で
+     * Winograd型の7つの積と15回の加減算を行う。workspaceはworkspace_size(n, crossover)個の要素を持つ。
+     */
+    template <class ElemT>
+    void multiply(View<const ElemT> a, View<const ElemT> b, View<ElemT> c, const SizeT& n, ElemT* workspace, const SizeT& crossover) {
+        if(n <= crossover) {
+            multiply_blocked(a, b, c, n, n, n);
+            return;
+        }
+        if(n % 2 == 1) {
+            multiply(a, b, c, n - 1, workspace, crossover);
+            peel(a, b, c, n);
+            return;
+        }
+        const SizeT h = n / 2;
+        const auto a11 = a.block(0, 0), a12 = a.block(0, h), a21 = a.block(h, 0), a22 = a.block(h, h);
+        const auto b11 = b.block(0, 0), b12 = b.block(0, h), b21 = b.block(h, 0), b22 = b.block(h, h);
+        const auto c11 = c.block(0, 0), c12 = c.block(0, h), c21 = c.block(h, 0), c22 = c.block(h, h);
+        const View<ElemT> x = {workspace, h};
+        const View<ElemT> y = {workspace + h * h, h};
+        ElemT* next = workspace + 2 * h * h;
+
+        subtract<ElemT>(a11, a21, x, h);                // S3
+        subtract<ElemT>(b22, b12, y, h);                // T3
+        multiply<ElemT>(x, y, c21, h, next, crossover); // P7
+        add<ElemT>(a21, a22, x, h);                     // S1
+        subtract<ElemT>(b12, b11, y, h);                // T1
+        multiply<ElemT>(x, y, c22, h, next, crossover); // P5
+        subtract<ElemT>(x, a11, x, h);                  // S2
+        subtract<ElemT>(b22, y, y, h);                  // T2
+        multiply<ElemT>(x, y, c12, h, next, crossover); // P6
+        subtract<ElemT>(a12, x, x, h);                  // S4
+        multiply<ElemT>(x, b22, c11, h, next, crossover); // P3
+        multiply<ElemT>(a11, b11, x, h, next, crossover); // P1
+        add<ElemT>(x, c12, c12, h);                     // U2 = P1 + P6
+        add<ElemT>(c12, c21, c21, h);                   // U3 = U2 + P7
+        add<ElemT>(c12, c22, c12, h);                   // U4 = U2 + P5
+        add<ElemT>(c21, c22, c22, h);                   // U7 = U3 + P5 (C22)
+        add<ElemT>(c12, c11, c12, h);                   // U5 = U4 + P3 (C12)
+        subtract<ElemT>(y, b21, y, h);                  // T4
+        multiply<ElemT>(a22, y, c11, h, next, crossover); // P4
+        subtract<ElemT>(c21, c11, c21, h);              // U6 = U3 - P4 (C21)
+        multiply<ElemT>(a12, b21, c11, h, next, crossover); // P2
+        add<ElemT>(x, c11, c11, h);                     // U1 = P1 + P2 (C11)
+    }
+
+    /*
+     * c = a * b (n x n) を最上位の7つの積を並列に計算して求める
+     *
+     * 7つの積の被演算子S1-S4, T1-T4と、Cの部分行列に置けない積P1, P2, P4を別の作業行列に保持する。
+     * 各積はworkspace_size(h, crossover)個の専用の作業領域を用いて逐次に計算する。
+     * workspaceはparallel_workspace_size(n, crossover)個の要素を持つ。
+     */
+    template <class ElemT>
+    void parallel_multiply(View<const ElemT> a, View<const ElemT> b, View<ElemT> c, const SizeT& n, ElemT* workspace, const SizeT& crossover, const SizeT& threads) {
+        if(n <= crossover) {
+            multiply_blocked(a, b, c, n, n, n);
+            return;
+        }
+        if(n % 2 == 1) {
+            parallel_multiply(a, b, c, n - 1, workspace, crossover, threads);
+            peel(a, b, c, n);
+            return;
+        }
+        const SizeT h = n / 2;
+        const auto a11 = a.block(0, 0), a12 = a.block(0, h), a21 = a.block(h, 0), a22 = a.block(h, h);
+        const auto b11 = b.block(0, 0), b12 = b.block(0, h), b21 = b.block(h, 0), b22 = b.block(h, h);
+        const auto c11 = c.block(0, 0), c12 = c.block(0, h), c21 = c.block(h, 0), c22 = c.block(h, h);
+        Array<View<ElemT>, 11> buffers;
+        for(SizeT i = 0; i < buffers.size(); ++i) {
+            buffers[i] = {workspace + i * h * h, h};
+        }
+        const auto [s1, s2, s3, s4, t1, t2, t3, t4, p1, p2, p4] = buffers;
+        ElemT* next = workspace + 11 * h * h;
+        const SizeT next_size = workspace_size(h, crossover);
+
+        add<ElemT>(a21, a22, s1, h);
+        subtract<ElemT>(s1, a11, s2, h);
+        subtract<ElemT>(a11, a21, s3, h);
+        subtract<ElemT>(a12, s2, s4, h);
+        subtract<ElemT>(b12, b11, t1, h);
+        subtract<ElemT>(b22, t1, t2, h);
+        subtract<ElemT>(b22, b12, t3, h);
+        subtract<ElemT>(t2, b21, t4, h);
+
+        const Array<View<const ElemT>, 7> lhs = {a11, a12, s4, a22, s1, s2, s3};
+        const Array<View<const ElemT>, 7> rhs = {b11, b21, b22, t4, t1, t2, t3};
+        const Array<View<ElemT>, 7> products = {p1, p2, c11, p4, c22, c12, c21};
+        klibrary::parallel::parallel_for(0, 7, threads, [&](const SizeT& begin, const SizeT& end) {
+            for(SizeT i = begin; i < end; ++i) {
+                multiply<ElemT>(lhs[i], rhs[i], products[i], h, next + i * next_size, crossover);
+            }
+        });
+
+        add<ElemT>(p1, c12, c12, h);                    // U2 = P1 + P6
+        add<ElemT>(c12, c21, c21, h);                   // U3 = U2 + P7
+        add<ElemT>(c12, c22, c12, h);                   // U4 = U2 + P5
+        add<ElemT>(c21, c22, c22, h);                   // U7 = U3 + P5 (C22)
+        add<ElemT>(c12, c11, c12, h);                   // U5 = U4 + P3 (C12)
+        subtract<ElemT>(c21, p4, c21, h);               // U6 = U3 - P4 (C21)
+        add<ElemT>(p1, p2, c11, h);                     // U1 = P1 + P2 (C11)
+    }
+}
+namespace klibrary::linear_algebra {
+    /*
+     * Strassen-Winograd法の設定
+     *
+     * - crossover  : 部分行列の大きさがこれ以下になった場合に古典的なブロック化乗算に切り替える
+     * - threads    : 最上位の7つの積を計算するスレッド数 (0の場合はハードウェアの並列数、高々7)
+     */
+    struct StrassenOptions {
+        SizeT crossover = 128;
+        SizeT threads   = 1;
+    };
+
+    /*
+     * Strassen-Winograd法の作業領域
+     *
+     * reserveで必要な大きさを確保しておけば、同じ大きさ以下の行列の乗算では再確保を行わない。
+     */
+    template <class ElemT>
+    class StrassenWorkspace {
+        private:
+            std::vector<ElemT> buffer_;
+        public:
+            StrassenWorkspace() = default;
+            StrassenWorkspace(const SizeT& n, const StrassenOptions& options = {}) {
+                this->reserve(n, options);
+            }
+
+            // n x n の乗算に必要な要素数を返す
+            static SizeT required_size(const SizeT& n, const StrassenOptions& options = {}) {
+                return klibrary::parallel::thread_count(options.threads) > 1
+                    ? strassen::parallel_workspace_size(n, options.crossover)
+                    : strassen::workspace_size(n, options.crossover);
+            }
+            void reserve(const SizeT& n, const StrassenOptions& options = {}) {
+                const SizeT size = required_size(n, options);
+                if(this->buffer_.size() < size) {
+                    this->buffer_.resize(size);
+                }
+            }
+            ElemT* data() noexcept { return this->buffer_.data(); }
+            SizeT size() const noexcept { return this->buffer_.size(); }
+    };
+
+    /*
+     * result = lhs * rhs をStrassen-Winograd法で計算する
+     *
+     * 計算量は O(n^log2(7)) であるが、丸め誤差の上限は古典的な乗算より大きい (staticmatrix.mdを参照)。
+     * resultはlhs、rhsと別の行列でなければならない。workspaceは必要に応じて拡張される。
+     */
+    template <class ElemT, SizeT N>
+    void strassen_multiply_into(
+        const StaticMatrixBase<ElemT, N, N>& lhs,
+        const StaticMatrixBase<ElemT, N, N>& rhs,
+        StaticMatrixBase<ElemT, N, N>& result,
+        StrassenWorkspace<ElemT>& workspace,
+        const StrassenOptions& options = {}
+    ) {
+        assert(&lhs != &result && &rhs != &result);
+        assert(options.crossover > 0);
+        workspace.reserve(N, options);
+        const strassen::View<const ElemT> a = {&lhs[0], N};
+        const strassen::View<const ElemT> b = {&rhs[0], N};
+        const strassen::View<ElemT> c = {&result[0], N};
+        if(klibrary::parallel::thread_count(options.threads) > 1) {
+            strassen::parallel_multiply(a, b, c, N, workspace.data(), options.crossover, options.threads);
+        } else {
+            strassen::multiply(a, b, c, N, workspace.data(), options.crossover);
+        }
+    }
+    template <class ElemT, SizeT N>
+    void strassen_multiply_into(
+        const StaticMatrixBase<ElemT, N, N>& lhs,
+        const StaticMatrixBase<ElemT, N, N>& rhs,
+        StaticMatrixBase<ElemT, N, N>& result,
+        const StrassenOptions& options = {}
+    ) {
+        StrassenWorkspace<ElemT> workspace(N, options);
+        strassen_multiply_into(lhs, rhs, result, workspace, options);
+    }
+}
+#endif // staticmatrix_strassen_hpp
@@ -2,6 +2,7 @@
 #define staticvector_basic_vectors_hpp
 #include "./../../AliasAndConcepts/staticmatrix_alias_and_concepts.hpp"
 #include "./../Base/staticvector_base.hpp"
+#include "./../../Random/staticmatrix_random.hpp"
 namespace {
     using namespace klibrary::linear_algebra::alias_and_concepts;
 }
@@ -10,6 +11,7 @@ namespace klibrary::linear_algebra {
     class StaticVectorBasicVectors : public StaticVectorBase<ElemT, Rows, Cols> {
         public:
             using StaticVectorBase<ElemT, Rows, Cols>::StaticVectorBase;
+            StaticVectorBasicVectors(const StaticVectorBase<ElemT, Rows, Cols>& vector) : StaticVectorBase<ElemT, Rows, Cols>(vector){}
 
             static auto Zero() {
                 return StaticVectorBasicVectors<ElemT, Rows, Cols>();
@@ -17,6 +19,20 @@ namespace klibrary::linear_algebra {
             static auto One() {
                 return StaticVectorBasicVectors<ElemT, Rows, Cols>(ElemT(1));
             }
+            // 各成分が[low, high)の一様乱数であるベクトル
+            static auto Random(Philox4x32& engine, const ElemT& low = ElemT(0), const ElemT& high = ElemT(1)) {
+                static_assert(FloatingPoint<ElemT>);
+                StaticVectorBasicVectors<ElemT, Rows, Cols> uniform_vector;
+                random_matrix::fill_uniform(engine, &uniform_vector[0], Rows * Cols, low, high);
+                return uniform_vector;
+            }
+            // 各成分が平均mean、標準偏差stddevの正規乱数であるベクトル
+            static auto RandomNormal(Philox4x32& engine, const ElemT& mean = ElemT(0), const ElemT& stddev = ElemT(1)) {
+                static_assert(FloatingPoint<ElemT>);
+                StaticVectorBasicVectors<ElemT, Rows, Cols> normal_vector;
+                random_matrix::fill_normal(engine, &normal_vector[0], Rows * Cols, mean, stddev);
+                return normal_vector;
+            }
     };
 }
 #endif // staticvector_basic_vectors_hpp
\ No newline at end of file
@@ -1,50 +1,73 @@
 #ifndef staticvector_geometory_hpp
 #define staticvector_geometory_hpp
 #include "./../../AliasAndConcepts/staticmatrix_alias_and_concepts.hpp"
+#include "./../../Reduction/staticmatrix_reduction.hpp"
+#include "./../../Dispatch/staticmatrix_dispatch.hpp"
 #include "./../Base/staticvector_base.hpp"
+#include "./../BasicVectors/staticvector_basic_vectors.hpp"
 #include <optional>
-#include <functional>
 #include <limits>
+#include <complex>
 namespace {
     using namespace klibrary::linear_algebra::alias_and_concepts;
 }
 namespace klibrary::linear_algebra {
     template <class ElemT, SizeT Rows, SizeT Cols>
-    class StaticVectorGeometory : public StaticVectorBase<ElemT, Rows, Cols> {
+    class StaticVectorGeometory : public StaticVectorBasicVectors<ElemT, Rows, Cols> {
         public:
-            using StaticVectorBase<ElemT, Rows, Cols>::StaticVectorBase;
+            using StaticVectorBasicVectors<ElemT, Rows, Cols>::StaticVectorBasicVectors;
+            StaticVectorGeometory(const StaticVectorBase<ElemT, Rows, Cols>& vector) : StaticVectorBasicVectors<ElemT, Rows, Cols>(vector){}
 
-            template <FloatingPoint FPType = DefaultFPType>
+            template <FloatingPoint FPType = DefaultFPType, class Policy = DefaultReduction>
             FPType norm(const std::optional<SizeT>& p = 2) const {
+                static_assert(HasGlobalAbs<ElemT> || HasMemberAbs<ElemT>);
+                static_assert(HasGlobalPow<FPType> || HasMemberPow<FPType>);
+                static_assert(IsConvertibleTo<SizeT, FPType>);
+                static_assert(reduction::ReductionPolicy<Policy>);
+
+                const auto abs_of = [&](const SizeT& i) -> FPType {
+                    if constexpr(HasGlobalAbs<ElemT>) {
+                        return abs((*this)[i]);
+                    } else {
+                        return ((*this)[i]).abs();
+                    }
+                };
                 if(p == Infinity || p.value() == 0) {
-                    FPType max = std::numeric_limits<FPType>::min();
+                    FPType max = FPType();
                     for(SizeT i = 0; i < Rows * Cols; ++i) {
-                        max = (max < (*this)[i]) ? (*this)[i] : max;
+                        const FPType a = abs_of(i);
+                        max = (max < a) ? a : max;
                     }
                     return max;
                 }
 
-                static_assert(HasGlobalAbs<ElemT> || HasMemberAbs<ElemT>);
-                static_assert(HasGlobalPow<FPType> || HasMemberPow<FPType>);
-                static_assert(IsConvertibleTo<SizeT, FPType>);
-
-                auto result = FPType();
-                std::function<FPType(SizeT)> f;
-                if constexpr(HasGlobalAbs<ElemT>) {
+                const auto exponent = static_cast<FPType>(p.value());
+                const auto pow_of = [&](const FPType& x) -> FPType {
                     if constexpr(HasGlobalPow<FPType>) {
-                        f = [&](const SizeT& i){ return pow(abs((*this)[i]), static_cast<FPType>(p.value())); };
+                        return pow(x, exponent);
                     } else {
-                        f = [&](const SizeT& i){ return abs((*this)[i]).pow(static_cast<FPType>(p.value())); };
+                        return x.pow(exponent);
                     }
-                } else {
-                    if constexpr(HasGlobalPow<FPType>) {
-                        f = [&](const SizeT& i){ return pow(((*this)[i]).abs(), static_cast<FPType>(p.value())); };
+                };
+                // p = 1, 2は冪乗を使わずに計算する
+                FPType result;
+                switch(p.value()) {
+                case 1:
+                    result = Policy::template sum<FPType>(Rows * Cols, [&](const SizeT& i){ return abs_of(i); });
+                    break;
+                case 2:
+                    if constexpr(std::same_as<Policy, reduction::Vectorized> && std::same_as<ElemT, FPType> && dispatch::DispatchableElement<ElemT>) {
+                        result = dispatch::kernels<ElemT>().sum_of_squares(&(*this)[0], Rows * Cols);
+                    } else if constexpr(IsComplex<ElemT>) {
+                        // |z|^2は平方根を取らずに求める
+                        result = Policy::template sum<FPType>(Rows * Cols, [&](const SizeT& i){ return static_cast<FPType>(std::norm((*this)[i])); });
                     } else {
-                        f = [&](const SizeT& i){ return (((*this)[i]).abs()).pow(static_cast<FPType>(p.value())); };
+                        result = Policy::template sum<FPType>(Rows * Cols, [&](const SizeT& i){ const FPType a = abs_of(i); return a * a; });
                     }
-                }
-                for(SizeT i = 0; i < Rows * Cols; ++i) {
-                    result += f(i);
+                    break;
+                default:
+                    result = Policy::template sum<FPType>(Rows * Cols, [&](const SizeT& i){ return pow_of(abs_of(i)); });
+                    break;
                 }
                 switch(p.value()) {
                 case 1:
@@ -61,23 +84,39 @@ namespace klibrary::linear_algebra {
                 }
             }
 
-            template <class ElemT_R, SizeT Rows_R, SizeT Cols_R>
+            template <class Policy = DefaultReduction, class ElemT_R, SizeT Rows_R, SizeT Cols_R>
             auto dot(const StaticVectorGeometory<ElemT_R, Rows_R, Cols_R>& rhs) {
                 static_assert(Rows == Rows_R && Cols == Cols_R);
                 static_assert(HasCommonTypeWith<ElemT, ElemT_R>);
+                static_assert(reduction::ReductionPolicy<Policy>);
 
                 using CommonType = CommonTypeOf<ElemT, ElemT_R>;
-                
-                auto result = CommonType();
-                for(SizeT i = 0; i < Rows * Cols; ++i) {
+
+                if constexpr(std::same_as<Policy, reduction::Vectorized> && std::same_as<ElemT, ElemT_R> && dispatch::DispatchableElement<ElemT>) {
+                    return dispatch::kernels<ElemT>().dot(&(*this)[0], &rhs[0], Rows * Cols);
+                }
+                return Policy::template sum<CommonType>(Rows * Cols, [&](const SizeT& i) {
                     if constexpr(IsMultiplicationDefined<ElemT, ElemT_R>) {
-                        result += static_cast<CommonType>((*this)[i] * rhs[i]);
+                        return static_cast<CommonType>((*this)[i] * rhs[i]);
                     } else {
                         static_assert(IsMultiplicationDefined<CommonType, CommonType>);
-                        result += static_cast<CommonType>((*this)[i]) * static_cast<CommonType>(rhs[i]);
+                        return static_cast<CommonType>(static_cast<CommonType>((*this)[i]) * static_cast<CommonType>(rhs[i]));
                     }
-                }
-                return result;
+                });
+            }
+
+            // 複素共役を取った内積 Σ conj(this_i) * rhs_i (実数型ではdotと同じ)
+            template <class Policy = DefaultReduction, class ElemT_R, SizeT Rows_R, SizeT Cols_R>
+            auto conjugate_dot(const StaticVectorGeometory<ElemT_R, Rows_R, Cols_R>& rhs) const {
+                static_assert(Rows == Rows_R && Cols == Cols_R);
+                static_assert(HasCommonTypeWith<ElemT, ElemT_R>);
+                static_assert(reduction::ReductionPolicy<Policy>);
+
+                using CommonType = CommonTypeOf<ElemT, ElemT_R>;
+
+                return Policy::template sum<CommonType>(Rows * Cols, [&](const SizeT& i) {
+                    return static_cast<CommonType>(conjugate_of(static_cast<CommonType>((*this)[i])) * static_cast<CommonType>(rhs[i]));
+                });
             }
 
             template <class ElemT_R, SizeT Rows_R, SizeT Cols_R>
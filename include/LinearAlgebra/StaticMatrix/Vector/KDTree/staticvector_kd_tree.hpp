@@ -0,0 +1,295 @@
+#ifndef staticvector_kd_tree_hpp
+#define staticvector_kd_tree_hpp
+#include "./../../AliasAndConcepts/staticmatrix_alias_and_concepts.hpp"
+#include "./../staticvector.hpp"
+#include "./../../../../Parallel/parallel_for.hpp"
+#include <span>
+#include <limits>
+#include <vector>
+#include <cassert>
+#include <cstdint>
+#include <utility>
+#include <numeric>
+#include <algorithm>
+namespace {
+    using namespace klibrary::linear_algebra::alias_and_concepts;
+}
+namespace klibrary::linear_algebra {
+    struct KDTreeOptions {
+        SizeT leaf_size = 16;   // 葉が保持する点の最大数
+        SizeT threads   = 1;    // 構築に使用するスレッド数 (0の場合はハードウェアの並列数)
+    };
+
+    /*
+     * 点群StaticRowVector<ElemT, Dim>のk-d木
+     *
+     * 各節点で点の広がりが最も大きい軸を選び、中央値で二分する。節点は前順に1つの配列へ並べ、左の子を直後に、
+     * 右の子の位置を節点に持たせる。点の座標は葉の順に並べ替えた連続の配列として保持するため、探索は配列を前方へ読み進める。
+     * 中央値で分割するため部分木の節点数は点の数のみで決まり、上位の節点を分割した後の部分木は互いに独立に並列で構築できる。
+     * 構築結果はスレッド数に依らない。
+     *
+     * 探索は距離の2乗で比較し、分割面までの距離の2乗が現在の候補より大きい部分木は探索しない。
+     * 探索は木を変更せず、スタックも呼び出しごとに確保するため、複数のスレッドから同時に呼び出せる。
+     */
+    template <FloatingPoint ElemT, SizeT Dim>
+    class StaticVectorKDTree {
+        public:
+            using Point = StaticRowVector<ElemT, Dim>;
+
+            struct Neighbor {
+                SizeT index;                // 構築時の点の添え字
+                ElemT squared_distance;
+            };
+        private:
+            struct Node {
+                ElemT split;                // 分割値 (内部節点)
+                std::uint32_t axis;         // 分割軸。葉ではDim
+                std::uint32_t offset;       // 内部節点では右の子の添え字、葉では点の開始位置
+                std::uint32_t count;        // 葉の点の数
+            };
+            static constexpr std::uint32_t leaf = Dim;
+            // 探索のスタックの大きさ (木の深さはlog2(点の数) + 1以下である)
+            static constexpr SizeT max_depth = 64;
+
+            SizeT leaf_size_;
+            std::vector<Node> nodes_;
+            std::vector<ElemT> coordinates_;        // 葉の順に並べた点の座標 (点ごとにDim個)
+            std::vector<std::uint32_t> indices_;    // 並べ替え後の点の構築時の添え字
+
+            // n個の点の部分木の節点数
+            SizeT node_count(const SizeT& n) const {
+                return n <= this->leaf_size_ ? 1 : 1 + this->node_count(n / 2) + this->node_count(n - n / 2);
+            }
+            // [begin, end)の点を中央値で分割し、nodeを内部節点とする (右の子の添え字は呼び出し側で設定する)
+            SizeT split(std::span<const Point> points, const SizeT& node, const SizeT& begin, const SizeT& end) {
+                Array<ElemT, Dim> low, high;
+                low.fill(std::numeric_limits<ElemT>::infinity());
+                high.fill(-std::numeric_limits<ElemT>::infinity());
+                for(SizeT i = begin; i < end; ++i) {
+                    const Point& point = points[this->indices_[i]];
+                    for(SizeT d = 0; d < Dim; ++d) {
+                        low[d] = std::min(low[d], point[d]);
+                        high[d] = std::max(high[d], point[d]);
+                    }
+                }
+                SizeT axis = 0;
+                for(SizeT d = 1; d < Dim; ++d) {
+                    if(high[d] - low[d] > high[axis] - low[axis]) {
+                        axis = d;
+                    }
+                }
+                const SizeT mid = begin + (end - begin) / 2;
+                std::nth_element(
+                    this->indices_.begin() + begin, this->indices_.begin() + mid, this->indices_.begin() + end,
+                    [&](const std::uint32_t& a, const std::uint32_t& b) { return points[a][axis] < points[b][axis]; }
+                );
+                this->nodes_[node] = {points[this->indices_[mid]][axis], static_cast<std::uint32_t>(axis), 0, 0};
+                return mid;
+            }
+            // nodeを根とする[begin, end)の部分木を構築し、次の節点の添え字を返す
+            SizeT build(std::span<const Point> points, const SizeT& node, const SizeT& begin, const SizeT& end) {
+                if(end - begin <= this->leaf_size_) {
+                    this->nodes_[node] = {ElemT(), leaf, static_cast<std::uint32_t>(begin), static_cast<std::uint32_t>(end - begin)};
+                    return node + 1;
+                }
+                const SizeT mid = this->split(points, node, begin, end);
+                const SizeT right = this->build(points, node + 1, begin, mid);
+                this->nodes_[node].offset = static_cast<std::uint32_t>(right);
+                return this->build(points, right, mid, end);
+            }
+
+            ElemT squared_distance(const Point& query, const SizeT& i) const {
+                const ElemT* const point = this->coordinates_.data() + i * Dim;
+                ElemT sum = ElemT();
+                for(SizeT d = 0; d < Dim; ++d) {
+                    const ElemT diff = point[d] - query[d];
+                    sum += diff * diff;
+                }
+                return sum;
+            }
+
+            /*
+             * 近い側の子から深さ優先で探索し、葉ではvisit(i, 距離の2乗)を呼び出す
+             * boundは現在の枝刈りの閾値(距離の2乗)を返す関数であり、分割面までの距離の2乗がこれを超える部分木は探索しない。
+             */
+            template <class Visit, class Bound>
+            void traverse(const Point& query, const Visit& visit, const Bound& bound) const {
+                Array<std::pair<std::uint32_t, ElemT>, max_depth> stack;
+                SizeT top = 0;
+                stack[top++] = {0, ElemT()};
+                while(top > 0) {
+                    const auto [index, plane] = stack[--top];
+                    if(plane > bound()) {
+                        continue;
+                    }
+                    SizeT node = index;
+                    // 内部節点では遠い側をスタックに積み、近い側へ進む
+                    while(this->nodes_[node].axis != leaf) {
+                        const Node& current = this->nodes_[node];
+                        const ElemT diff = query[current.axis] - current.split;
+                        const ElemT far_plane = diff * diff;
+                        const SizeT near_child = diff < 0 ? node + 1 : current.offset;
+                        const SizeT far_child = diff < 0 ? current.offset : node + 1;
+                        if(far_plane <= bound()) {
+                            assert(top < max_depth);
+                            stack[top++] = {static_cast<std::uint32_t>(far_child), far_plane};
+                        }
+                        node = near_child;
+                    }
+                    const Node& current = this->nodes_[node];
+                    for(SizeT i = current.offset; i < current.offset + current.count; ++i) {
+                        visit(i, this->squared_distance(query, i));
+                    }
+                }
+            }
+        public:
+            /*
+             * 引数
+             * - points  : 点群 (添え字は探索結果のNeighbor::indexとなる)
+             * - options : 葉の大きさ、構築に使用するスレッド数
+             */
+            explicit StaticVectorKDTree(std::span<const Point> points, const KDTreeOptions& options = {}) : leaf_size_(std::max<SizeT>(options.leaf_size, 1)) {
+                const SizeT n = points.size();
+                assert(n < std::numeric_limits<std::uint32_t>::max());
+                this->indices_.resize(n);
+                std::iota(this->indices_.begin(), this->indices_.end(), 0);
+                this->nodes_.resize(this->node_count(n));
+
+                // 上位の節点を逐次に分割し、スレッド数以上の独立な部分木に分ける
+                struct Task { SizeT node, begin, end; };
+                std::vector<Task> tasks = {{0, 0, n}};
+                const SizeT threads = klibrary::parallel::thread_count(options.threads);
+                while(tasks.size() < threads) {
+                    std::vector<Task> next;
+                    bool divided = false;
+                    for(const Task& task : tasks) {
+                        if(task.end - task.begin <= this->leaf_size_) {
+                            next.push_back(task);
+                            continue;
+                        }
+                        const SizeT mid = this->split(points, task.node, task.begin, task.end);
+                        const SizeT right = task.node + 1 + this->node_count(mid - task.begin);
+                        this->nodes_[task.node].offset = static_cast<std::uint32_t>(right);
+                        next.push_back({task.node + 1, task.begin, mid});
+                        next.push_back({right, mid, task.end});
+                        divided = true;
+                    }
+                    tasks = std::move(next);
+                    if(!divided) {
+                        break;
+                    }
+                }
+                klibrary::parallel::parallel_for(0, tasks.size(), threads, [&](const SizeT& first, const SizeT& last) {
+                    for(SizeT t = first; t < last; ++t) {
+                        this->build(points, tasks[t].node, tasks[t].begin, tasks[t].end);
+                    }
+                });
+
+                this->coordinates_.resize(n * Dim);
+                klibrary::parallel::parallel_for(0, n, threads, [&](const SizeT& first, const SizeT& last) {
+                    for(SizeT i = first; i < last; ++i) {
+                        for(SizeT d = 0; d < Dim; ++d) {
+                            this->coordinates_[i * Dim + d] = points[this->indices_[i]][d];
+                        }
+                    }
+                });
+            }
+
+            SizeT size() const noexcept {
+                return this->indices_.size();
+            }
+
+            /*
+             * queryに近いk個の点を距離の昇順にresultへ書き込む (点の数がk未満の場合は全ての点)
+             * resultの領域は再利用される。
+             */
+            void nearest(const Point& query, SizeT k, std::vector<Neighbor>& result) const {
+                k = std::min(k, this->size());
+                result.clear();
+                if(k == 0) {
+                    return;
+                }
+                // 距離の2乗が最大の候補を先頭に持つヒープ
+                const auto farther = [](const Neighbor& a, const Neighbor& b) { return a.squared_distance < b.squared_distance; };
+                this->traverse(
+                    query,
+                    [&](const SizeT& i, const ElemT& squared_distance) {
+                        if(result.size() < k) {
+                            result.push_back({i, squared_distance});
+                            std::push_heap(result.begin(), result.end(), farther);
+                        } else if(squared_distance < result.front().squared_distance) {
+                            std::pop_heap(result.begin(), result.end(), farther);
+                            result.back() = {i, squared_distance};
+                            std::push_heap(result.begin(), result.end(), farther);
+                        }
+                    },
+                    [&] { return result.size() < k ? std::numeric_limits<ElemT>::infinity() : result.front().squared_distance; }
+                );
+                std::sort_heap(result.begin(), result.end(), farther);
+                for(auto& neighbor : result) {
+                    neighbor.index = this->indices_[neighbor.index];
+                }
+            }
+            std::vector<Neighbor> nearest(const Point& query, const SizeT& k) const {
+                std::vector<Neighbor> result;
+                result.reserve(std::min(k, this->size()));
+                this->nearest(query, k, result);
+                return result;
+            }
+
+            /*
+             * queryからの距離がradius以下の点をresultへ書き込む (順序は木の葉の順であり、距離の順ではない)
+             * resultの領域は再利用される。
+             */
+            void within_radius(const Point& query, const ElemT& radius, std::vector<Neighbor>& result) const {
+                result.clear();
+                if(this->size() == 0) {
+                    return;
+                }
+                const ElemT squared_radius = radius * radius;
+                this->traverse(
+                    query,
+                    [&](const SizeT& i, const ElemT& squared_distance) {
+                        if(squared_distance <= squared_radius) {
+                            result.push_back({this->indices_[i], squared_distance});
+                        }
+                    },
+                    [&] { return squared_radius; }
+                );
+            }
+            std::vector<Neighbor> within_radius(const Point& query, const ElemT& radius) const {
+                std::vector<Neighbor> result;
+                this->within_radius(query, radius, result);
+                return result;
+            }
+
+            /*
+             * 複数の点についてのnearest
+             * 戻り値はqueries.size() * min(k, size())個であり、q番目の点の結果は[q * min(k, size()), (q + 1) * min(k, size()))に並ぶ。
+             */
+            std::vector<Neighbor> nearest_batch(std::span<const Point> queries, const SizeT& k, const SizeT& threads = 1) const {
+                const SizeT count = std::min(k, this->size());
+                std::vector<Neighbor> result(queries.size() * count);
+                klibrary::parallel::parallel_for(0, queries.size(), threads, [&](const SizeT& first, const SizeT& last) {
+                    std::vector<Neighbor> buffer;
+                    buffer.reserve(count);
+                    for(SizeT q = first; q < last; ++q) {
+                        this->nearest(queries[q], count, buffer);
+                        std::copy(buffer.begin(), buffer.end(), result.begin() + q * count);
+                    }
+                });
+                return result;
+            }
+            // 複数の点についてのwithin_radius
+            std::vector<std::vector<Neighbor>> within_radius_batch(std::span<const Point> queries, const ElemT& radius, const SizeT& threads = 1) const {
+                std::vector<std::vector<Neighbor>> result(queries.size());
+                klibrary::parallel::parallel_for(0, queries.size(), threads, [&](const SizeT& first, const SizeT& last) {
+                    for(SizeT q = first; q < last; ++q) {
+                        this->within_radius(queries[q], radius, result[q]);
+                    }
+                });
+                return result;
+            }
+    };
+}
+#endif // staticvector_kd_tree_hpp
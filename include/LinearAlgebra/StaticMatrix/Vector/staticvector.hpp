@@ -1,28 +1,24 @@
 #ifndef staticvector_hpp
 #define staticvector_hpp
 #include "./../AliasAndConcepts/staticmatrix_alias_and_concepts.hpp"
-#include "./staticvector_base.hpp"
+#include "./Base/staticvector_base.hpp"
 #include "./BasicVectors/staticvector_basic_vectors.hpp"
 #include "./Geometory/staticvector_geometory.hpp"
 namespace klibrary::linear_algebra {
+    // Rows x 1 のベクトル
     template <class ElemT, SizeT Rows>
-    class StaticRowVector : 
-        public StaticVectorBase<ElemT, Rows, 1>,
-        public StaticVectorBasicVectors<ElemT, Rows, 1>,
-        public StaticVectorGeometory<ElemT, Rows, 1>
-    {
+    class StaticRowVector : public StaticVectorGeometory<ElemT, Rows, 1> {
         public:
-            using StaticVectorBase<ElemT, Rows, 1>::StaticVectorBase;
+            using StaticVectorGeometory<ElemT, Rows, 1>::StaticVectorGeometory;
+            StaticRowVector(const StaticVectorBase<ElemT, Rows, 1>& vector) : StaticVectorGeometory<ElemT, Rows, 1>(vector){}
     };
 
+    // 1 x Cols のベクトル
     template <class ElemT, SizeT Cols>
-    class StaticColVector : 
-        public StaticVectorBase<ElemT, 1, Cols>,
-        public StaticVectorBasicVectors<ElemT, 1, Cols>,
-        public StaticVectorGeometory<ElemT, 1, Cols>
-    {
+    class StaticColVector : public StaticVectorGeometory<ElemT, 1, Cols> {
         public:
-            using StaticVectorBase<ElemT, 1, Cols>::StaticVectorBase;
+            using StaticVectorGeometory<ElemT, 1, Cols>::StaticVectorGeometory;
+            StaticColVector(const StaticVectorBase<ElemT, 1, Cols>& vector) : StaticVectorGeometory<ElemT, 1, Cols>(vector){}
     };
 }
 #endif // staticvector_hpp
\ No newline at end of file
@@ -4,9 +4,56 @@
 #include <limits>
 #include <iostream>
 #include "constants.hpp"
+#include "numerical_differentiation.hpp"
+#include "dual_number.hpp"
+#include "solver_status.hpp"
+#include "solver_options.hpp"
+#include "least_squares.hpp"
+#include <cmath>
+#include <algorithm>
+#include <concepts>
 namespace numerical_analysis {
     using function = std::function<double(double)>;
-    class Derivative;
+
+    /*
+     * f(x)の微分df(x)が既知である場合にNewton-Raphson法によるf(x)=0の解の探索を行い、
+     * 反復回数や終了状態を含む結果を返す。
+     * 収束判定は|(x_next - x) / x| < epsilonであり、x_nextが有限でなくなった場合はDivergedとなる。
+     *
+     * 引数
+     * - current_x      : 探索を開始するx
+     * - f              : f(x)
+     * - df             : df(x)
+     * - options        : 求解の設定 (epsilon, max_attempts, profilerを使用する)
+     */
+    inline SolverResult newton_raphson(
+        double current_x,
+        const function&  f,
+        const function& df,
+        const SolverOptions& options
+    ) {
+        const detail::SolverProfile profile(options, "newton_raphson");
+        SolverResult result = {current_x, SolverStatus::MaxAttemptsReached, 0, 0, 0, {}};
+        while(result.iterations < options.max_attempts.value_or(Constants::max_attempts)) {
+            const double fx = f(current_x);
+            ++result.iterations;
+            ++result.evaluations;
+            result.residual = std::abs(fx);
+            const double next_x = current_x - fx / df(current_x);
+            if(!std::isfinite(next_x)) {
+                result.status = SolverStatus::Diverged;
+                break;
+            }
+            if(std::abs((next_x - current_x) / current_x) < options.epsilon) {
+                current_x = next_x;
+                result.status = SolverStatus::Converged;
+                break;
+            }
+            current_x = next_x;
+        }
+        result.root = current_x;
+        return profile.finish(result);
+    }
 
     /*
      * f(x)の微分df(x)が既知である場合にNewton-Raphson法によるf(x)=0の解の探索を行う。
@@ -18,21 +65,55 @@ namespace numerical_analysis {
      * - epsilon        : 収束判定の条件
      * - max_attempts   : 最大試行回数
      */
-    double newton_raphson(
+    inline double newton_raphson(
         double current_x,
         const function&  f,
         const function& df,
         const double& epsilon           = Constants::epsilon,
         const std::size_t& max_attempts = Constants::max_attempts
     ) {
-        for(std::size_t i = 0; i < max_attempts; ++i) {
-            double next_x = current_x - f(current_x) / df(current_x);
-            if(std::abs((next_x - current_x) / current_x) < epsilon) {
-                return next_x;
+        return newton_raphson(current_x, f, df, SolverOptions{.epsilon = epsilon, .max_attempts = max_attempts}).root;
+    }
+
+    /*
+     * f(x)の微分df(x)が未知である場合に数値微分でdf(x)を求め、Newton-Raphson法によるf(x)=0の解の探索を行い、
+     * 反復回数や終了状態を含む結果を返す。評価回数には数値微分のための評価を含む。
+     *
+     * 引数
+     * - current_x      : 探索を開始するx
+     * - f              : f(x)
+     * - options        : 求解の設定 (epsilon, max_attempts, h, derivative_type, profilerを使用する)
+     */
+    inline SolverResult newton_raphson(
+        double current_x,
+        const function& f,
+        const SolverOptions& options
+    ) {
+        const detail::SolverProfile profile(options, "newton_raphson");
+        SolverResult result = {current_x, SolverStatus::MaxAttemptsReached, 0, 0, 0, {}};
+        const auto counted = [&](const double& x) {
+            ++result.evaluations;
+            return f(x);
+        };
+        const BasicDerivative<const decltype(counted)&> derivative(counted, options.h);
+        while(result.iterations < options.max_attempts.value_or(Constants::max_attempts)) {
+            const double fx = counted(current_x);
+            ++result.iterations;
+            result.residual = std::abs(fx);
+            const double next_x = current_x - fx / derivative.with_respect_to(current_x, options.derivative_type);
+            if(!std::isfinite(next_x)) {
+                result.status = SolverStatus::Diverged;
+                break;
+            }
+            if(std::abs((next_x - current_x) / current_x) < options.epsilon) {
+                current_x = next_x;
+                result.status = SolverStatus::Converged;
+                break;
             }
             current_x = next_x;
         }
-        return current_x;
+        result.root = current_x;
+        return profile.finish(result);
     }
 
     /*
@@ -46,7 +127,7 @@ namespace numerical_analysis {
      * - type           : 数値微分方法指定 (前進差分、中心差分、後退差分)
      * - max_attempts   : 最大試行回数
      */
-    double newton_raphson(
+    inline double newton_raphson(
         double current_x,
         const function& f,
         const double& h                 = Constants::h,
@@ -54,18 +135,135 @@ namespace numerical_analysis {
         const Derivative::Type type     = Derivative::Type::Central,
         const std::size_t& max_attempts = Constants::max_attempts
     ) {
-        for(std::size_t i = 0; i < max_attempts; ++i) {
-            double next_x = current_x - f(current_x) / Derivative(f, h).with_respect_to(current_x);
-            if(std::abs((next_x - current_x) / current_x) < epsilon) {
-                return next_x;
+        return newton_raphson(current_x, f, SolverOptions{.epsilon = epsilon, .max_attempts = max_attempts, .h = h, .derivative_type = type}).root;
+    }
+
+    /*
+     * f(x)を二重数で評価する自動微分によりf(x)とdf(x)を同時に求め、Newton-Raphson法によるf(x)=0の解の探索を行い、
+     * 反復回数や終了状態を含む結果を返す。
+     *
+     * 引数
+     * - current_x      : 探索を開始するx
+     * - f              : f(x)
+     * - options        : 求解の設定 (epsilon, max_attempts, profilerを使用する)
+     */
+    template <class X, class F>
+    requires std::convertible_to<X, double> && std::invocable<const F&, Dual<double>> &&
+             std::convertible_to<std::invoke_result_t<const F&, Dual<double>>, Dual<double>>
+    SolverResult newton_raphson_ad(
+        const X& initial_x,
+        const F& f,
+        const SolverOptions& options
+    ) {
+        const detail::SolverProfile profile(options, "newton_raphson_ad");
+        double current_x = initial_x;
+        SolverResult result = {current_x, SolverStatus::MaxAttemptsReached, 0, 0, 0, {}};
+        while(result.iterations < options.max_attempts.value_or(Constants::max_attempts)) {
+            const Dual<double> y = f(Dual<double>::variable(current_x));
+            ++result.iterations;
+            ++result.evaluations;
+            result.residual = std::abs(y.value());
+            const double next_x = current_x - y.value() / y.derivative();
+            if(!std::isfinite(next_x)) {
+                result.status = SolverStatus::Diverged;
+                break;
+            }
+            if(std::abs((next_x - current_x) / current_x) < options.epsilon) {
+                current_x = next_x;
+                result.status = SolverStatus::Converged;
+                break;
             }
             current_x = next_x;
         }
-        return current_x;
+        result.root = current_x;
+        return profile.finish(result);
+    }
+
+    /*
+     * f(x)を二重数で評価する自動微分によりf(x)とdf(x)を同時に求め、Newton-Raphson法によるf(x)=0の解の探索を行う。
+     * 1回の反復でfを1回だけ評価し、微分は打ち切り誤差を含まない。
+     * fはDual<double>を引数に取れなければならない (ジェネリックラムダ等。数学関数は非修飾名で呼び出す)。
+     *
+     * newton_raphson_ad(0, [](const auto& x){ return 4.2 * cos(x) - 1.7 * x; });
+     *
+     * 引数
+     * - current_x      : 探索を開始するx
+     * - f              : f(x)
+     * - epsilon        : 収束判定条件
+     * - max_attempts   : 最大試行回数
+     */
+    template <class X, class F>
+    requires std::convertible_to<X, double> && std::invocable<const F&, Dual<double>> &&
+             std::convertible_to<std::invoke_result_t<const F&, Dual<double>>, Dual<double>>
+    double newton_raphson_ad(
+        const X& initial_x,
+        const F& f,
+        const double& epsilon           = Constants::epsilon,
+        const std::size_t& max_attempts = Constants::max_attempts
+    ) {
+        return newton_raphson_ad(initial_x, f, SolverOptions{.epsilon = epsilon, .max_attempts = max_attempts}).root;
+    }
+
+    /*
+     * [l, r)について二分法によるf(x)=0の解の探索を行い、反復回数や終了状態を含む結果を返す。
+     * 範囲の幅がepsilon以下になるか、中点が端点と一致した (これ以上二分できない) 時点で収束とする。
+     * max_attempts回 (未指定の場合はConstants::bisection_max_attempts回) の反復で収束しなかった場合はMaxAttemptsReachedとなる。
+     * 両端でf(x)の符号が異なっていない場合はInvalidBracketとなる (探索自体は従来通り行う)。
+     *
+     * 引数
+     * - f              : f(x)
+     * - l              : 探索範囲の左端
+     * - r              : 探索範囲の右端
+     * - options        : 求解の設定 (epsilon, max_attempts, profilerを使用する)
+     */
+    inline SolverResult bisection_method(
+        const std::function<double(double)>& f,
+        double l,
+        double r,
+        const SolverOptions& options
+    ) {
+        const detail::SolverProfile profile(options, "bisection_method");
+        const double fl = f(l);
+        const double fr = f(r);
+        const bool increasing = fl < fr;
+        SolverResult result = {(l + r) / 2, SolverStatus::Converged, 0, 2, std::min(std::abs(fl), std::abs(fr)), {}};
+        if((fl > 0 && fr > 0) || (fl < 0 && fr < 0)) {
+            result.status = SolverStatus::InvalidBracket;
+        }
+        const std::size_t max_attempts = options.max_attempts.value_or(Constants::bisection_max_attempts);
+        double range = r - l;
+        double m = (l + r) / 2;
+        while(range > options.epsilon) {
+            const double mid = (l + r) / 2;
+            if(mid == l || mid == r) {
+                break;
+            }
+            if(result.iterations >= max_attempts) {
+                if(result.status == SolverStatus::Converged) {
+                    result.status = SolverStatus::MaxAttemptsReached;
+                }
+                break;
+            }
+            m = mid;
+            const double fm = f(m);
+            ++result.iterations;
+            ++result.evaluations;
+            result.residual = std::abs(fm);
+            if(increasing) {
+                fm > 0 ? r = m : l = m;
+            } else {
+                fm > 0 ? l = m : r = m;
+            }
+            range = r - l;
+        }
+        result.root = m;
+        return profile.finish(result);
     }
 
     /*
      * [l, r)について二分法によるf(x)=0の解の探索を行う
+     * 両端のf(x)は最初に1度だけ評価し、1回の反復でfを1回だけ評価する。
+     * 反復はConstants::bisection_max_attempts回で打ち切る (中点が端点と一致した時点で終了するため、通常はこれに達しない)。
      *
      * 引数
      * - f              : f(x)
@@ -73,24 +271,152 @@ namespace numerical_analysis {
      * - r              : 探索範囲の右端
      * - epsilon        : 収束判定条件
      */
-    double bisection_method(
+    inline double bisection_method(
         const std::function<double(double)>& f,
         double l,
         double r,
         const double& epsilon = Constants::epsilon
     ) {
-        double range = r - l;
-        double m;
-        while(range > epsilon) {
-            m = (l + r) / 2;
-            if(f(l) < f(r)) {
-                f(m) > 0 ? r = m : l = m;
+        return bisection_method(f, l, r, SolverOptions{.epsilon = epsilon}).root;
+    }
+
+    /*
+     * 囲い込み法の結果
+     *
+     * - root           : 解
+     * - status         : 終了状態
+     * - iterations     : 反復回数
+     * - evaluations    : f(x)の評価回数
+     */
+    struct BracketResult {
+        double          root;
+        SolverStatus    status;
+        std::size_t     iterations;
+        std::size_t     evaluations;
+    };
+
+    /*
+     * [l, r]についてBrent法によるf(x)=0の解の探索を行い、反復回数や終了状態を含む結果を返す。
+     *
+     * 逆2次補間・割線法と二分法を組み合わせ、二分法と同様に収束を保証しつつ超一次収束する。
+     * 両端で2回、以降は1回の反復でfを1回だけ評価する。
+     * 両端でf(x)の符号が異なっていない場合はInvalidBracketを返す。
+     *
+     * 引数
+     * - f              : f(x)
+     * - l              : 探索範囲の左端
+     * - r              : 探索範囲の右端
+     * - options        : 求解の設定 (epsilon(解を含む区間の幅), max_attempts, profilerを使用する)
+     */
+    template <class F>
+    SolverResult brent_method(
+        const F& f,
+        double l,
+        double r,
+        const SolverOptions& options
+    ) {
+        const detail::SolverProfile profile(options, "brent_method");
+        const double epsilon = options.epsilon;
+        double a = l, b = r;
+        double fa = f(a), fb = f(b);
+        SolverResult result = {b, SolverStatus::MaxAttemptsReached, 0, 2, std::abs(fb), {}};
+        if((fa > 0 && fb > 0) || (fa < 0 && fb < 0)) {
+            result.root = (l + r) / 2;
+            result.status = SolverStatus::InvalidBracket;
+            result.residual = std::min(std::abs(fa), std::abs(fb));
+            return profile.finish(result);
+        }
+        if(fa == 0) {
+            result.root = a;
+            result.status = SolverStatus::Converged;
+            result.residual = 0;
+            return profile.finish(result);
+        }
+
+        double c = b, fc = fb;
+        double d = b - a, e = d;
+        const std::size_t max_attempts = options.max_attempts.value_or(Constants::brent_max_attempts);
+        for(; result.iterations < max_attempts; ++result.iterations) {
+            // cはbとの間に解を挟む点
+            if((fb > 0 && fc > 0) || (fb < 0 && fc < 0)) {
+                c = a;
+                fc = fa;
+                d = e = b - a;
+            }
+            // bを最良の近似とする
+            if(std::abs(fc) < std::abs(fb)) {
+                a = b; b = c; c = a;
+                fa = fb; fb = fc; fc = fa;
+            }
+            const double tolerance = 2 * std::numeric_limits<double>::epsilon() * std::abs(b) + epsilon / 2;
+            const double half = (c - b) / 2;
+            if(std::abs(half) <= tolerance || fb == 0) {
+                result.root = b;
+                result.residual = std::abs(fb);
+                result.status = SolverStatus::Converged;
+                return profile.finish(result);
+            }
+            if(std::abs(e) >= tolerance && std::abs(fa) > std::abs(fb)) {
+                double p, q;
+                const double s = fb / fa;
+                if(a == c) {
+                    // 割線法
+                    p = 2 * half * s;
+                    q = 1 - s;
+                } else {
+                    // 逆2次補間
+                    const double t = fa / fc;
+                    const double u = fb / fc;
+                    p = s * (2 * half * t * (t - u) - (b - a) * (u - 1));
+                    q = (t - 1) * (u - 1) * (s - 1);
+                }
+                if(p > 0) {
+                    q = -q;
+                }
+                p = std::abs(p);
+                if(2 * p < std::min(3 * half * q - std::abs(tolerance * q), std::abs(e * q))) {
+                    e = d;
+                    d = p / q;
+                } else {
+                    // 補間が範囲外に出る、または縮小が遅い場合は二分法
+                    d = half;
+                    e = d;
+                }
             } else {
-                f(m) > 0 ? l = m : r = m;
+                d = half;
+                e = d;
             }
-            range = r - l;
+            a = b;
+            fa = fb;
+            b += std::abs(d) > tolerance ? d : std::copysign(tolerance, half);
+            fb = f(b);
+            ++result.evaluations;
         }
-        return m;
+        result.root = b;
+        result.residual = std::abs(fb);
+        return profile.finish(result);
+    }
+
+    /*
+     * [l, r]についてBrent法によるf(x)=0の解の探索を行う
+     *
+     * 引数
+     * - f              : f(x)
+     * - l              : 探索範囲の左端
+     * - r              : 探索範囲の右端
+     * - epsilon        : 収束判定条件 (解を含む区間の幅)
+     * - max_attempts   : 最大試行回数
+     */
+    template <class F>
+    BracketResult brent_method(
+        const F& f,
+        double l,
+        double r,
+        const double& epsilon           = Constants::epsilon,
+        const std::size_t& max_attempts = Constants::brent_max_attempts
+    ) {
+        const SolverResult result = brent_method(f, l, r, SolverOptions{.epsilon = epsilon, .max_attempts = max_attempts});
+        return {result.root, result.status, result.iterations, result.evaluations};
     }
 }
 #endif // approximation_algorithm
@@ -0,0 +1,178 @@
+#ifndef batch_root_finding
+#define batch_root_finding
+#include <array>
+#include <span>
+#include <cmath>
+#include <cstddef>
+#include <cassert>
+#include <algorithm>
+#include "constants.hpp"
+#include "solver_status.hpp"
+#include "./../Parallel/parallel_for.hpp"
+namespace numerical_analysis {
+    /*
+     * 複数の初期値・探索範囲についての一括求解
+     *
+     * 同じ方程式をパラメータを変えて多数回解く場合に使用する。
+     * 入力をlanes_per_block個ずつのブロックに分け、ブロック内の全レーンを同時に反復する。
+     * 反復中は全レーンについてf(x)を評価し、収束したレーンはマスクにより値を固定する。
+     * 分岐を含まないため、fがインライン化可能であればコンパイラによりSIMD化される。
+     * ブロック内の全レーンが収束した時点でそのブロックの反復を終了する。
+     *
+     * threadsに2以上(0の場合はハードウェアの並列数)を指定すると、ブロックを複数のスレッドで処理する。
+     * 各レーンの解はroots、終了状態はstatusに書き込まれる。
+     */
+    namespace batch {
+        constexpr std::size_t lanes_per_block = 8;
+    }
+
+    /*
+     * 各初期値xs[i]からNewton-Raphson法によるf(x)=0の解の探索を行う。
+     * 収束判定はnewton_raphsonと同じく|(x_next - x) / x| < epsilonである。
+     *
+     * 引数
+     * - xs             : 探索を開始するx
+     * - f              : f(x)
+     * - df             : df(x)
+     * - roots          : 解の書き込み先
+     * - status         : 終了状態の書き込み先
+     * - epsilon        : 収束判定条件
+     * - max_attempts   : 最大試行回数
+     * - threads        : 使用するスレッド数
+     */
+    template <class F, class DF>
+    void newton_raphson_batch(
+        std::span<const double> xs,
+        const F& f,
+        const DF& df,
+        std::span<double> roots,
+        std::span<SolverStatus> status,
+        const double& epsilon           = Constants::epsilon,
+        const std::size_t& max_attempts = Constants::max_attempts,
+        const std::size_t& threads      = 1
+    ) {
+        assert(xs.size() == roots.size() && xs.size() == status.size());
+        constexpr std::size_t W = batch::lanes_per_block;
+
+        const auto solve = [&](const std::size_t& begin, const std::size_t& end) {
+            for(std::size_t i = begin; i < end; i += W) {
+                const std::size_t m = std::min(W, end - i);
+                std::array<double, W> x{};
+                std::array<double, W> next{};
+                std::array<bool, W> active{};
+                std::array<SolverStatus, W> state;
+                state.fill(SolverStatus::MaxAttemptsReached);
+                // 端数のレーンは最後のレーンの値で埋め、マスクで無効にする
+                for(std::size_t l = 0; l < W; ++l) {
+                    x[l] = xs[i + std::min(l, m - 1)];
+                    active[l] = l < m;
+                }
+                for(std::size_t attempt = 0; attempt < max_attempts; ++attempt) {
+                    for(std::size_t l = 0; l < W; ++l) {
+                        next[l] = x[l] - f(x[l]) / df(x[l]);
+                    }
+                    bool any = false;
+                    for(std::size_t l = 0; l < W; ++l) {
+                        const bool finite    = std::isfinite(next[l]);
+                        const bool converged = std::abs((next[l] - x[l]) / x[l]) < epsilon;
+                        x[l] = active[l] && finite ? next[l] : x[l];
+                        state[l] = !active[l] ? state[l] : (!finite ? SolverStatus::Diverged : (converged ? SolverStatus::Converged : state[l]));
+                        active[l] = active[l] && finite && !converged;
+                        any = any || active[l];
+                    }
+                    if(!any) {
+                        break;
+                    }
+                }
+                for(std::size_t l = 0; l < m; ++l) {
+                    roots[i + l] = x[l];
+                    status[i + l] = state[l];
+                }
+            }
+        };
+        klibrary::parallel::parallel_for(0, xs.size(), threads, solve, W);
+    }
+
+    /*
+     * 各範囲[ls[i], rs[i])について二分法によるf(x)=0の解の探索を行う。
+     * 1回の反復でfを1回だけ評価する。両端でf(x)の符号が異なっていない範囲の状態はInvalidBracketとなる。
+     * 範囲の幅がepsilon以下になるか、中点が端点と一致した (これ以上二分できない) レーンは収束とし、
+     * max_attempts回の反復で収束しなかったレーンの状態はMaxAttemptsReachedとなる。
+     *
+     * 引数
+     * - ls             : 探索範囲の左端
+     * - rs             : 探索範囲の右端
+     * - f              : f(x)
+     * - roots          : 解の書き込み先
+     * - status         : 終了状態の書き込み先
+     * - epsilon        : 収束判定条件
+     * - max_attempts   : 最大試行回数
+     * - threads        : 使用するスレッド数
+     */
+    template <class F>
+    void bisection_method_batch(
+        std::span<const double> ls,
+        std::span<const double> rs,
+        const F& f,
+        std::span<double> roots,
+        std::span<SolverStatus> status,
+        const double& epsilon           = Constants::epsilon,
+        const std::size_t& max_attempts = Constants::bisection_max_attempts,
+        const std::size_t& threads      = 1
+    ) {
+        assert(ls.size() == rs.size() && ls.size() == roots.size() && ls.size() == status.size());
+        constexpr std::size_t W = batch::lanes_per_block;
+
+        const auto solve = [&](const std::size_t& begin, const std::size_t& end) {
+            for(std::size_t i = begin; i < end; i += W) {
+                const std::size_t m = std::min(W, end - i);
+                std::array<double, W> l{};
+                std::array<double, W> r{};
+                std::array<double, W> fl{};
+                std::array<bool, W> active{};
+                std::array<SolverStatus, W> state;
+                // 端数のレーンは最後のレーンの値で埋め、マスクで無効にする
+                for(std::size_t k = 0; k < W; ++k) {
+                    l[k] = ls[i + std::min(k, m - 1)];
+                    r[k] = rs[i + std::min(k, m - 1)];
+                }
+                for(std::size_t k = 0; k < W; ++k) {
+                    fl[k] = f(l[k]);
+                    const double fr = f(r[k]);
+                    const bool valid = !(fl[k] > 0 && fr > 0) && !(fl[k] < 0 && fr < 0);
+                    state[k] = valid ? SolverStatus::MaxAttemptsReached : SolverStatus::InvalidBracket;
+                    active[k] = k < m && valid;
+                }
+                // 収束したレーンを止め、反復を続けるレーンが残っているかを返す
+                const auto update = [&]() {
+                    bool any = false;
+                    for(std::size_t k = 0; k < W; ++k) {
+                        const double mid     = (l[k] + r[k]) / 2;
+                        const bool converged = !(r[k] - l[k] > epsilon) || mid == l[k] || mid == r[k];
+                        state[k]  = active[k] && converged ? SolverStatus::Converged : state[k];
+                        active[k] = active[k] && !converged;
+                        any = any || active[k];
+                    }
+                    return any;
+                };
+                for(std::size_t attempt = 0; attempt < max_attempts && update(); ++attempt) {
+                    for(std::size_t k = 0; k < W; ++k) {
+                        const double mid  = (l[k] + r[k]) / 2;
+                        const double fm   = f(mid);
+                        const bool same   = (fm > 0) == (fl[k] > 0);
+                        l[k]  = active[k] && same ? mid : l[k];
+                        fl[k] = active[k] && same ? fm : fl[k];
+                        r[k]  = active[k] && !same ? mid : r[k];
+                    }
+                }
+                update();
+                for(std::size_t k = 0; k < m; ++k) {
+                    roots[i + k] = (l[k] + r[k]) / 2;
+                    status[i + k] = state[k];
+                }
+            }
+        };
+        klibrary::parallel::parallel_for(0, ls.size(), threads, solve, W);
+    }
+}
+#endif // batch_root_finding
@@ -1,6 +1,7 @@
 ﻿#ifndef constants
 #define constants
 #include <cstddef>
+#include <limits>
 #include <numbers>
 namespace numerical_analysis {
     /*
@@ -18,6 +19,8 @@ namespace numerical_analysis {
      * - h              : 数値微分に使用される差分幅
      * - epsilon        : 近似計算における収束判定条件
      * - max_attempts   : 近似計算の最大繰り返し試行回数
+     * - bisection_max_attempts : 二分法の最大繰り返し試行回数 (doubleの任意の範囲を隣接する2数になるまで二分できる回数)
+     * - brent_max_attempts     : Brent法の最大繰り返し試行回数
      */
     class Constants {
         public:
@@ -28,6 +31,8 @@ namespace numerical_analysis {
             static constexpr double         h               = 0.1;
             static constexpr double         epsilon         = 10e-6;
             static constexpr std::size_t    max_attempts    = 10;
+            static constexpr std::size_t    bisection_max_attempts = std::numeric_limits<double>::max_exponent - std::numeric_limits<double>::min_exponent + std::numeric_limits<double>::digits;
+            static constexpr std::size_t    brent_max_attempts     = 100;
     };
 }
 #endif // constants
\ No newline at end of file
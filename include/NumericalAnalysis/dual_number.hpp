@@ -0,0 +1,132 @@
+#ifndef dual_number
+#define dual_number
+#include <cmath>
+#include <compare>
+#include <ostream>
+namespace numerical_analysis {
+    /*
+     * Dual クラス
+     *
+     * 前進モード自動微分のための二重数 a + bε (ε^2 = 0) を表す。
+     * value()は関数値、derivative()は微分値に対応し、二重数で関数を評価すると
+     * 関数値と微分値が丸め誤差の範囲で厳密に同時に得られる。
+     *
+     * const auto f = [](const auto& x){ return cos(x) * x - 1.7; };
+     * const auto y = f(Dual<double>::variable(2.0));
+     * y.value();       // f(2.0)
+     * y.derivative();  // f'(2.0)
+     *
+     * 四則演算、比較演算およびsin, cos, tan, atan, exp, log, log10, sqrt, pow, absが定義されている。
+     * 数学関数は実引数依存の名前探索で見つかるため、std::を付けずに呼び出すこと。
+     * 比較演算は関数値のみを比較する。
+     *
+     * Tからの暗黙の変換が可能であり、StaticMatrixBaseの要素型としても使用できる。
+     */
+    template <class T = double>
+    class Dual {
+        private:
+            T value_;
+            T derivative_;
+        public:
+            Dual(const T& value = T(), const T& derivative = T()) : value_(value), derivative_(derivative){}
+
+            // 独立変数x (dx/dx = 1) を表す二重数を返す
+            static Dual variable(const T& x) {
+                return Dual(x, T(1));
+            }
+
+            const T& value() const noexcept { return this->value_; }
+            const T& derivative() const noexcept { return this->derivative_; }
+
+            Dual& operator+=(const Dual& rhs) {
+                this->value_ += rhs.value_;
+                this->derivative_ += rhs.derivative_;
+                return (*this);
+            }
+            Dual& operator-=(const Dual& rhs) {
+                this->value_ -= rhs.value_;
+                this->derivative_ -= rhs.derivative_;
+                return (*this);
+            }
+            Dual& operator*=(const Dual& rhs) {
+                this->derivative_ = this->derivative_ * rhs.value_ + this->value_ * rhs.derivative_;
+                this->value_ *= rhs.value_;
+                return (*this);
+            }
+            Dual& operator/=(const Dual& rhs) {
+                this->derivative_ = (this->derivative_ * rhs.value_ - this->value_ * rhs.derivative_) / (rhs.value_ * rhs.value_);
+                this->value_ /= rhs.value_;
+                return (*this);
+            }
+
+            friend Dual operator+(const Dual& x) { return x; }
+            friend Dual operator-(const Dual& x) { return Dual(-x.value_, -x.derivative_); }
+            friend Dual operator+(Dual lhs, const Dual& rhs) { return lhs += rhs; }
+            friend Dual operator-(Dual lhs, const Dual& rhs) { return lhs -= rhs; }
+            friend Dual operator*(Dual lhs, const Dual& rhs) { return lhs *= rhs; }
+            friend Dual operator/(Dual lhs, const Dual& rhs) { return lhs /= rhs; }
+
+            friend bool operator==(const Dual& lhs, const Dual& rhs) { return lhs.value_ == rhs.value_; }
+            friend auto operator<=>(const Dual& lhs, const Dual& rhs) { return lhs.value_ <=> rhs.value_; }
+
+            friend Dual sin(const Dual& x) {
+                using std::sin, std::cos;
+                return Dual(sin(x.value_), cos(x.value_) * x.derivative_);
+            }
+            friend Dual cos(const Dual& x) {
+                using std::sin, std::cos;
+                return Dual(cos(x.value_), -sin(x.value_) * x.derivative_);
+            }
+            friend Dual tan(const Dual& x) {
+                using std::tan;
+                const T t = tan(x.value_);
+                return Dual(t, (T(1) + t * t) * x.derivative_);
+            }
+            friend Dual atan(const Dual& x) {
+                using std::atan;
+                return Dual(atan(x.value_), x.derivative_ / (T(1) + x.value_ * x.value_));
+            }
+            friend Dual exp(const Dual& x) {
+                using std::exp;
+                const T e = exp(x.value_);
+                return Dual(e, e * x.derivative_);
+            }
+            friend Dual log(const Dual& x) {
+                using std::log;
+                return Dual(log(x.value_), x.derivative_ / x.value_);
+            }
+            friend Dual log10(const Dual& x) {
+                using std::log, std::log10;
+                return Dual(log10(x.value_), x.derivative_ / (x.value_ * log(T(10))));
+            }
+            friend Dual sqrt(const Dual& x) {
+                using std::sqrt;
+                const T s = sqrt(x.value_);
+                return Dual(s, x.derivative_ / (T(2) * s));
+            }
+            friend Dual abs(const Dual& x) {
+                return x.value_ < T() ? -x : x;
+            }
+            // x^a (aは定数)
+            friend Dual pow(const Dual& x, const T& a) {
+                using std::pow;
+                return Dual(pow(x.value_, a), a * pow(x.value_, a - T(1)) * x.derivative_);
+            }
+            // a^x (aは定数)
+            friend Dual pow(const T& a, const Dual& x) {
+                using std::pow, std::log;
+                const T p = pow(a, x.value_);
+                return Dual(p, p * log(a) * x.derivative_);
+            }
+            friend Dual pow(const Dual& x, const Dual& y) {
+                using std::pow, std::log;
+                const T p = pow(x.value_, y.value_);
+                return Dual(p, p * (y.derivative_ * log(x.value_) + y.value_ * x.derivative_ / x.value_));
+            }
+
+            friend std::ostream& operator<<(std::ostream& out, const Dual& x) {
+                return out << x.value_ << " + " << x.derivative_ << "ε";
+            }
+    };
+}
+#endif // dual_number
@@ -0,0 +1,470 @@
+#ifndef fast_fourier_transform
+#define fast_fourier_transform
+#include <map>
+#include <array>
+#include <span>
+#include <cmath>
+#include <mutex>
+#include <memory>
+#include <vector>
+#include <complex>
+#include <cstddef>
+#include <cassert>
+#include <numbers>
+#include <algorithm>
+#include "./../LinearAlgebra/StaticMatrix/Vector/staticvector.hpp"
+namespace numerical_analysis {
+    using Complex = std::complex<double>;
+
+    namespace detail {
+        // 複素数の積 (std::complexの積はNaN・無限大の処理を含みベクトル化されないため展開する)
+        inline Complex complex_multiply(const Complex& a, const Complex& b) {
+            return {a.real() * b.real() - a.imag() * b.imag(), a.real() * b.imag() + a.imag() * b.real()};
+        }
+
+        // 作業領域 (スレッドごとに保持し、サイズが足りない場合のみ拡張する)
+        // slotは 0: Stockhamの作業領域, 1: 実数変換, 2: Bluesteinのアルゴリズム
+        inline std::span<Complex> fft_workspace(const std::size_t& size, const std::size_t& slot = 0) {
+            thread_local std::array<std::vector<Complex>, 3> buffers;
+            if(buffers[slot].size() < size) {
+                buffers[slot].resize(size);
+            }
+            return std::span<Complex>(buffers[slot].data(), size);
+        }
+    }
+
+    /*
+     * FFTPlan クラス
+     *
+     * 長さnの複素離散フーリエ変換 X_k = Σ x_j exp(-2πi jk / n) の計画。
+     * 構築時にnを基数4, 2, 3, 5, ...に分解し、各段の回転因子を計算しておく。
+     *
+     * - 変換はStockhamの自動整列アルゴリズムにより入力と作業領域の間で交互に書き込むため、
+     *   ビット反転の並べ替えが不要で、全ての段でメモリを連続的に参照する
+     * - 各段の最内ループは連続した要素についての同一のバタフライ演算であり、コンパイラによりSIMD化される
+     * - 大きな素因数(max_radixを超えるもの)を含む長さはBluesteinのアルゴリズムにより
+     *   2の冪の長さの変換に帰着する
+     *
+     * 同じ長さの変換を繰り返す場合はfft_plan(n)で共有の計画を取得すること。
+     */
+    class FFTPlan {
+        private:
+            struct Stage {
+                std::size_t radix;
+                std::size_t length;     // この段の部分変換の長さ
+                std::size_t stride;     // この段の部分変換の数
+                std::size_t twiddle;    // twiddles_内の開始位置
+                std::size_t root;       // roots_内の開始位置 (基数2, 4以外)
+            };
+
+            std::size_t n_;
+            std::vector<Stage> stages_;
+            std::vector<Complex> twiddles_;
+            // 一般の基数についての1の原始根の冪 (roots_[offset + k] = exp(-2πi k / radix))
+            std::vector<Complex> roots_;
+            // Bluesteinのアルゴリズムで使用する値
+            std::shared_ptr<const FFTPlan> convolution_;
+            std::vector<Complex> chirp_;
+            std::vector<Complex> chirp_spectrum_;
+
+            static std::vector<std::size_t> factorize(std::size_t n) {
+                std::vector<std::size_t> factors;
+                while(n % 4 == 0) { factors.push_back(4); n /= 4; }
+                while(n % 2 == 0) { factors.push_back(2); n /= 2; }
+                for(std::size_t p = 3; p * p <= n; p += 2) {
+                    while(n % p == 0) { factors.push_back(p); n /= p; }
+                }
+                if(n > 1) {
+                    factors.push_back(n);
+                }
+                return factors;
+            }
+
+            // 1段分のバタフライ演算 (x -> y)
+            void butterfly(const Stage& stage, const Complex* x, Complex* y) const {
+                const std::size_t p = stage.radix;
+                const std::size_t m = stage.length / p;
+                const std::size_t s = stage.stride;
+                const Complex* w = this->twiddles_.data() + stage.twiddle;
+
+                if(p == 2) {
+                    for(std::size_t j = 0; j < m; ++j) {
+                        const Complex w1 = w[j];
+                        for(std::size_t q = 0; q < s; ++q) {
+                            const Complex a = x[q + s * j];
+                            const Complex b = x[q + s * (j + m)];
+                            y[q + s * (2 * j)]     = a + b;
+                            y[q + s * (2 * j + 1)] = detail::complex_multiply(a - b, w1);
+                        }
+                    }
+                } else if(p == 4) {
+                    for(std::size_t j = 0; j < m; ++j) {
+                        const Complex w1 = w[3 * j], w2 = w[3 * j + 1], w3 = w[3 * j + 2];
+                        for(std::size_t q = 0; q < s; ++q) {
+                            const Complex a0 = x[q + s * j];
+                            const Complex a1 = x[q + s * (j + m)];
+                            const Complex a2 = x[q + s * (j + 2 * m)];
+                            const Complex a3 = x[q + s * (j + 3 * m)];
+                            const Complex t0 = a0 + a2, t1 = a0 - a2;
+                            const Complex t2 = a1 + a3;
+                            // -i(a1 - a3)
+                            const Complex t3 = {a1.imag() - a3.imag(), a3.real() - a1.real()};
+                            y[q + s * (4 * j)]     = t0 + t2;
+                            y[q + s * (4 * j + 1)] = detail::complex_multiply(t1 + t3, w1);
+                            y[q + s * (4 * j + 2)] = detail::complex_multiply(t0 - t2, w2);
+                            y[q + s * (4 * j + 3)] = detail::complex_multiply(t1 - t3, w3);
+                        }
+                    }
+                } else {
+                    const Complex* roots = this->roots_.data() + stage.root;
+                    for(std::size_t j = 0; j < m; ++j) {
+                        for(std::size_t q = 0; q < s; ++q) {
+                            for(std::size_t t = 0; t < p; ++t) {
+                                Complex sum = 0;
+                                for(std::size_t r = 0; r < p; ++r) {
+                                    sum += detail::complex_multiply(x[q + s * (j + r * m)], roots[(r * t) % p]);
+                                }
+                                y[q + s * (p * j + t)] = t == 0 ? sum : detail::complex_multiply(sum, w[(p - 1) * j + t - 1]);
+                            }
+                        }
+                    }
+                }
+            }
+
+            // 順変換の本体。結果はdataに書き込まれる
+            void transform(std::span<Complex> data, std::span<Complex> work) const {
+                Complex* x = data.data();
+                Complex* y = work.data();
+                for(const auto& stage : this->stages_) {
+                    this->butterfly(stage, x, y);
+                    std::swap(x, y);
+                }
+                if(x != data.data()) {
+                    std::copy(x, x + this->n_, data.data());
+                }
+            }
+
+            void bluestein(std::span<Complex> data) const {
+                const std::size_t n = this->n_;
+                const std::size_t m = this->convolution_->size();
+                auto buffer = detail::fft_workspace(m, 2);
+                for(std::size_t k = 0; k < m; ++k) {
+                    buffer[k] = k < n ? detail::complex_multiply(data[k], this->chirp_[k]) : Complex(0);
+                }
+                this->convolution_->forward(buffer);
+                for(std::size_t k = 0; k < m; ++k) {
+                    buffer[k] = detail::complex_multiply(buffer[k], this->chirp_spectrum_[k]);
+                }
+                this->convolution_->inverse(buffer);
+                for(std::size_t k = 0; k < n; ++k) {
+                    data[k] = detail::complex_multiply(buffer[k], this->chirp_[k]);
+                }
+            }
+        public:
+            // これより大きな素因数を含む長さはBluesteinのアルゴリズムを使用する
+            static constexpr std::size_t max_radix = 31;
+
+            explicit FFTPlan(const std::size_t& n) : n_(n) {
+                assert(n > 0);
+                const auto factors = factorize(n);
+                if(!factors.empty() && factors.back() > max_radix) {
+                    // 長さ2n - 1以上の2の冪の巡回畳み込みに帰着する
+                    std::size_t m = 1;
+                    while(m < 2 * n - 1) {
+                        m *= 2;
+                    }
+                    this->convolution_ = std::make_shared<const FFTPlan>(m);
+                    this->chirp_.resize(n);
+                    for(std::size_t k = 0; k < n; ++k) {
+                        // k^2 mod 2nで位相を計算し、大きなkでの精度低下を防ぐ
+                        const double phase = std::numbers::pi * static_cast<double>((k * k) % (2 * n)) / static_cast<double>(n);
+                        this->chirp_[k] = {std::cos(phase), -std::sin(phase)};
+                    }
+                    this->chirp_spectrum_.assign(m, Complex(0));
+                    for(std::size_t k = 0; k < n; ++k) {
+                        this->chirp_spectrum_[k] = std::conj(this->chirp_[k]);
+                        if(k != 0) {
+                            this->chirp_spectrum_[m - k] = std::conj(this->chirp_[k]);
+                        }
+                    }
+                    this->convolution_->forward(this->chirp_spectrum_);
+                    return;
+                }
+
+                std::size_t length = n;
+                std::size_t stride = 1;
+                for(const std::size_t p : factors) {
+                    this->stages_.push_back({p, length, stride, this->twiddles_.size(), this->roots_.size()});
+                    // 一般の基数は同じ基数の段でも1の冪根を別に持つ (因数は高々log2(n)個)
+                    if(p != 2 && p != 4) {
+                        for(std::size_t k = 0; k < p; ++k) {
+                            const double phase = -2 * std::numbers::pi * static_cast<double>(k) / static_cast<double>(p);
+                            this->roots_.push_back({std::cos(phase), std::sin(phase)});
+                        }
+                    }
+                    const std::size_t m = length / p;
+                    for(std::size_t j = 0; j < m; ++j) {
+                        for(std::size_t t = 1; t < p; ++t) {
+                            const double phase = -2 * std::numbers::pi * static_cast<double>(j * t) / static_cast<double>(length);
+                            this->twiddles_.push_back({std::cos(phase), std::sin(phase)});
+                        }
+                    }
+                    length = m;
+                    stride *= p;
+                }
+            }
+
+            std::size_t size() const noexcept { return this->n_; }
+
+            // dataを順変換する (正規化しない)
+            void forward(std::span<Complex> data) const {
+                assert(data.size() == this->n_);
+                if(this->convolution_) {
+                    this->bluestein(data);
+                } else {
+                    this->transform(data, detail::fft_workspace(this->n_));
+                }
+            }
+
+            // dataを逆変換する (1 / nで正規化する)
+            void inverse(std::span<Complex> data) const {
+                assert(data.size() == this->n_);
+                for(auto& x : data) {
+                    x = std::conj(x);
+                }
+                this->forward(data);
+                const double scale = 1 / static_cast<double>(this->n_);
+                for(auto& x : data) {
+                    x = std::conj(x) * scale;
+                }
+            }
+    };
+
+    /*
+     * RealFFTPlan クラス
+     *
+     * 長さnの実数列の離散フーリエ変換の計画。結果は共役対称性により前半のn / 2 + 1個のみを扱う。
+     * nが偶数の場合は実数列を長さn / 2の複素数列とみなして変換し、後処理で分離するため、
+     * 複素変換の約半分の計算量である。
+     */
+    class RealFFTPlan {
+        private:
+            std::size_t n_;
+            std::shared_ptr<const FFTPlan> plan_;
+            // exp(-2πi k / n) (k < n / 2)
+            std::vector<Complex> twiddles_;
+        public:
+            explicit RealFFTPlan(const std::size_t& n);
+
+            std::size_t size() const noexcept { return this->n_; }
+
+            // 実数列inを変換し、outにn / 2 + 1個の係数を書き込む (正規化しない)
+            void forward(std::span<const double> in, std::span<Complex> out) const {
+                const std::size_t n = this->n_;
+                assert(in.size() == n && out.size() == n / 2 + 1);
+                if(n % 2 != 0) {
+                    auto buffer = detail::fft_workspace(n, 1);
+                    std::copy(in.begin(), in.end(), buffer.begin());
+                    this->plan_->forward(buffer);
+                    std::copy(buffer.begin(), buffer.begin() + static_cast<std::ptrdiff_t>(out.size()), out.begin());
+                    return;
+                }
+                const std::size_t h = n / 2;
+                auto z = detail::fft_workspace(h, 1);
+                for(std::size_t k = 0; k < h; ++k) {
+                    z[k] = {in[2 * k], in[2 * k + 1]};
+                }
+                this->plan_->forward(z);
+                out[0] = z[0].real() + z[0].imag();
+                out[h] = z[0].real() - z[0].imag();
+                for(std::size_t k = 1; k < h; ++k) {
+                    const Complex a = z[k];
+                    const Complex b = std::conj(z[h - k]);
+                    const Complex even = (a + b) * 0.5;
+                    // -i(a - b) / 2
+                    const Complex odd = {(a.imag() - b.imag()) * 0.5, (b.real() - a.real()) * 0.5};
+                    out[k] = even + detail::complex_multiply(odd, this->twiddles_[k]);
+                }
+            }
+
+            // n / 2 + 1個の係数inを逆変換し、outに実数列を書き込む (1 / nで正規化する)
+            void inverse(std::span<const Complex> in, std::span<double> out) const {
+                const std::size_t n = this->n_;
+                assert(in.size() == n / 2 + 1 && out.size() == n);
+                if(n % 2 != 0) {
+                    auto buffer = detail::fft_workspace(n, 1);
+                    for(std::size_t k = 0; k < n; ++k) {
+                        buffer[k] = k < in.size() ? in[k] : std::conj(in[n - k]);
+                    }
+                    this->plan_->inverse(buffer);
+                    for(std::size_t k = 0; k < n; ++k) {
+                        out[k] = buffer[k].real();
+                    }
+                    return;
+                }
+                const std::size_t h = n / 2;
+                auto z = detail::fft_workspace(h, 1);
+                for(std::size_t k = 0; k < h; ++k) {
+                    const Complex a = in[k];
+                    const Complex b = std::conj(in[h - k]);
+                    const Complex even = a + b;
+                    const Complex odd = detail::complex_multiply(a - b, std::conj(this->twiddles_[k]));
+                    // even + i odd
+                    z[k] = {(even.real() - odd.imag()) * 0.5, (even.imag() + odd.real()) * 0.5};
+                }
+                this->plan_->inverse(z);
+                for(std::size_t k = 0; k < h; ++k) {
+                    out[2 * k]     = z[k].real();
+                    out[2 * k + 1] = z[k].imag();
+                }
+            }
+    };
+
+    namespace detail {
+        // 長さごとの計画のキャッシュ。計画の構築はロックの外で行う
+        template <class Plan>
+        std::shared_ptr<const Plan> cached_plan(const std::size_t& n) {
+            static std::mutex mutex;
+            static std::map<std::size_t, std::shared_ptr<const Plan>> plans;
+            {
+                const std::lock_guard<std::mutex> lock(mutex);
+                const auto found = plans.find(n);
+                if(found != plans.end()) {
+                    return found->second;
+                }
+            }
+            auto plan = std::make_shared<const Plan>(n);
+            const std::lock_guard<std::mutex> lock(mutex);
+            return plans.try_emplace(n, std::move(plan)).first->second;
+        }
+    }
+
+    /*
+     * 長さnの複素・実数FFTの計画を返す
+     * 計画は長さごとに1度だけ構築され、以降の呼び出しでは同じ計画が共有される。計画は複数のスレッドから同時に使用できる。
+     */
+    inline std::shared_ptr<const FFTPlan> fft_plan(const std::size_t& n) {
+        return detail::cached_plan<FFTPlan>(n);
+    }
+    inline std::shared_ptr<const RealFFTPlan> real_fft_plan(const std::size_t& n) {
+        return detail::cached_plan<RealFFTPlan>(n);
+    }
+
+    inline RealFFTPlan::RealFFTPlan(const std::size_t& n) : n_(n), plan_(fft_plan(n % 2 == 0 ? n / 2 : n)) {
+        assert(n > 0);
+        if(n % 2 == 0) {
+            this->twiddles_.resize(n / 2);
+            for(std::size_t k = 0; k < n / 2; ++k) {
+                const double phase = -2 * std::numbers::pi * static_cast<double>(k) / static_cast<double>(n);
+                this->twiddles_[k] = {std::cos(phase), std::sin(phase)};
+            }
+        }
+    }
+
+    /*
+     * 離散フーリエ変換
+     *
+     * fft(data)        : 複素数列の順変換 (正規化しない)
+     * ifft(data)       : 複素数列の逆変換 (1 / nで正規化する)
+     * rfft(in, out)    : 実数列の順変換 (outはn / 2 + 1個)
+     * irfft(in, out)   : rfftの逆変換 (outはn個、1 / nで正規化する)
+     *
+     * 連続したバッファ(std::span)とStaticRowVectorのいずれも受け付ける。計画はfft_planのキャッシュから取得する。
+     */
+    inline void fft(std::span<Complex> data) {
+        if(!data.empty()) {
+            fft_plan(data.size())->forward(data);
+        }
+    }
+    inline void ifft(std::span<Complex> data) {
+        if(!data.empty()) {
+            fft_plan(data.size())->inverse(data);
+        }
+    }
+    inline void rfft(std::span<const double> in, std::span<Complex> out) {
+        if(!in.empty()) {
+            real_fft_plan(in.size())->forward(in, out);
+        }
+    }
+    inline void irfft(std::span<const Complex> in, std::span<double> out) {
+        if(!out.empty()) {
+            real_fft_plan(out.size())->inverse(in, out);
+        }
+    }
+
+    template <std::size_t N>
+    klibrary::linear_algebra::StaticRowVector<Complex, N> fft(const klibrary::linear_algebra::StaticRowVector<Complex, N>& x) {
+        auto result = x;
+        fft(std::span<Complex>(&result[0], N));
+        return result;
+    }
+    template <std::size_t N>
+    klibrary::linear_algebra::StaticRowVector<Complex, N> ifft(const klibrary::linear_algebra::StaticRowVector<Complex, N>& x) {
+        auto result = x;
+        ifft(std::span<Complex>(&result[0], N));
+        return result;
+    }
+    template <std::size_t N>
+    klibrary::linear_algebra::StaticRowVector<Complex, N / 2 + 1> rfft(const klibrary::linear_algebra::StaticRowVector<double, N>& x) {
+        klibrary::linear_algebra::StaticRowVector<Complex, N / 2 + 1> result;
+        rfft(std::span<const double>(&x[0], N), std::span<Complex>(&result[0], N / 2 + 1));
+        return result;
+    }
+    // irfft<N>(x) : 長さNの実数列に戻す
+    template <std::size_t N>
+    klibrary::linear_algebra::StaticRowVector<double, N> irfft(const klibrary::linear_algebra::StaticRowVector<Complex, N / 2 + 1>& x) {
+        klibrary::linear_algebra::StaticRowVector<double, N> result;
+        irfft(std::span<const Complex>(&x[0], N / 2 + 1), std::span<double>(&result[0], N));
+        return result;
+    }
+
+    /*
+     * 周期periodの周期関数を等間隔に標本化したsamplesから、スペクトル法により各標本点での微分値を求め、outに書き込む
+     * 標本数が偶数の場合、Nyquist周波数の成分は0として扱う。
+     */
+    inline void spectral_derivative(std::span<const double> samples, const double& period, std::span<double> out) {
+        const std::size_t n = samples.size();
+        assert(out.size() == n);
+        if(n == 0) {
+            return;
+        }
+        std::vector<Complex> spectrum(n / 2 + 1);
+        rfft(samples, spectrum);
+        const double scale = 2 * std::numbers::pi / period;
+        for(std::size_t k = 0; k < spectrum.size(); ++k) {
+            const double frequency = (n % 2 == 0 && k == n / 2) ? 0 : scale * static_cast<double>(k);
+            spectrum[k] = Complex(-spectrum[k].imag() * frequency, spectrum[k].real() * frequency);
+        }
+        irfft(spectrum, out);
+    }
+
+    /*
+     * 実数列aとbの線形畳み込みをFFTにより求め、outに書き込む (outはa.size() + b.size() - 1個)
+     * 変換長はa.size() + b.size() - 1以上の2の冪である。
+     */
+    inline void convolve(std::span<const double> a, std::span<const double> b, std::span<double> out) {
+        if(a.empty() || b.empty()) {
+            return;
+        }
+        const std::size_t size = a.size() + b.size() - 1;
+        assert(out.size() == size);
+        std::size_t n = 1;
+        while(n < size) {
+            n *= 2;
+        }
+        std::vector<double> padded(n, 0.0);
+        std::vector<Complex> fa(n / 2 + 1);
+        std::vector<Complex> fb(n / 2 + 1);
+        std::copy(a.begin(), a.end(), padded.begin());
+        rfft(padded, fa);
+        std::fill(padded.begin(), padded.end(), 0.0);
+        std::copy(b.begin(), b.end(), padded.begin());
+        rfft(padded, fb);
+        for(std::size_t k = 0; k < fa.size(); ++k) {
+            fa[k] = detail::complex_multiply(fa[k], fb[k]);
+        }
+        irfft(fa, padded);
+        std::copy(padded.begin(), padded.begin() + static_cast<std::ptrdiff_t>(size), out.begin());
+    }
+}
+#endif // fast_fourier_transform
@@ -0,0 +1,194 @@
+#ifndef function_adapter
+#define function_adapter
+#include <bit>
+#include <span>
+#include <array>
+#include <memory>
+#include <vector>
+#include <cmath>
+#include <cstdint>
+#include <cstddef>
+#include <cassert>
+#include <algorithm>
+#include <limits>
+namespace numerical_analysis {
+    /*
+     * MemoizedFunction クラス
+     *
+     * f(x)の評価結果をxのビット表現をキーとして記憶し、同じxについての2回目以降の呼び出しでは
+     * f(x)を評価せずに記憶した値を返す。f(x)の評価が高コストな場合に使用する。
+     *
+     * 記憶領域はCapacity個(2の冪)のスロットを持つ開番地法のハッシュ表であり、
+     * キーと値を隣接して格納する。探索はprobe_limit個の連続したスロットに限られ、
+     * 空きがない場合は最初のスロットを上書きするため、記憶領域が確保されるのは構築時の1度のみである。
+     *
+     * double(double)として呼び出せるため、Derivative、newton_raphson、bisection_method、brent_method等の
+     * 全ての関数にそのまま渡すことができる。コピーは記憶領域を共有するため、std::functionに
+     * 変換して渡した場合も元のオブジェクトと同じ記憶領域が使用される。
+     * 記憶領域の更新は同期されないため、複数のスレッドから同時に呼び出してはならない。
+     *
+     * const auto memo = MemoizedFunction(f);
+     * const auto d = Derivative(memo);
+     * newton_raphson(1.0, memo, [&](double x){ return d.with_respect_to(x); });
+     */
+    template <class F, std::size_t Capacity = 1024>
+    class MemoizedFunction {
+        private:
+            static_assert(std::has_single_bit(Capacity));
+            static constexpr std::size_t    probe_limit = 4;
+            // 空きスロットを表すキー (通常の計算では現れないNaNのビット表現)
+            static constexpr std::uint64_t  empty_key   = 0x7FF4'DEAD'BEEF'0000;
+
+            struct Slot {
+                std::uint64_t   key;
+                double          value;
+            };
+            struct Table {
+                std::array<Slot, Capacity>  slots;
+                std::size_t                 hits    = 0;
+                std::size_t                 misses  = 0;
+            };
+
+            F f_;
+            std::shared_ptr<Table> table_;
+
+            static std::size_t home(const std::uint64_t& key) noexcept {
+                constexpr int shift = 64 - std::countr_zero(Capacity);
+                return shift == 64 ? 0 : static_cast<std::size_t>((key * 0x9E37'79B9'7F4A'7C15) >> shift);
+            }
+        public:
+            explicit MemoizedFunction(const F& f) : f_(f), table_(std::make_shared<Table>()) {
+                this->clear();
+            }
+
+            double operator()(const double& x) const {
+                const auto key = std::bit_cast<std::uint64_t>(x);
+                if(key == empty_key) {
+                    return this->f_(x);
+                }
+                auto& slots = this->table_->slots;
+                const std::size_t first = home(key);
+                std::size_t target = first;
+                for(std::size_t p = 0; p < probe_limit; ++p) {
+                    const std::size_t i = (first + p) & (Capacity - 1);
+                    if(slots[i].key == key) {
+                        ++this->table_->hits;
+                        return slots[i].value;
+                    }
+                    if(slots[i].key == empty_key) {
+                        target = i;
+                        break;
+                    }
+                }
+                ++this->table_->misses;
+                const double value = this->f_(x);
+                slots[target] = {key, value};
+                return value;
+            }
+
+            // 記憶した値を全て破棄する
+            void clear() const {
+                for(auto& slot : this->table_->slots) {
+                    slot.key = empty_key;
+                }
+                this->table_->hits   = 0;
+                this->table_->misses = 0;
+            }
+
+            // 記憶した値を返した回数
+            std::size_t hits() const noexcept { return this->table_->hits; }
+            // f(x)を評価した回数
+            std::size_t misses() const noexcept { return this->table_->misses; }
+    };
+
+    /*
+     * TabulatedFunction クラス
+     *
+     * [a, b]をintervals個の等間隔の区間に分割し、各区間上でf(x)を3次Hermite多項式で近似する表を構築する。
+     * 構築時にf(x)をintervals + 1回評価し、以降の評価ではf(x)を呼び出さない。
+     *
+     * 各格子点の微分値は格子点上の値から4次精度の差分で求めるため、f(x)が十分滑らかであれば
+     * 近似誤差はO(dx^4)で、近似は1回連続微分可能である。
+     * 評価は区間の添字の計算と3次多項式のHorner法のみで行うため、区間数によらずO(1)である。
+     * 範囲外のxについては端の区間の多項式で外挿する。
+     *
+     * double(double)として呼び出せるため、全ての関数にそのまま渡すことができる。
+     * 構築後は変更されないため、複数のスレッドから同時に呼び出すことができる。
+     *
+     * 引数
+     * - f          : f(x)
+     * - a          : 表の範囲の下端
+     * - b          : 表の範囲の上端
+     * - intervals  : 区間の数 (4以上)
+     */
+    class TabulatedFunction {
+        private:
+            double a_;
+            double b_;
+            double inverse_dx_;
+            // 各区間についての t = (x - x_i) / dx の3次多項式の係数 (定数項から順)
+            std::vector<std::array<double, 4>> coefficients_;
+        public:
+            template <class F>
+            TabulatedFunction(const F& f, const double& a, const double& b, const std::size_t& intervals = 256)
+                : a_(a), b_(b), inverse_dx_(static_cast<double>(intervals) / (b - a)), coefficients_(intervals) {
+                assert(a < b && intervals >= 4);
+                const std::size_t n = intervals;
+                const double dx = (b - a) / static_cast<double>(n);
+                std::vector<double> values(n + 1);
+                for(std::size_t i = 0; i <= n; ++i) {
+                    values[i] = f(i == n ? b : a + static_cast<double>(i) * dx);
+                }
+
+                // 格子点での微分値 * dx (端点付近は片側差分)
+                std::vector<double> slopes(n + 1);
+                const auto& v = values;
+                slopes[0]     = (-25 * v[0] + 48 * v[1] - 36 * v[2] + 16 * v[3] - 3 * v[4]) / 12;
+                slopes[1]     = (-3 * v[0] - 10 * v[1] + 18 * v[2] - 6 * v[3] + v[4]) / 12;
+                slopes[n - 1] = (3 * v[n] + 10 * v[n - 1] - 18 * v[n - 2] + 6 * v[n - 3] - v[n - 4]) / 12;
+                slopes[n]     = (25 * v[n] - 48 * v[n - 1] + 36 * v[n - 2] - 16 * v[n - 3] + 3 * v[n - 4]) / 12;
+                for(std::size_t i = 2; i + 1 < n; ++i) {
+                    slopes[i] = (v[i - 2] - 8 * v[i - 1] + 8 * v[i + 1] - v[i + 2]) / 12;
+                }
+
+                for(std::size_t i = 0; i < n; ++i) {
+                    const double p0 = v[i], p1 = v[i + 1];
+                    const double m0 = slopes[i], m1 = slopes[i + 1];
+                    this->coefficients_[i] = {p0, m0, 3 * (p1 - p0) - 2 * m0 - m1, 2 * (p0 - p1) + m0 + m1};
+                }
+            }
+
+            double operator()(const double& x) const {
+                // NaNは区間の添え字に変換できないため、そのまま返す
+                if(std::isnan(x)) {
+                    return std::numeric_limits<double>::quiet_NaN();
+                }
+                const double s = (x - this->a_) * this->inverse_dx_;
+                const double last = static_cast<double>(this->coefficients_.size() - 1);
+                const double cell = std::clamp(std::floor(s), 0.0, last);
+                const auto& c = this->coefficients_[static_cast<std::size_t>(cell)];
+                const double t = s - cell;
+                return c[0] + t * (c[1] + t * (c[2] + t * c[3]));
+            }
+
+            // xs[i]における近似値をout[i]に書き込む。分岐を含まないため、コンパイラによりSIMD化される
+            void operator()(std::span<const double> xs, std::span<double> out) const {
+                assert(xs.size() == out.size());
+                const double last = static_cast<double>(this->coefficients_.size() - 1);
+                const auto* coefficients = this->coefficients_.data();
+                for(std::size_t i = 0; i < xs.size(); ++i) {
+                    const double s = (xs[i] - this->a_) * this->inverse_dx_;
+                    // NaNは先頭の区間で評価し、tを通してNaNを返す
+                    const double cell = std::isnan(s) ? 0.0 : std::clamp(std::floor(s), 0.0, last);
+                    const auto& c = coefficients[static_cast<std::size_t>(cell)];
+                    const double t = s - cell;
+                    out[i] = c[0] + t * (c[1] + t * (c[2] + t * c[3]));
+                }
+            }
+
+            const double& lower() const noexcept { return this->a_; }
+            const double& upper() const noexcept { return this->b_; }
+            std::size_t intervals() const noexcept { return this->coefficients_.size(); }
+    };
+}
+#endif // function_adapter
@@ -0,0 +1,496 @@
+#ifndef iterative_solvers
+#define iterative_solvers
+#include <span>
+#include <cmath>
+#include <vector>
+#include <cstddef>
+#include <cassert>
+#include <concepts>
+#include <algorithm>
+#include "solver_status.hpp"
+#include "./../LinearAlgebra/StaticMatrix/Base/staticmatrix_base.hpp"
+#include "./../LinearAlgebra/StaticMatrix/Dispatch/staticmatrix_dispatch.hpp"
+namespace numerical_analysis {
+    /*
+     * LinearOperator コンセプト
+     *
+     * n x n の線形作用素 y = A x を表す。行列を陽に保持する必要はなく、
+     * size()で次元を、apply(x, y)で作用の結果をyに書き込む型であればよい。
+     * 前処理(M^-1 r)も同じコンセプトで表す。
+     */
+    template <class Operator>
+    concept LinearOperator = requires(const Operator& a, std::span<const double> x, std::span<double> y) {
+        { a.size() } -> std::convertible_to<std::size_t>;
+        a.apply(x, y);
+    };
+
+    // 対角成分を取り出せる線形作用素 (Jacobi前処理に使用する)
+    template <class Operator>
+    concept DiagonalAccessible = LinearOperator<Operator> && requires(const Operator& a) {
+        { a.diagonal() } -> std::convertible_to<std::vector<double>>;
+    };
+
+    /*
+     * DenseOperator クラス
+     *
+     * StaticMatrixBase<double, N, N>を線形作用素として参照する (行列はコピーしない)。
+     */
+    template <std::size_t N>
+    class DenseOperator {
+        private:
+            const klibrary::linear_algebra::StaticMatrixBase<double, N, N>& matrix_;
+        public:
+            explicit DenseOperator(const klibrary::linear_algebra::StaticMatrixBase<double, N, N>& matrix) : matrix_(matrix){}
+
+            std::size_t size() const noexcept { return N; }
+            void apply(std::span<const double> x, std::span<double> y) const {
+                for(std::size_t r = 0; r < N; ++r) {
+                    double sum = 0;
+                    for(std::size_t c = 0; c < N; ++c) {
+                        sum += this->matrix_(r, c) * x[c];
+                    }
+                    y[r] = sum;
+                }
+            }
+            std::vector<double> diagonal() const {
+                std::vector<double> result(N);
+                for(std::size_t i = 0; i < N; ++i) {
+                    result[i] = this->matrix_(i, i);
+                }
+                return result;
+            }
+    };
+
+    /*
+     * CsrMatrix 構造体
+     *
+     * 圧縮行格納(CSR)形式の n x n 疎行列。i行目の非零要素は
+     * columns[row_offsets[i]], ..., columns[row_offsets[i + 1] - 1] 列にあり、各行の列番号は昇順である。
+     */
+    struct CsrMatrix {
+        std::size_t                 n;
+        std::vector<std::size_t>    row_offsets;
+        std::vector<std::size_t>    columns;
+        std::vector<double>         values;
+
+        std::size_t size() const noexcept { return this->n; }
+        void apply(std::span<const double> x, std::span<double> y) const {
+            for(std::size_t r = 0; r < this->n; ++r) {
+                double sum = 0;
+                for(std::size_t k = this->row_offsets[r]; k < this->row_offsets[r + 1]; ++k) {
+                    sum += this->values[k] * x[this->columns[k]];
+                }
+                y[r] = sum;
+            }
+        }
+        std::vector<double> diagonal() const {
+            std::vector<double> result(this->n, 0.0);
+            for(std::size_t r = 0; r < this->n; ++r) {
+                for(std::size_t k = this->row_offsets[r]; k < this->row_offsets[r + 1]; ++k) {
+                    if(this->columns[k] == r) {
+                        result[r] = this->values[k];
+                    }
+                }
+            }
+            return result;
+        }
+    };
+
+    /*
+     * FunctionOperator クラス
+     *
+     * f(x, y)でy = A xを計算する関数を線形作用素として扱う。
+     *
+     * const auto a = FunctionOperator(n, [](std::span<const double> x, std::span<double> y) { ... });
+     */
+    template <class F>
+    class FunctionOperator {
+        private:
+            std::size_t n_;
+            F f_;
+        public:
+            FunctionOperator(const std::size_t& n, const F& f) : n_(n), f_(f){}
+
+            std::size_t size() const noexcept { return this->n_; }
+            void apply(std::span<const double> x, std::span<double> y) const {
+                this->f_(x, y);
+            }
+    };
+
+    // 前処理なし (M = I)
+    class IdentityPreconditioner {
+        private:
+            std::size_t n_;
+        public:
+            explicit IdentityPreconditioner(const std::size_t& n) : n_(n){}
+
+            std::size_t size() const noexcept { return this->n_; }
+            void apply(std::span<const double> r, std::span<double> z) const {
+                std::copy(r.begin(), r.end(), z.begin());
+            }
+    };
+
+    // Jacobi前処理 (M = diag(A))。対角成分が0の行は前処理しない
+    class JacobiPreconditioner {
+        private:
+            std::vector<double> inverse_diagonal_;
+        public:
+            template <DiagonalAccessible Operator>
+            explicit JacobiPreconditioner(const Operator& a) : inverse_diagonal_(a.diagonal()) {
+                for(auto& d : this->inverse_diagonal_) {
+                    d = d == 0 ? 1 : 1 / d;
+                }
+            }
+
+            std::size_t size() const noexcept { return this->inverse_diagonal_.size(); }
+            void apply(std::span<const double> r, std::span<double> z) const {
+                for(std::size_t i = 0; i < r.size(); ++i) {
+                    z[i] = this->inverse_diagonal_[i] * r[i];
+                }
+            }
+    };
+
+    /*
+     * IncompleteCholeskyPreconditioner クラス
+     *
+     * 対称正定値なCSR行列の不完全Cholesky分解 IC(0) (A ≈ L L^T、LはAの下三角部分と同じ非零構造) による前処理。
+     * 分解の途中で対角成分が正でなくなった場合は、その行の対角成分を元の行列の対角成分で置き換えて続行する。
+     */
+    class IncompleteCholeskyPreconditioner {
+        private:
+            // Lの下三角部分 (対角成分は各行の最後)
+            CsrMatrix lower_;
+        public:
+            explicit IncompleteCholeskyPreconditioner(const CsrMatrix& a) {
+                const std::size_t n = a.n;
+                auto& l = this->lower_;
+                l.n = n;
+                l.row_offsets.assign(1, 0);
+                for(std::size_t r = 0; r < n; ++r) {
+                    for(std::size_t k = a.row_offsets[r]; k < a.row_offsets[r + 1] && a.columns[k] <= r; ++k) {
+                        l.columns.push_back(a.columns[k]);
+                        l.values.push_back(a.values[k]);
+                    }
+                    if(l.columns.size() == l.row_offsets.back() || l.columns.back() != r) {
+                        // 対角成分が格納されていない行
+                        l.columns.push_back(r);
+                        l.values.push_back(0);
+                    }
+                    l.row_offsets.push_back(l.columns.size());
+                }
+
+                for(std::size_t i = 0; i < n; ++i) {
+                    const std::size_t begin = l.row_offsets[i];
+                    const std::size_t diagonal = l.row_offsets[i + 1] - 1;
+                    for(std::size_t p = begin; p <= diagonal; ++p) {
+                        const std::size_t k = l.columns[p];
+                        // Σ_{j < k} L_ij L_kj (両行の列番号の昇順の併合)
+                        double sum = 0;
+                        std::size_t q = begin, s = l.row_offsets[k];
+                        while(q < p && s < l.row_offsets[k + 1] - 1) {
+                            if(l.columns[q] == l.columns[s]) {
+                                sum += l.values[q++] * l.values[s++];
+                            } else if(l.columns[q] < l.columns[s]) {
+                                ++q;
+                            } else {
+                                ++s;
+                            }
+                        }
+                        if(p == diagonal) {
+                            const double pivot = l.values[p] - sum;
+                            l.values[p] = std::sqrt(pivot > 0 ? pivot : std::abs(l.values[p]) + (l.values[p] == 0));
+                        } else {
+                            l.values[p] = (l.values[p] - sum) / l.values[l.row_offsets[k + 1] - 1];
+                        }
+                    }
+                }
+            }
+
+            std::size_t size() const noexcept { return this->lower_.n; }
+            // L L^T z = r を前進・後退代入で解く
+            void apply(std::span<const double> r, std::span<double> z) const {
+                const auto& l = this->lower_;
+                for(std::size_t i = 0; i < l.n; ++i) {
+                    double sum = r[i];
+                    const std::size_t diagonal = l.row_offsets[i + 1] - 1;
+                    for(std::size_t k = l.row_offsets[i]; k < diagonal; ++k) {
+                        sum -= l.values[k] * z[l.columns[k]];
+                    }
+                    z[i] = sum / l.values[diagonal];
+                }
+                for(std::size_t i = l.n; i-- > 0;) {
+                    const std::size_t diagonal = l.row_offsets[i + 1] - 1;
+                    z[i] /= l.values[diagonal];
+                    for(std::size_t k = l.row_offsets[i]; k < diagonal; ++k) {
+                        z[l.columns[k]] -= l.values[k] * z[i];
+                    }
+                }
+            }
+    };
+
+    /*
+     * 反復解法の設定
+     *
+     * - tolerance      : 収束判定条件 (相対残差 |b - Ax| / |b|)
+     * - max_iterations : 最大反復回数 (GMRESでは再始動を含む全体の反復回数)
+     * - restart        : GMRESの再始動までの反復回数 (Krylov部分空間の次元)
+     */
+    struct IterativeSolverOptions {
+        double          tolerance       = 1e-10;
+        std::size_t     max_iterations  = 1000;
+        std::size_t     restart         = 30;
+    };
+
+    /*
+     * 反復解法の結果
+     *
+     * - status             : 終了状態 (CGでp^T A p <= 0となった場合、GMRESで解が有限でなくなった場合はDiverged)
+     * - iterations         : 反復回数
+     * - residual           : 最終的な相対残差
+     * - residual_history   : 各反復での相対残差 (先頭は初期値での相対残差)
+     */
+    struct IterativeSolverResult {
+        SolverStatus            status;
+        std::size_t             iterations;
+        double                  residual;
+        std::vector<double>     residual_history;
+    };
+
+    namespace detail {
+        // 実行時に選択された計算核で計算する
+        inline double dot(std::span<const double> x, std::span<const double> y) {
+            return klibrary::linear_algebra::dispatch::kernels<double>().dot(x.data(), y.data(), x.size());
+        }
+        // y += a x を計算し、同じパスで更新後のy^T zを返す
+        inline double axpy_dot(const double& a, std::span<const double> x, std::span<double> y, std::span<const double> z) {
+            double sum = 0;
+            for(std::size_t i = 0; i < x.size(); ++i) {
+                y[i] += a * x[i];
+                sum += y[i] * z[i];
+            }
+            return sum;
+        }
+    }
+
+    /*
+     * 前処理付き共役勾配法(CG)により対称正定値な線形方程式 A x = b を解く
+     * xは初期値として使用され、解で上書きされる。
+     * 解の更新と残差の更新・内積はそれぞれ1パスで行う。
+     *
+     * 引数
+     * - a              : 係数行列 (LinearOperator)
+     * - b              : 右辺
+     * - x              : 初期値・解の書き込み先
+     * - preconditioner : 前処理 (IdentityPreconditioner, JacobiPreconditioner, IncompleteCholeskyPreconditioner等)
+     * - options        : 反復解法の設定
+     */
+    template <LinearOperator Operator, LinearOperator Preconditioner>
+    IterativeSolverResult conjugate_gradient(
+        const Operator& a,
+        std::span<const double> b,
+        std::span<double> x,
+        const Preconditioner& preconditioner,
+        const IterativeSolverOptions& options = {}
+    ) {
+        const std::size_t n = a.size();
+        assert(b.size() == n && x.size() == n && preconditioner.size() == n);
+        IterativeSolverResult result = {SolverStatus::MaxAttemptsReached, 0, 0, {}};
+        std::vector<double> r(n), z(n), p(n), q(n);
+
+        a.apply(x, q);
+        for(std::size_t i = 0; i < n; ++i) {
+            r[i] = b[i] - q[i];
+        }
+        const double b_norm = std::sqrt(detail::dot(b, b));
+        const double scale = b_norm == 0 ? 1 : 1 / b_norm;
+        double rr = detail::dot(r, r);
+        result.residual = std::sqrt(rr) * scale;
+        result.residual_history.push_back(result.residual);
+        if(result.residual <= options.tolerance) {
+            result.status = SolverStatus::Converged;
+            return result;
+        }
+
+        preconditioner.apply(r, z);
+        std::copy(z.begin(), z.end(), p.begin());
+        double rz = detail::dot(r, z);
+        while(result.iterations < options.max_iterations) {
+            a.apply(p, q);
+            const double pq = detail::dot(p, q);
+            if(!(pq > 0)) {
+                result.status = SolverStatus::Diverged;
+                return result;
+            }
+            const double alpha = rz / pq;
+            // x += αp, r -= αq と |r|^2 を1パスで計算する
+            rr = 0;
+            for(std::size_t i = 0; i < n; ++i) {
+                x[i] += alpha * p[i];
+                r[i] -= alpha * q[i];
+                rr += r[i] * r[i];
+            }
+            ++result.iterations;
+            result.residual = std::sqrt(rr) * scale;
+            result.residual_history.push_back(result.residual);
+            if(result.residual <= options.tolerance) {
+                result.status = SolverStatus::Converged;
+                return result;
+            }
+            preconditioner.apply(r, z);
+            const double next_rz = detail::dot(r, z);
+            const double beta = next_rz / rz;
+            rz = next_rz;
+            for(std::size_t i = 0; i < n; ++i) {
+                p[i] = z[i] + beta * p[i];
+            }
+        }
+        return result;
+    }
+    template <LinearOperator Operator>
+    IterativeSolverResult conjugate_gradient(
+        const Operator& a,
+        std::span<const double> b,
+        std::span<double> x,
+        const IterativeSolverOptions& options = {}
+    ) {
+        return conjugate_gradient(a, b, x, IdentityPreconditioner(a.size()), options);
+    }
+
+    /*
+     * 右前処理付き再始動GMRES(m)により一般の線形方程式 A x = b を解く
+     * xは初期値として使用され、解で上書きされる。
+     *
+     * Arnoldi過程は修正Gram-Schmidt法で直交化し、w -= h_j v_j の更新と次の基底との内積 w^T v_{j+1} を
+     * 1パスで計算する。最小化問題はGivens回転で逐次的に解くため、各反復の残差は追加の計算なしに得られる。
+     * 右前処理のため、残差は前処理されていない真の残差である。
+     *
+     * 引数
+     * - a              : 係数行列 (LinearOperator)
+     * - b              : 右辺
+     * - x              : 初期値・解の書き込み先
+     * - preconditioner : 前処理
+     * - options        : 反復解法の設定
+     */
+    template <LinearOperator Operator, LinearOperator Preconditioner>
+    IterativeSolverResult gmres(
+        const Operator& a,
+        std::span<const double> b,
+        std::span<double> x,
+        const Preconditioner& preconditioner,
+        const IterativeSolverOptions& options = {}
+    ) {
+        const std::size_t n = a.size();
+        const std::size_t m = std::max<std::size_t>(1, std::min(options.restart, n));
+        assert(b.size() == n && x.size() == n && preconditioner.size() == n);
+        IterativeSolverResult result = {SolverStatus::MaxAttemptsReached, 0, 0, {}};
+
+        // 基底 v_0, ..., v_m (連続した領域に格納する)
+        std::vector<double> basis((m + 1) * n);
+        const auto v = [&](const std::size_t& j) { return std::span<double>(basis.data() + j * n, n); };
+        std::vector<double> h((m + 1) * m, 0.0);
+        std::vector<double> cs(m), sn(m), g(m + 1), y(m);
+        std::vector<double> z(n), w(n);
+        const double b_norm = std::sqrt(detail::dot(b, b));
+        const double scale = b_norm == 0 ? 1 : 1 / b_norm;
+        bool first = true;
+
+        while(true) {
+            // r = b - A x
+            a.apply(x, w);
+            for(std::size_t i = 0; i < n; ++i) {
+                v(0)[i] = b[i] - w[i];
+            }
+            const double beta = std::sqrt(detail::dot(v(0), v(0)));
+            result.residual = beta * scale;
+            if(first) {
+                result.residual_history.push_back(result.residual);
+                first = false;
+            }
+            if(!std::isfinite(result.residual)) {
+                result.status = SolverStatus::Diverged;
+                return result;
+            }
+            if(result.residual <= options.tolerance) {
+                result.status = SolverStatus::Converged;
+                return result;
+            }
+            if(result.iterations >= options.max_iterations) {
+                return result;
+            }
+            for(auto& value : v(0)) {
+                value /= beta;
+            }
+            std::fill(g.begin(), g.end(), 0.0);
+            g[0] = beta;
+
+            std::size_t k = 0;
+            while(k < m && result.iterations < options.max_iterations) {
+                preconditioner.apply(v(k), z);
+                a.apply(z, w);
+                // 修正Gram-Schmidt (更新と次の内積を融合)
+                double next = detail::dot(w, v(0));
+                for(std::size_t j = 0; j <= k; ++j) {
+                    h[j * m + k] = next;
+                    next = detail::axpy_dot(-next, v(j), w, j < k ? std::span<const double>(v(j + 1)) : std::span<const double>(w));
+                }
+                const double w_norm = std::sqrt(std::max(0.0, next));
+                h[(k + 1) * m + k] = w_norm;
+
+                // 既存のGivens回転を適用し、新しい回転で下対角成分を消去する
+                for(std::size_t j = 0; j < k; ++j) {
+                    const double upper = h[j * m + k], lower = h[(j + 1) * m + k];
+                    h[j * m + k]       =  cs[j] * upper + sn[j] * lower;
+                    h[(j + 1) * m + k] = -sn[j] * upper + cs[j] * lower;
+                }
+                const double diagonal = h[k * m + k];
+                const double radius = std::hypot(diagonal, w_norm);
+                cs[k] = radius == 0 ? 1 : diagonal / radius;
+                sn[k] = radius == 0 ? 0 : w_norm / radius;
+                h[k * m + k] = radius;
+                h[(k + 1) * m + k] = 0;
+                g[k + 1] = -sn[k] * g[k];
+                g[k] = cs[k] * g[k];
+
+                ++k;
+                ++result.iterations;
+                result.residual = std::abs(g[k]) * scale;
+                result.residual_history.push_back(result.residual);
+                if(result.residual <= options.tolerance || w_norm == 0) {
+                    break;
+                }
+                for(std::size_t i = 0; i < n; ++i) {
+                    v(k)[i] = w[i] / w_norm;
+                }
+            }
+
+            // H y = g を後退代入で解き、x += M^-1 V y
+            for(std::size_t i = k; i-- > 0;) {
+                double sum = g[i];
+                for(std::size_t j = i + 1; j < k; ++j) {
+                    sum -= h[i * m + j] * y[j];
+                }
+                y[i] = sum / h[i * m + i];
+            }
+            std::fill(w.begin(), w.end(), 0.0);
+            for(std::size_t j = 0; j < k; ++j) {
+                for(std::size_t i = 0; i < n; ++i) {
+                    w[i] += y[j] * v(j)[i];
+                }
+            }
+            preconditioner.apply(w, z);
+            for(std::size_t i = 0; i < n; ++i) {
+                x[i] += z[i];
+            }
+        }
+    }
+    template <LinearOperator Operator>
+    IterativeSolverResult gmres(
+        const Operator& a,
+        std::span<const double> b,
+        std::span<double> x,
+        const IterativeSolverOptions& options = {}
+    ) {
+        return gmres(a, b, x, IdentityPreconditioner(a.size()), options);
+    }
+}
+#endif // iterative_solvers
@@ -0,0 +1,344 @@
+#ifndef least_squares
+#define least_squares
+#include <span>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <vector>
+#include <cstddef>
+#include <cassert>
+#include <algorithm>
+#include "solver_status.hpp"
+#include "batch_root_finding.hpp"
+#include "multidimensional_newton.hpp"
+#include "./../Parallel/parallel_for.hpp"
+#include "./../LinearAlgebra/StaticMatrix/Decomposition/staticmatrix_lu.hpp"
+namespace numerical_analysis {
+    /*
+     * 最小二乗法の結果
+     *
+     * - coefficients   : 係数 (多項式の場合は定数項から順)
+     * - status         : 終了状態 (計画行列の階数が落ちている場合はSingular)
+     * - residual       : 残差の二乗和
+     * - samples        : 標本数
+     */
+    template <std::size_t P>
+    struct LeastSquaresResult {
+        Vector<P>       coefficients;
+        SolverStatus    status;
+        double          residual;
+        std::size_t     samples;
+    };
+
+    /*
+     * P個の係数を持つ多項式 c_0 + c_1 x + ... + c_{P-1} x^{P-1} をHorner法で評価する
+     */
+    template <std::size_t P>
+    double evaluate_polynomial(const Vector<P>& coefficients, const double& x) {
+        double result = 0;
+        for(std::size_t k = P; k-- > 0;) {
+            result = result * x + coefficients[k];
+        }
+        return result;
+    }
+
+    /*
+     * xs[i]における多項式の値をout[i]に書き込む
+     * 係数を局所配列に展開し、点についての最内ループを分岐なしのHorner法で行うため、コンパイラによりSIMD化される。
+     */
+    template <std::size_t P>
+    void evaluate_polynomial(const Vector<P>& coefficients, std::span<const double> xs, std::span<double> out) {
+        assert(xs.size() == out.size());
+        std::array<double, P> c;
+        for(std::size_t k = 0; k < P; ++k) {
+            c[k] = coefficients[k];
+        }
+        constexpr std::size_t W = batch::lanes_per_block;
+        for(std::size_t i = 0; i < xs.size(); i += W) {
+            const std::size_t m = std::min(W, xs.size() - i);
+            std::array<double, W> x{};
+            std::array<double, W> y{};
+            for(std::size_t l = 0; l < m; ++l) {
+                x[l] = xs[i + l];
+            }
+            for(std::size_t k = P; k-- > 0;) {
+                for(std::size_t l = 0; l < W; ++l) {
+                    y[l] = y[l] * x[l] + c[k];
+                }
+            }
+            for(std::size_t l = 0; l < m; ++l) {
+                out[i + l] = y[l];
+            }
+        }
+    }
+
+    /*
+     * LeastSquaresAccumulator クラス
+     *
+     * 正規方程式 (A^T A) c = A^T y の係数行列と右辺を標本ごとに累積し、1パス・一定メモリで
+     * P個の係数を持つ線形モデルを当てはめる。標本を保持しないため、任意の長さの系列に使用できる。
+     *
+     * - add(row, y)            : 計画行列の1行rowと観測値yを追加する
+     * - add_polynomial(xs, ys) : 多項式 (rowは1, x, ..., x^{P-1}) の標本をまとめて追加する。
+     *                            lanes_per_block個の標本ごとに行を要素ごとの配列で作り、
+     *                            レーンについての最内ループで累積するため、コンパイラによりSIMD化される
+     * - merge(other)           : 別の累積器の内容を加える (分割した系列を並列に累積した結果の統合)
+     * - solve()                : 正規方程式を解く
+     *
+     * 正規方程式は計画行列の条件数の2乗の条件数を持つため、高次の多項式ではxを[-1, 1]程度に
+     * 正規化するか、fit_least_squares (QR分解) を使用すること。
+     */
+    template <std::size_t P>
+    class LeastSquaresAccumulator {
+        private:
+            // A^T A の上三角部分 (i <= j)
+            std::array<double, P * P> normal_;
+            std::array<double, P> rhs_;
+            double sum_y2_;
+            std::size_t samples_;
+        public:
+            LeastSquaresAccumulator() : sum_y2_(0), samples_(0) {
+                this->normal_.fill(0);
+                this->rhs_.fill(0);
+            }
+
+            void add(const Vector<P>& row, const double& y) {
+                for(std::size_t i = 0; i < P; ++i) {
+                    for(std::size_t j = i; j < P; ++j) {
+                        this->normal_[i * P + j] += row[i] * row[j];
+                    }
+                    this->rhs_[i] += row[i] * y;
+                }
+                this->sum_y2_ += y * y;
+                ++this->samples_;
+            }
+
+            void add_polynomial(std::span<const double> xs, std::span<const double> ys) {
+                assert(xs.size() == ys.size());
+                constexpr std::size_t W = batch::lanes_per_block;
+                // レーンごとの部分和 (端数のレーンは0の行として扱う)
+                std::array<std::array<double, W>, P * P> normal{};
+                std::array<std::array<double, W>, P> rhs{};
+                std::array<double, W> sum_y2{};
+                for(std::size_t b = 0; b < xs.size(); b += W) {
+                    const std::size_t m = std::min(W, xs.size() - b);
+                    std::array<std::array<double, W>, P> row{};
+                    std::array<double, W> y{};
+                    for(std::size_t l = 0; l < m; ++l) {
+                        row[0][l] = 1;
+                        y[l] = ys[b + l];
+                    }
+                    for(std::size_t l = 0; l < m; ++l) {
+                        const double x = xs[b + l];
+                        for(std::size_t k = 1; k < P; ++k) {
+                            row[k][l] = row[k - 1][l] * x;
+                        }
+                    }
+                    for(std::size_t i = 0; i < P; ++i) {
+                        for(std::size_t j = i; j < P; ++j) {
+                            for(std::size_t l = 0; l < W; ++l) {
+                                normal[i * P + j][l] += row[i][l] * row[j][l];
+                            }
+                        }
+                        for(std::size_t l = 0; l < W; ++l) {
+                            rhs[i][l] += row[i][l] * y[l];
+                        }
+                    }
+                    for(std::size_t l = 0; l < W; ++l) {
+                        sum_y2[l] += y[l] * y[l];
+                    }
+                }
+                for(std::size_t i = 0; i < P; ++i) {
+                    for(std::size_t j = i; j < P; ++j) {
+                        for(std::size_t l = 0; l < W; ++l) {
+                            this->normal_[i * P + j] += normal[i * P + j][l];
+                        }
+                    }
+                    for(std::size_t l = 0; l < W; ++l) {
+                        this->rhs_[i] += rhs[i][l];
+                    }
+                }
+                for(std::size_t l = 0; l < W; ++l) {
+                    this->sum_y2_ += sum_y2[l];
+                }
+                this->samples_ += xs.size();
+            }
+
+            LeastSquaresAccumulator& merge(const LeastSquaresAccumulator& other) {
+                for(std::size_t i = 0; i < P * P; ++i) {
+                    this->normal_[i] += other.normal_[i];
+                }
+                for(std::size_t i = 0; i < P; ++i) {
+                    this->rhs_[i] += other.rhs_[i];
+                }
+                this->sum_y2_ += other.sum_y2_;
+                this->samples_ += other.samples_;
+                return (*this);
+            }
+
+            LeastSquaresResult<P> solve() const {
+                Jacobian<P> normal;
+                for(std::size_t i = 0; i < P; ++i) {
+                    for(std::size_t j = i; j < P; ++j) {
+                        normal(i, j) = normal(j, i) = this->normal_[i * P + j];
+                    }
+                }
+                LeastSquaresResult<P> result = {Vector<P>(), SolverStatus::Converged, this->sum_y2_, this->samples_};
+                const klibrary::linear_algebra::StaticMatrixLU<double, P> lu(normal);
+                if(this->samples_ < P || lu.singular()) {
+                    result.status = SolverStatus::Singular;
+                    return result;
+                }
+                for(std::size_t i = 0; i < P; ++i) {
+                    result.coefficients[i] = this->rhs_[i];
+                }
+                lu.solve_in_place(result.coefficients);
+                // |y - Ac|^2 = y^T y - c^T A^T y (cは正規方程式の解)
+                double explained = 0;
+                for(std::size_t i = 0; i < P; ++i) {
+                    explained += result.coefficients[i] * this->rhs_[i];
+                }
+                result.residual = std::max(0.0, this->sum_y2_ - explained);
+                return result;
+            }
+
+            std::size_t samples() const noexcept { return this->samples_; }
+    };
+
+    /*
+     * 標本(xs, ys)に次数Degreeの多項式を1パスで当てはめる
+     * 系列をthreads個(0の場合はハードウェアの並列数)の連続した区間に分割し、各スレッドが独立に累積した
+     * LeastSquaresAccumulatorを区間の順に統合してから正規方程式を解く (同じthreadsであれば結果は毎回一致する)。
+     *
+     * 引数
+     * - xs         : 標本点
+     * - ys         : 観測値
+     * - threads    : 使用するスレッド数
+     */
+    template <std::size_t Degree>
+    LeastSquaresResult<Degree + 1> fit_polynomial_streaming(
+        std::span<const double> xs,
+        std::span<const double> ys,
+        const std::size_t& threads = 1
+    ) {
+        assert(xs.size() == ys.size());
+        // 区間ごとの累積結果を区間の順に統合し、スレッドの終了順によらず結果を一定にする
+        const std::size_t n = xs.size();
+        const std::size_t blocks = (n + batch::lanes_per_block - 1) / batch::lanes_per_block;
+        const std::size_t chunks = std::max<std::size_t>(1, std::min(klibrary::parallel::thread_count(threads), blocks));
+        const auto bound = [&](const std::size_t& i) { return std::min(n, (blocks * i / chunks) * batch::lanes_per_block); };
+        std::vector<LeastSquaresAccumulator<Degree + 1>> parts(chunks);
+        klibrary::parallel::parallel_for(0, chunks, chunks, [&](const std::size_t& begin, const std::size_t& end) {
+            for(std::size_t i = begin; i < end; ++i) {
+                parts[i].add_polynomial(xs.subspan(bound(i), bound(i + 1) - bound(i)), ys.subspan(bound(i), bound(i + 1) - bound(i)));
+            }
+        });
+        LeastSquaresAccumulator<Degree + 1> total;
+        for(const auto& part : parts) {
+            total.merge(part);
+        }
+        return total.solve();
+    }
+
+    /*
+     * Householder変換によるQR分解で最小二乗問題 min |Ac - y| を解く
+     * 計画行列のi行目はbasis(xs[i])で与えられる (Vector<P>を返す)。
+     * 正規方程式を作らないため、条件数の悪い問題でも正規方程式より精度が高いが、
+     * 計画行列全体 (xs.size() * P個) を保持する。
+     *
+     * 引数
+     * - xs         : 標本点
+     * - ys         : 観測値
+     * - basis      : 基底関数
+     */
+    template <std::size_t P, class Basis>
+    LeastSquaresResult<P> fit_least_squares(
+        std::span<const double> xs,
+        std::span<const double> ys,
+        const Basis& basis
+    ) {
+        assert(xs.size() == ys.size());
+        const std::size_t M = xs.size();
+        LeastSquaresResult<P> result = {Vector<P>(), SolverStatus::Converged, 0, M};
+        if(M < P) {
+            result.status = SolverStatus::Singular;
+            return result;
+        }
+        // 列優先で保持し、各列の変換を連続したメモリ上で行う
+        std::vector<double> a(M * P);
+        std::vector<double> y(ys.begin(), ys.end());
+        for(std::size_t i = 0; i < M; ++i) {
+            const Vector<P> row = basis(xs[i]);
+            for(std::size_t j = 0; j < P; ++j) {
+                a[j * M + i] = row[j];
+            }
+        }
+
+        double scale = 0;
+        for(std::size_t k = 0; k < P; ++k) {
+            double* column = a.data() + k * M;
+            double norm = 0;
+            for(std::size_t i = k; i < M; ++i) {
+                norm += column[i] * column[i];
+            }
+            norm = std::sqrt(norm);
+            scale = std::max(scale, norm);
+            if(norm <= std::numeric_limits<double>::epsilon() * scale * static_cast<double>(M) || norm == 0) {
+                result.status = SolverStatus::Singular;
+                return result;
+            }
+            // v = x + sign(x_k)|x|e_k を列kの下部に格納し、R_kk = -sign(x_k)|x|
+            const double alpha = column[k] > 0 ? -norm : norm;
+            column[k] -= alpha;
+            double vv = 0;
+            for(std::size_t i = k; i < M; ++i) {
+                vv += column[i] * column[i];
+            }
+            const auto reflect = [&](double* target) {
+                double dot = 0;
+                for(std::size_t i = k; i < M; ++i) {
+                    dot += column[i] * target[i];
+                }
+                const double factor = 2 * dot / vv;
+                for(std::size_t i = k; i < M; ++i) {
+                    target[i] -= factor * column[i];
+                }
+            };
+            for(std::size_t j = k + 1; j < P; ++j) {
+                reflect(a.data() + j * M);
+            }
+            reflect(y.data());
+            column[k] = alpha;
+        }
+
+        // R c = Q^T y
+        for(std::size_t k = P; k-- > 0;) {
+            double sum = y[k];
+            for(std::size_t j = k + 1; j < P; ++j) {
+                sum -= a[j * M + k] * result.coefficients[j];
+            }
+            result.coefficients[k] = sum / a[k * M + k];
+        }
+        for(std::size_t i = P; i < M; ++i) {
+            result.residual += y[i] * y[i];
+        }
+        return result;
+    }
+
+    /*
+     * 標本(xs, ys)に次数Degreeの多項式をQR分解により当てはめる
+     */
+    template <std::size_t Degree>
+    LeastSquaresResult<Degree + 1> fit_polynomial(std::span<const double> xs, std::span<const double> ys) {
+        return fit_least_squares<Degree + 1>(xs, ys, [](const double& x) {
+            Vector<Degree + 1> row;
+            double power = 1;
+            for(std::size_t k = 0; k <= Degree; ++k) {
+                row[k] = power;
+                power *= x;
+            }
+            return row;
+        });
+    }
+}
+#endif // least_squares
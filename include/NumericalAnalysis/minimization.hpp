@@ -0,0 +1,390 @@
+#ifndef minimization
+#define minimization
+#include <cmath>
+#include <limits>
+#include <vector>
+#include <cstddef>
+#include <numeric>
+#include <concepts>
+#include <algorithm>
+#include "solver_status.hpp"
+#include "multidimensional_newton.hpp"
+#include "multivariate_differentiation.hpp"
+#include "./../Parallel/parallel_for.hpp"
+namespace numerical_analysis {
+    /*
+     * 最小化の設定
+     *
+     * - tolerance      : 収束判定条件
+     *                    L-BFGS     : max|∇f_i| <= tolerance * max(1, |f(x)|)
+     *                    Nelder-Mead: 単体の頂点の関数値の差と頂点間の距離(最大値ノルム)がともに
+     *                                 tolerance * (1 + |f(x)|)、tolerance * (1 + max|x_i|) 以下
+     * - max_iterations : 最大反復回数
+     * - history        : L-BFGSで保持する更新の組(s, y)の数
+     * - initial_step   : Nelder-Meadの初期単体の辺の長さ (x_iの大きさに対する比。x_iが1未満の場合は絶対値)
+     * - threads        : Nelder-Meadで頂点を同時に評価する場合(初期単体と縮小)および
+     *                    数値微分による勾配の評価に使用するスレッド数
+     */
+    struct MinimizerOptions {
+        double      tolerance       = 1e-8;
+        std::size_t max_iterations  = 1000;
+        std::size_t history         = 8;
+        double      initial_step    = 0.05;
+        std::size_t threads         = 1;
+    };
+
+    /*
+     * 最小化の結果
+     *
+     * - x                      : 最小点
+     * - value                  : f(x)
+     * - status                 : 終了状態 (L-BFGSの直線探索で十分な減少が得られなかった場合はMaxAttemptsReached)
+     * - iterations             : 反復回数
+     * - evaluations            : f(x)の評価回数
+     * - gradient_evaluations   : 勾配の評価回数 (L-BFGSのみ)
+     */
+    template <class State>
+    struct MinimizerResult {
+        State           x;
+        double          value;
+        SolverStatus    status;
+        std::size_t     iterations;
+        std::size_t     evaluations;
+        std::size_t     gradient_evaluations;
+    };
+
+    namespace detail {
+        // 最小化の対象となる状態(Vector<N>またはstd::vector<double>)の次元
+        template <std::size_t N>
+        constexpr std::size_t state_dimension(const Vector<N>&) noexcept { return N; }
+        inline std::size_t state_dimension(const std::vector<double>& x) noexcept { return x.size(); }
+
+        template <class State>
+        double state_dot(const State& a, const State& b, const std::size_t& n) {
+            double sum = 0;
+            for(std::size_t i = 0; i < n; ++i) {
+                sum += a[i] * b[i];
+            }
+            return sum;
+        }
+        template <class State>
+        double state_max_norm(const State& a, const std::size_t& n) {
+            double result = 0;
+            for(std::size_t i = 0; i < n; ++i) {
+                result = std::max(result, std::abs(a[i]));
+            }
+            return result;
+        }
+
+        // 勾配をgに書き込む。gradient(x, g)とgradient(x) -> Stateの両方の形式を受け付ける
+        template <class State, class G>
+        void evaluate_gradient(const G& gradient, const State& x, State& g) {
+            if constexpr(std::invocable<const G&, const State&, State&>) {
+                gradient(x, g);
+            } else {
+                g = gradient(x);
+            }
+        }
+    }
+
+    /*
+     * L-BFGS法によりf(x)の極小点を探索する
+     *
+     * 直近options.history組の更新 s = x_{k+1} - x_k, y = ∇f_{k+1} - ∇f_k から
+     * 2重ループ再帰により準Newton方向を求め、Armijo条件を満たすまで2次補間によりステップ幅を縮小する直線探索を行う。
+     * 更新の組は反復の開始時に確保したリングバッファに保持し、反復中はメモリを確保しない
+     * (gradientがStateを返す形式の場合はその戻り値を除く)。
+     * s・yが正でない更新は近似ヘッセ行列の正定値性を保つため破棄する。
+     *
+     * xはVector<N>またはstd::vector<double>である。
+     *
+     * 引数
+     * - x          : 探索を開始するx
+     * - f          : f(x) (doubleに変換可能な値を返す)
+     * - gradient   : ∇f(x) (gradient(x, g)でgに書き込むか、gradient(x)でStateを返す)
+     * - options    : 設定
+     */
+    template <class State, class F, class G>
+    requires std::invocable<const G&, const State&>
+          || std::invocable<const G&, const State&, State&>
+    MinimizerResult<State> lbfgs(const State& x, const F& f, const G& gradient, const MinimizerOptions& options = {}) {
+        constexpr double c1 = 1e-4;
+        constexpr std::size_t max_line_search = 40;
+        const std::size_t n = detail::state_dimension(x);
+        const std::size_t m = std::max<std::size_t>(options.history, 1);
+
+        MinimizerResult<State> result = {x, static_cast<double>(f(x)), SolverStatus::MaxAttemptsReached, 0, 1, 1};
+        State& current = result.x;
+        double& value = result.value;
+        State g = x;
+        detail::evaluate_gradient(gradient, current, g);
+        if(!std::isfinite(value)) {
+            result.status = SolverStatus::Diverged;
+            return result;
+        }
+
+        // リングバッファ (newestが最新の組、countが保持している組の数)
+        std::vector<State> s(m, x);
+        std::vector<State> y(m, x);
+        std::vector<double> rho(m);
+        std::vector<double> alpha(m);
+        std::size_t newest = 0;
+        std::size_t count = 0;
+        double gamma = 1;
+
+        State direction = x;
+        State trial = x;
+        State trial_g = x;
+        for(; result.iterations < options.max_iterations; ++result.iterations) {
+            if(detail::state_max_norm(g, n) <= options.tolerance * std::max(1.0, std::abs(value))) {
+                result.status = SolverStatus::Converged;
+                return result;
+            }
+
+            // 2重ループ再帰 (direction = -H ∇f)
+            for(std::size_t i = 0; i < n; ++i) {
+                direction[i] = -g[i];
+            }
+            for(std::size_t k = 0; k < count; ++k) {
+                const std::size_t j = (newest + m - k) % m;
+                alpha[j] = rho[j] * detail::state_dot(s[j], direction, n);
+                for(std::size_t i = 0; i < n; ++i) {
+                    direction[i] -= alpha[j] * y[j][i];
+                }
+            }
+            for(std::size_t i = 0; i < n; ++i) {
+                direction[i] *= gamma;
+            }
+            for(std::size_t k = count; k-- > 0;) {
+                const std::size_t j = (newest + m - k) % m;
+                const double beta = rho[j] * detail::state_dot(y[j], direction, n);
+                for(std::size_t i = 0; i < n; ++i) {
+                    direction[i] += (alpha[j] - beta) * s[j][i];
+                }
+            }
+
+            double slope = detail::state_dot(g, direction, n);
+            if(!(slope < 0)) {
+                // 降下方向でない場合は履歴を破棄して最急降下方向を用いる
+                count = 0;
+                gamma = 1;
+                for(std::size_t i = 0; i < n; ++i) {
+                    direction[i] = -g[i];
+                }
+                slope = -detail::state_dot(g, g, n);
+            }
+
+            // 履歴がない場合は最初の試行点がxから高々1だけ離れるようにする
+            double t = count == 0 ? std::min(1.0, 1 / detail::state_max_norm(direction, n)) : 1.0;
+            double trial_value = 0;
+            bool accepted = false;
+            for(std::size_t attempt = 0; attempt < max_line_search; ++attempt) {
+                for(std::size_t i = 0; i < n; ++i) {
+                    trial[i] = current[i] + t * direction[i];
+                }
+                trial_value = f(trial);
+                ++result.evaluations;
+                if(std::isfinite(trial_value) && trial_value <= value + c1 * t * slope) {
+                    accepted = true;
+                    break;
+                }
+                // φ(t)の2次補間の最小点 (有限でない場合は半分にする)
+                const double curvature = trial_value - value - slope * t;
+                const double next = std::isfinite(curvature) && curvature > 0 ? -slope * t * t / (2 * curvature) : t / 2;
+                t = std::clamp(next, t / 10, t / 2);
+            }
+            if(!accepted) {
+                return result;
+            }
+
+            detail::evaluate_gradient(gradient, trial, trial_g);
+            ++result.gradient_evaluations;
+
+            // 曲率条件を満たすまでリングバッファの最古の組を上書きしないよう、sはdirectionに求める
+            double sy = 0, yy = 0;
+            for(std::size_t i = 0; i < n; ++i) {
+                direction[i] = trial[i] - current[i];
+                const double dy = trial_g[i] - g[i];
+                sy += direction[i] * dy;
+                yy += dy * dy;
+            }
+            if(sy > std::numeric_limits<double>::epsilon() * yy) {
+                const std::size_t next = (newest + 1) % m;
+                for(std::size_t i = 0; i < n; ++i) {
+                    s[next][i] = direction[i];
+                    y[next][i] = trial_g[i] - g[i];
+                }
+                newest = next;
+                rho[next] = 1 / sy;
+                gamma = sy / yy;
+                count = std::min(count + 1, m);
+            }
+
+            std::swap(current, trial);
+            std::swap(g, trial_g);
+            value = trial_value;
+        }
+        return result;
+    }
+
+    /*
+     * 勾配が未知である場合に中心差分で勾配を求め、L-BFGS法によりf(x)の極小点を探索する
+     * 勾配の評価ごとにf(x)を2N回評価し、options.threadsのスレッドで並列に評価する。
+     *
+     * 引数
+     * - x          : 探索を開始するx
+     * - f          : f(x)
+     * - h          : 差分幅
+     * - options    : 設定
+     */
+    template <std::size_t N, class F>
+    MinimizerResult<Vector<N>> lbfgs(const Vector<N>& x, const F& f, const double& h, const MinimizerOptions& options = {}) {
+        const auto numerical_gradient = [&](const Vector<N>& at, Vector<N>& g) {
+            g = gradient(f, at, h, options.threads);
+        };
+        auto result = lbfgs(x, f, numerical_gradient, options);
+        result.evaluations += 2 * N * result.gradient_evaluations;
+        return result;
+    }
+
+    /*
+     * Nelder-Mead法によりf(x)の極小点を探索する
+     *
+     * 勾配を用いない単体法で、反射・拡大・収縮・縮小の係数には次元に応じた値 (Gao and Han, 2012) を用いる。
+     * 頂点、関数値、並べ替え用の添字は反復の開始時に確保し、反復中はメモリを確保しない。
+     * 初期単体のN + 1頂点と縮小後のN頂点の評価は互いに独立であり、options.threadsのスレッドで並列に評価する
+     * (この場合fは複数のスレッドから同時に呼び出される)。
+     *
+     * xはVector<N>またはstd::vector<double>である。
+     *
+     * 引数
+     * - x          : 探索を開始するx (初期単体の頂点の1つ)
+     * - f          : f(x)
+     * - options    : 設定
+     */
+    template <class State, class F>
+    MinimizerResult<State> nelder_mead(const State& x, const F& f, const MinimizerOptions& options = {}) {
+        const std::size_t n = detail::state_dimension(x);
+        const double dimension = static_cast<double>(n);
+        const double reflection  = 1;
+        const double expansion   = n < 2 ? 2.0 : 1 + 2 / dimension;
+        const double contraction = n < 2 ? 0.5 : 0.75 - 1 / (2 * dimension);
+        const double shrinkage   = n < 2 ? 0.5 : 1 - 1 / dimension;
+
+        std::vector<State> vertices(n + 1, x);
+        std::vector<double> values(n + 1);
+        std::vector<std::size_t> order(n + 1);
+        for(std::size_t i = 0; i < n; ++i) {
+            vertices[i + 1][i] += options.initial_step * std::max(std::abs(x[i]), 1.0);
+        }
+
+        MinimizerResult<State> result = {x, 0, SolverStatus::MaxAttemptsReached, 0, 0, 0};
+        // first以降の頂点(firstは0または1)を並列に評価する
+        const auto evaluate_vertices = [&](const std::size_t& first) {
+            klibrary::parallel::parallel_for(first, n + 1, options.threads, [&](const std::size_t& begin, const std::size_t& end) {
+                for(std::size_t i = begin; i < end; ++i) {
+                    values[order[i]] = f(vertices[order[i]]);
+                }
+            });
+            result.evaluations += n + 1 - first;
+        };
+        std::iota(order.begin(), order.end(), 0);
+        evaluate_vertices(0);
+
+        State centroid = x;
+        State trial = x;
+        State second_trial = x;
+        const auto move = [&](State& to, const double& coefficient, const State& from) {
+            // to = centroid + coefficient * (from - centroid)
+            for(std::size_t i = 0; i < n; ++i) {
+                to[i] = centroid[i] + coefficient * (from[i] - centroid[i]);
+            }
+            ++result.evaluations;
+            return static_cast<double>(f(to));
+        };
+        const auto finish = [&](const SolverStatus& status) {
+            const std::size_t best = order[0];
+            result.x = vertices[best];
+            result.value = values[best];
+            result.status = status;
+            return result;
+        };
+
+        for(;; ++result.iterations) {
+            std::sort(order.begin(), order.end(), [&](const std::size_t& a, const std::size_t& b) {
+                // NaNは最悪の値として扱う
+                return values[a] < values[b] || (std::isnan(values[b]) && !std::isnan(values[a]));
+            });
+            const std::size_t best = order[0];
+            const std::size_t worst = order[n];
+            if(!std::isfinite(values[best])) {
+                return finish(SolverStatus::Diverged);
+            }
+
+            double diameter = 0;
+            for(std::size_t k = 1; k <= n; ++k) {
+                for(std::size_t i = 0; i < n; ++i) {
+                    diameter = std::max(diameter, std::abs(vertices[order[k]][i] - vertices[best][i]));
+                }
+            }
+            const double scale = 1 + detail::state_max_norm(vertices[best], n);
+            if(values[worst] - values[best] <= options.tolerance * (1 + std::abs(values[best])) && diameter <= options.tolerance * scale) {
+                return finish(SolverStatus::Converged);
+            }
+            if(result.iterations == options.max_iterations) {
+                return finish(SolverStatus::MaxAttemptsReached);
+            }
+
+            // 最悪の頂点を除いた重心
+            for(std::size_t i = 0; i < n; ++i) {
+                centroid[i] = 0;
+            }
+            for(std::size_t k = 0; k < n; ++k) {
+                const State& vertex = vertices[order[k]];
+                for(std::size_t i = 0; i < n; ++i) {
+                    centroid[i] += vertex[i];
+                }
+            }
+            for(std::size_t i = 0; i < n; ++i) {
+                centroid[i] /= dimension;
+            }
+
+            const double reflected = move(trial, -reflection, vertices[worst]);
+            if(reflected < values[best]) {
+                const double expanded = move(second_trial, expansion, trial);
+                if(expanded < reflected) {
+                    std::swap(vertices[worst], second_trial);
+                    values[worst] = expanded;
+                } else {
+                    std::swap(vertices[worst], trial);
+                    values[worst] = reflected;
+                }
+                continue;
+            }
+            if(reflected < values[order[n - 1]]) {
+                std::swap(vertices[worst], trial);
+                values[worst] = reflected;
+                continue;
+            }
+
+            // 外側収縮 (反射点が最悪の頂点より良い場合) または内側収縮
+            const bool outside = reflected < values[worst];
+            const double contracted = outside ? move(second_trial, contraction, trial) : move(second_trial, -contraction, trial);
+            if(contracted < (outside ? reflected : values[worst])) {
+                std::swap(vertices[worst], second_trial);
+                values[worst] = contracted;
+                continue;
+            }
+
+            // 最良の頂点に向けて縮小
+            for(std::size_t k = 1; k <= n; ++k) {
+                State& vertex = vertices[order[k]];
+                for(std::size_t i = 0; i < n; ++i) {
+                    vertex[i] = vertices[best][i] + shrinkage * (vertex[i] - vertices[best][i]);
+                }
+            }
+            evaluate_vertices(1);
+        }
+    }
+}
+#endif // minimization
@@ -0,0 +1,246 @@
+#ifndef multidimensional_newton
+#define multidimensional_newton
+#include <cmath>
+#include <cstddef>
+#include <algorithm>
+#include <limits>
+#include "constants.hpp"
+#include "solver_status.hpp"
+#include "./../LinearAlgebra/StaticMatrix/Base/staticmatrix_base.hpp"
+#include "./../LinearAlgebra/StaticMatrix/Vector/staticvector.hpp"
+#include "./../LinearAlgebra/StaticMatrix/Decomposition/staticmatrix_lu.hpp"
+namespace numerical_analysis {
+    template <std::size_t N>
+    using Vector = klibrary::linear_algebra::StaticColVector<double, N>;
+    template <std::size_t N>
+    using Jacobian = klibrary::linear_algebra::StaticMatrixBase<double, N, N>;
+
+    /*
+     * ヤコビ行列の更新方法
+     *
+     * - Exact      : 毎反復でヤコビ行列を評価し、LU分解する
+     * - Broyden    : 最初に1度だけヤコビ行列を評価・分解し、以降はBroydenの公式によりその逆行列を
+     *                ランク1更新する (1反復あたりO(N^2))。残差が増加した場合のみヤコビ行列を評価し直す
+     */
+    enum class JacobianUpdate { Exact, Broyden };
+
+    /*
+     * 連立非線形方程式の求解結果
+     *
+     * - x                      : 解
+     * - status                 : 終了状態
+     * - iterations             : 反復回数
+     * - evaluations            : F(x)の評価回数 (有限差分によるヤコビ行列の評価を含む)
+     * - jacobian_evaluations   : ヤコビ行列の評価回数
+     */
+    template <std::size_t N>
+    struct SystemSolverResult {
+        Vector<N>       x;
+        SolverStatus    status;
+        std::size_t     iterations;
+        std::size_t     evaluations;
+        std::size_t     jacobian_evaluations;
+    };
+
+    namespace detail {
+        template <std::size_t N>
+        double max_norm(const Vector<N>& v) {
+            double result = 0;
+            for(std::size_t i = 0; i < N; ++i) {
+                result = std::max(result, std::abs(v[i]));
+            }
+            return result;
+        }
+
+        // 反復の本体。jacobian(x, fx, J)はxにおけるヤコビ行列をJに書き込み、Fの評価回数を返す
+        template <std::size_t N, class F, class J>
+        SystemSolverResult<N> newton_system(
+            const Vector<N>& initial_x,
+            const F& f,
+            const J& jacobian,
+            const double& epsilon,
+            const std::size_t& max_attempts,
+            const JacobianUpdate& update
+        ) {
+            SystemSolverResult<N> result = {initial_x, SolverStatus::MaxAttemptsReached, 0, 0, 0};
+            Vector<N>& x = result.x;
+            Vector<N> fx = f(x);
+            ++result.evaluations;
+
+            Jacobian<N> matrix;
+            klibrary::linear_algebra::StaticMatrixLU<double, N> lu;
+            // Broyden法で用いるヤコビ行列の逆行列の近似
+            Jacobian<N> inverse;
+            bool fresh = false;
+            const auto evaluate_jacobian = [&]() {
+                result.evaluations += jacobian(x, fx, matrix);
+                ++result.jacobian_evaluations;
+                fresh = true;
+                if(!lu.factorize(matrix)) {
+                    return false;
+                }
+                if(update == JacobianUpdate::Broyden) {
+                    inverse = lu.inverse();
+                }
+                return true;
+            };
+            if(!evaluate_jacobian()) {
+                result.status = SolverStatus::Singular;
+                return result;
+            }
+
+            Vector<N> dx;
+            Vector<N> next_fx;
+            Vector<N> h_df;
+            for(std::size_t attempt = 0; attempt < max_attempts; ++attempt) {
+                ++result.iterations;
+                if(update == JacobianUpdate::Exact) {
+                    for(std::size_t i = 0; i < N; ++i) {
+                        dx[i] = -fx[i];
+                    }
+                    lu.solve_in_place(dx);
+                } else {
+                    for(std::size_t r = 0; r < N; ++r) {
+                        double sum = 0;
+                        for(std::size_t c = 0; c < N; ++c) {
+                            sum += inverse(r, c) * fx[c];
+                        }
+                        dx[r] = -sum;
+                    }
+                }
+                for(std::size_t i = 0; i < N; ++i) {
+                    x[i] += dx[i];
+                }
+                next_fx = f(x);
+                ++result.evaluations;
+                if(!std::isfinite(max_norm(next_fx)) || !std::isfinite(max_norm(x))) {
+                    result.status = SolverStatus::Diverged;
+                    return result;
+                }
+                const bool converged = max_norm(dx) <= epsilon * (1 + max_norm(x));
+
+                if(update == JacobianUpdate::Broyden && !converged) {
+                    if(!fresh && max_norm(next_fx) > max_norm(fx)) {
+                        // 近似が悪化したためヤコビ行列を評価し直して同じ点からやり直す
+                        for(std::size_t i = 0; i < N; ++i) {
+                            x[i] -= dx[i];
+                        }
+                        if(!evaluate_jacobian()) {
+                            result.status = SolverStatus::Singular;
+                            return result;
+                        }
+                        continue;
+                    }
+                    // H += (dx - H df) (dx^T H) / (dx^T H df)
+                    double denominator = 0;
+                    for(std::size_t r = 0; r < N; ++r) {
+                        double sum = 0;
+                        for(std::size_t c = 0; c < N; ++c) {
+                            sum += inverse(r, c) * (next_fx[c] - fx[c]);
+                        }
+                        h_df[r] = sum;
+                        denominator += dx[r] * sum;
+                    }
+                    if(denominator != 0) {
+                        Vector<N> dx_h;
+                        for(std::size_t c = 0; c < N; ++c) {
+                            double sum = 0;
+                            for(std::size_t r = 0; r < N; ++r) {
+                                sum += dx[r] * inverse(r, c);
+                            }
+                            dx_h[c] = sum;
+                        }
+                        for(std::size_t r = 0; r < N; ++r) {
+                            const double scale = (dx[r] - h_df[r]) / denominator;
+                            for(std::size_t c = 0; c < N; ++c) {
+                                inverse(r, c) += scale * dx_h[c];
+                            }
+                        }
+                    }
+                    fresh = false;
+                }
+                fx = next_fx;
+                if(converged) {
+                    result.status = SolverStatus::Converged;
+                    return result;
+                }
+                if(update == JacobianUpdate::Exact && !evaluate_jacobian()) {
+                    result.status = SolverStatus::Singular;
+                    return result;
+                }
+            }
+            return result;
+        }
+    }
+
+    /*
+     * ヤコビ行列J(x)が既知である場合にNewton-Raphson法による連立方程式F(x)=0の解の探索を行う。
+     * 状態はStaticColVector<double, N>、ヤコビ行列はStaticMatrixBase<double, N, N>で表し、
+     * 反復中にヒープ確保を行わない。
+     *
+     * 収束判定は max|dx_i| <= epsilon * (1 + max|x_i|) である。
+     * ヤコビ行列のLU分解に失敗した (特異である) 場合の状態はSingularとなる。
+     *
+     * 引数
+     * - x              : 探索を開始するx
+     * - f              : F(x) (Vector<N>を受け取りVector<N>に変換可能な値を返す)
+     * - jacobian       : J(x) (Vector<N>を受け取りJacobian<N>に変換可能な値を返す)
+     * - epsilon        : 収束判定条件
+     * - max_attempts   : 最大試行回数
+     * - update         : ヤコビ行列の更新方法
+     */
+    template <std::size_t N, class F, class J>
+    requires std::invocable<const J&, const Vector<N>&>
+    SystemSolverResult<N> newton_raphson(
+        const Vector<N>& x,
+        const F& f,
+        const J& jacobian,
+        const double& epsilon           = Constants::epsilon,
+        const std::size_t& max_attempts = Constants::max_attempts,
+        const JacobianUpdate update     = JacobianUpdate::Exact
+    ) {
+        const auto analytic = [&](const Vector<N>& at, const Vector<N>&, Jacobian<N>& matrix) -> std::size_t {
+            matrix = jacobian(at);
+            return 0;
+        };
+        return detail::newton_system<N>(x, f, analytic, epsilon, max_attempts, update);
+    }
+
+    /*
+     * ヤコビ行列J(x)が未知である場合に前進差分でJ(x)を求め、Newton-Raphson法による連立方程式F(x)=0の解の探索を行う。
+     * ヤコビ行列の評価ごとにF(x)をN回評価する (F(x)自体は反復で評価済みの値を再利用する)。
+     * 差分幅は sqrt(machine epsilon) * max(|x_i|, 1) である。
+     *
+     * 引数
+     * - x              : 探索を開始するx
+     * - f              : F(x)
+     * - epsilon        : 収束判定条件
+     * - max_attempts   : 最大試行回数
+     * - update         : ヤコビ行列の更新方法
+     */
+    template <std::size_t N, class F>
+    SystemSolverResult<N> newton_raphson(
+        const Vector<N>& x,
+        const F& f,
+        const double& epsilon           = Constants::epsilon,
+        const std::size_t& max_attempts = Constants::max_attempts,
+        const JacobianUpdate update     = JacobianUpdate::Exact
+    ) {
+        const auto finite_difference = [&](const Vector<N>& at, const Vector<N>& f_at, Jacobian<N>& matrix) -> std::size_t {
+            const double scale = std::sqrt(std::numeric_limits<double>::epsilon());
+            Vector<N> shifted = at;
+            for(std::size_t c = 0; c < N; ++c) {
+                const double h = scale * std::max(std::abs(at[c]), 1.0);
+                shifted[c] = at[c] + h;
+                const Vector<N> f_shifted = f(shifted);
+                for(std::size_t r = 0; r < N; ++r) {
+                    matrix(r, c) = (f_shifted[r] - f_at[r]) / h;
+                }
+                shifted[c] = at[c];
+            }
+            return N;
+        };
+        return detail::newton_system<N>(x, f, finite_difference, epsilon, max_attempts, update);
+    }
+}
+#endif // multidimensional_newton
@@ -0,0 +1,199 @@
+#ifndef multivariate_differentiation
+#define multivariate_differentiation
+#include <array>
+#include <cstddef>
+#include <type_traits>
+#include "constants.hpp"
+#include "state_size.hpp"
+#include "numerical_differentiation.hpp"
+#include "multidimensional_newton.hpp"
+#include "./../Parallel/parallel_for.hpp"
+#include "./../LinearAlgebra/StaticMatrix/Base/staticmatrix_base.hpp"
+namespace numerical_analysis {
+    /*
+     * 多変数関数の数値微分
+     *
+     * Vector<N> (StaticColVector<double, N>) を引数に取る関数の勾配・ヤコビ行列・ヘッセ行列を有限差分で求める。
+     * 勾配とヤコビ行列はDerivativeと同じStencil (Forward, Central, Backward, FivePoints, SevenPoints) を
+     * 各座標軸方向に適用し、差分幅hの意味もDerivativeと同じである。
+     *
+     * - 結果はVector<N>およびStaticMatrixBaseで返し、threadsが1の場合はヒープ確保を行わない
+     * - 偏微分ごとの評価は互いに独立であり、threadsに2以上(0の場合はハードウェアの並列数)を指定すると
+     *   座標軸(ヘッセ行列では座標軸の組)ごとに複数のスレッドで評価する。fは複数のスレッドから同時に呼び出される
+     * - Forward, Backwardでは全ての座標軸で共通の点f(x)を1度だけ評価する
+     */
+    namespace detail {
+        // Stencilの標本点のうちxそのもの(offsetが0)を除いた数
+        template <DerivativeType type>
+        constexpr std::size_t shifted_points() {
+            std::size_t count = 0;
+            for(const int offset : Stencil<type>::offsets) {
+                count += offset != 0;
+            }
+            return count;
+        }
+        template <DerivativeType type>
+        constexpr bool uses_center() {
+            return shifted_points<type>() != Stencil<type>::offsets.size();
+        }
+    }
+
+    /*
+     * f(x)の勾配を求める
+     * f(x)の評価回数は N * (標本点数) (Forward, Backwardでは N + 1) である。
+     *
+     * gradient(f, x);
+     * gradient<DerivativeType::FivePoints>(f, x, 1e-3, 4);
+     *
+     * 引数
+     * - f          : f(x) (Vector<N>を受け取りdoubleに変換可能な値を返す)
+     * - x          : 勾配を求める点
+     * - h          : 差分幅
+     * - threads    : 使用するスレッド数
+     */
+    template <DerivativeType type = DerivativeType::Central, std::size_t N, class F>
+    Vector<N> gradient(const F& f, const Vector<N>& x, const double& h = Constants::h, const std::size_t& threads = 1) {
+        using S = Stencil<type>;
+        const double step = h / S::steps_per_h;
+        const double scale = 1 / (S::divisor * h);
+        const double center = detail::uses_center<type>() ? static_cast<double>(f(x)) : 0;
+
+        Vector<N> result;
+        klibrary::parallel::parallel_for(0, N, threads, [&](const std::size_t& begin, const std::size_t& end) {
+            Vector<N> shifted = x;
+            for(std::size_t i = begin; i < end; ++i) {
+                double sum = 0;
+                for(std::size_t k = 0; k < S::offsets.size(); ++k) {
+                    if(S::offsets[k] == 0) {
+                        sum += S::weights[k] * center;
+                        continue;
+                    }
+                    shifted[i] = x[i] + S::offsets[k] * step;
+                    sum += S::weights[k] * static_cast<double>(f(shifted));
+                }
+                shifted[i] = x[i];
+                result[i] = scale * sum;
+            }
+        });
+        return result;
+    }
+
+    /*
+     * F(x)のヤコビ行列 J_ij = ∂F_i / ∂x_j を求める
+     * F(x)はStaticColVector<double, M>等のM個の要素を持つ状態を返し、結果はM x Nの行列である。
+     * 1回の評価でヤコビ行列の1列分の寄与が得られるため、F(x)の評価回数は勾配と同じである。
+     *
+     * 引数
+     * - f          : F(x)
+     * - x          : ヤコビ行列を求める点
+     * - h          : 差分幅
+     * - threads    : 使用するスレッド数
+     */
+    template <DerivativeType type = DerivativeType::Central, std::size_t N, class F>
+    auto jacobian(const F& f, const Vector<N>& x, const double& h = Constants::h, const std::size_t& threads = 1) {
+        using S = Stencil<type>;
+        using Result = std::remove_cvref_t<std::invoke_result_t<const F&, const Vector<N>&>>;
+        constexpr std::size_t M = state_size_v<Result>;
+        const double step = h / S::steps_per_h;
+        const double scale = 1 / (S::divisor * h);
+        Result center;
+        if constexpr(detail::uses_center<type>()) {
+            center = f(x);
+        }
+
+        klibrary::linear_algebra::StaticMatrixBase<double, M, N> result;
+        klibrary::parallel::parallel_for(0, N, threads, [&](const std::size_t& begin, const std::size_t& end) {
+            Vector<N> shifted = x;
+            for(std::size_t j = begin; j < end; ++j) {
+                for(std::size_t k = 0; k < S::offsets.size(); ++k) {
+                    const double w = S::weights[k] * scale;
+                    if(S::offsets[k] == 0) {
+                        for(std::size_t i = 0; i < M; ++i) {
+                            result(i, j) += w * center[i];
+                        }
+                        continue;
+                    }
+                    shifted[j] = x[j] + S::offsets[k] * step;
+                    const Result value = f(shifted);
+                    for(std::size_t i = 0; i < M; ++i) {
+                        result(i, j) += w * value[i];
+                    }
+                }
+                shifted[j] = x[j];
+            }
+        });
+        return result;
+    }
+
+    /*
+     * f(x)のヘッセ行列を2次精度の差分で求める
+     *
+     * 対角成分      : (f(x + h e_i) - 2 f(x) + f(x - h e_i)) / h^2
+     * 非対角成分    : (f(x + h e_i + h e_j) - f(x + h e_i) - f(x + h e_j) + 2 f(x)
+     *                  - f(x - h e_i) - f(x - h e_j) + f(x - h e_i - h e_j)) / (2 h^2)
+     *
+     * 非対角成分は対角成分の計算に用いるf(x)とf(x ± h e_i)を再利用するため、
+     * 座標軸の組ごとに新たに評価するのは2点のみであり、f(x)の評価回数は 1 + N + N^2 である
+     * (組ごとに4点を評価する通常の公式では 1 + 2N + 2N(N - 1))。結果は対称行列である。
+     *
+     * 引数
+     * - f          : f(x)
+     * - x          : ヘッセ行列を求める点
+     * - h          : 差分幅
+     * - threads    : 使用するスレッド数
+     */
+    template <std::size_t N, class F>
+    Jacobian<N> hessian(const F& f, const Vector<N>& x, const double& h = Constants::h, const std::size_t& threads = 1) {
+        const double center = f(x);
+        std::array<double, N> plus;
+        std::array<double, N> minus;
+        klibrary::parallel::parallel_for(0, N, threads, [&](const std::size_t& begin, const std::size_t& end) {
+            Vector<N> shifted = x;
+            for(std::size_t i = begin; i < end; ++i) {
+                shifted[i] = x[i] + h;
+                plus[i] = f(shifted);
+                shifted[i] = x[i] - h;
+                minus[i] = f(shifted);
+                shifted[i] = x[i];
+            }
+        });
+
+        Jacobian<N> result;
+        const double inverse_h2 = 1 / (h * h);
+        for(std::size_t i = 0; i < N; ++i) {
+            result(i, i) = (plus[i] - 2 * center + minus[i]) * inverse_h2;
+        }
+        // 上三角部分の組(i, j) (i < j) を行優先で番号付けし、番号について分割する
+        constexpr std::size_t pairs = N * (N - 1) / 2;
+        klibrary::parallel::parallel_for(0, pairs, threads, [&](const std::size_t& begin, const std::size_t& end) {
+            std::size_t i = 0;
+            std::size_t first = 0;
+            while(first + (N - 1 - i) <= begin) {
+                first += N - 1 - i;
+                ++i;
+            }
+            std::size_t j = i + 1 + (begin - first);
+            Vector<N> shifted = x;
+            for(std::size_t p = begin; p < end; ++p) {
+                shifted[i] = x[i] + h;
+                shifted[j] = x[j] + h;
+                const double forward = f(shifted);
+                shifted[i] = x[i] - h;
+                shifted[j] = x[j] - h;
+                const double backward = f(shifted);
+                shifted[i] = x[i];
+                shifted[j] = x[j];
+
+                const double value = (forward - plus[i] - plus[j] + 2 * center - minus[i] - minus[j] + backward) * inverse_h2 / 2;
+                result(i, j) = value;
+                result(j, i) = value;
+                if(++j == N) {
+                    ++i;
+                    j = i + 1;
+                }
+            }
+        });
+        return result;
+    }
+}
+#endif // multivariate_differentiation
@@ -1,97 +1,331 @@
 ﻿#ifndef numerical_differentiation
 #define numerical_differentiation
 #include <functional>
+#include <array>
+#include <span>
+#include <cstddef>
+#include <cassert>
+#include <algorithm>
+#include <cmath>
+#include <limits>
 #include "constants.hpp"
 namespace numerical_analysis {
+    // 数値微分の方法
+    enum class DerivativeType { Forward, Central, Backward, FivePoints, SevenPoints };
+
+    /*
+     * Stencil 構造体
+     *
+     * 各微分方法の差分公式をコンパイル時に定義する。
+     * 標本点は x + offsets[k] * (h / steps_per_h)、微分値は
+     *
+     * (1 / (divisor * h)) * Σ weights[k] * f(x + offsets[k] * (h / steps_per_h))
+     *
+     * で与えられる。offsetsは整数であり、等間隔格子上では隣接点間で標本を共有できる。
+     */
+    template <DerivativeType type>
+    struct Stencil;
+
+    template <>
+    struct Stencil<DerivativeType::Forward> {
+        static constexpr std::array<int, 2>     offsets     = {0, 1};
+        static constexpr std::array<double, 2>  weights     = {-1, 1};
+        static constexpr double                 divisor     = 1;
+        static constexpr double                 steps_per_h = 1;
+    };
+    template <>
+    struct Stencil<DerivativeType::Central> {
+        static constexpr std::array<int, 2>     offsets     = {-1, 1};
+        static constexpr std::array<double, 2>  weights     = {-1, 1};
+        static constexpr double                 divisor     = 1;
+        static constexpr double                 steps_per_h = 2;
+    };
+    template <>
+    struct Stencil<DerivativeType::Backward> {
+        static constexpr std::array<int, 2>     offsets     = {-1, 0};
+        static constexpr std::array<double, 2>  weights     = {-1, 1};
+        static constexpr double                 divisor     = 1;
+        static constexpr double                 steps_per_h = 1;
+    };
+    template <>
+    struct Stencil<DerivativeType::FivePoints> {
+        static constexpr std::array<int, 4>     offsets     = {-2, -1, 1, 2};
+        static constexpr std::array<double, 4>  weights     = {1, -8, 8, -1};
+        static constexpr double                 divisor     = 12;
+        static constexpr double                 steps_per_h = 1;
+    };
+    template <>
+    struct Stencil<DerivativeType::SevenPoints> {
+        static constexpr std::array<int, 6>     offsets     = {-3, -2, -1, 1, 2, 3};
+        static constexpr std::array<double, 6>  weights     = {-1, 9, -45, 45, -9, 1};
+        static constexpr double                 divisor     = 60;
+        static constexpr double                 steps_per_h = 1;
+    };
+
+    /*
+     * 適応的数値微分の結果
+     *
+     * - value          : 微分値
+     * - error          : 誤差の推定値
+     * - evaluations    : f(x)の評価回数
+     */
+    struct AdaptiveDerivativeResult {
+        double      value;
+        double      error;
+        std::size_t evaluations;
+    };
+
     /*
-     * Derivative クラス
-     * 
+     * BasicDerivative クラス
+     *
      * 使用法
      * 既に定義された関数f(x)についてその微分f'(x)を返す。
-     * 
+     *
      * Derivative(f).with_respect_to(x);
-     * 
+     *
      * f(x)は関数やラムダ式などにより定義することができ、例えばsin(x)の微分は
-     * 
+     *
      * const auto f = [](double x){ return std::sin(x); };
      * Derivative(f).with_respect_to(x);
-     * 
+     *
      * により求めることができる。
-     * 
+     *
+     * Derivativeはstd::function<double(double)>を保持するBasicDerivativeの別名である。
+     * BasicDerivative(f)のように記述すると関数オブジェクトの型そのものを保持するため、
+     * 関数呼び出しがインライン化される。
+     *
      * コンストラクタの第2引数で差分幅h(デフォルトでは0.1)を変更することができ。
      * with_respect_to()関数の第2引数で使用する微分方法(デフォルトでは中心差分法)を変更することができる。
-     * 微分方法はType列挙クラスにて定義されており、
-     * 
+     * 微分方法はDerivativeType列挙クラス(Type)にて定義されており、
+     *
      * - 前進差分法 (Type::Forward)
      * - 後退差分法 (Type::Backward)
      * - 中心差分法 (Type::Central)
      * - 5点公式 (Type::FivePoints)
      * - 7点公式 (Type::SevenPoints)
-     * 
+     *
      * から選択することができる。
-     * 
+     *
      * 例えば、差分幅を0.01、微分を5点公式により行うのであれば
-     * 
+     *
      * Derivative(f, 0.01).with_respect_to(x, Derivative::Type::FivePoints);
-     * 
-     * のように記述する。5点公式および7点公式の導出は以下のサイト参考
+     *
+     * のように記述する。微分方法をテンプレート引数で指定するとコンパイル時に公式が選択される。
+     *
+     * BasicDerivative(f, 0.01).with_respect_to<DerivativeType::FivePoints>(x);
+     *
+     * 5点公式および7点公式の導出は以下のサイト参考
      * https://wwwnucl.ph.tsukuba.ac.jp/~hinohara/compphys2-18/doc/compphys2-5.pdf
+     *
+     * 複数点での微分
+     *
+     * with_respect_to(xs, out, type)はxsの各点での微分値をoutに書き込む。
+     * 点を8個ずつのブロックにまとめ、差分公式の標本点ごとにブロック内の全点を評価する。
+     *
+     * on_uniform_grid(x0, dx, out, type)は等間隔格子x0 + j * dx (j = 0, 1, ..., out.size() - 1)
+     * 上の微分値をoutに書き込む。差分幅は格子間隔から決まり(中心差分法ではh = 2dx、その他ではh = dx)、
+     * 隣接点間で共有される標本は一度だけ評価される。
+     *
+     * 適応的微分
+     *
+     * adaptive(x, tolerance)はRidders法(中心差分のRichardson補外)により差分幅を自動で選択し、
+     * 微分値と誤差の推定値、fの評価回数を返す。差分幅はコンストラクタのhから始めて1/2ずつ縮小する。
+     *
+     * Derivative(f).adaptive(x, 1e-10);
+     *
+     * 誤差の推定値がtoleranceを下回らないまま丸め誤差が支配的になった場合は、
+     * 初期差分幅を1/2にして補外をやり直す。このとき既に評価した標本点は再評価しない。
      */
-    class Derivative {
+    template <class F = std::function<double(double)>>
+    class BasicDerivative {
         private:
-            const std::function<double(double)> f_;
+            const F f_;
             const double h_;
 
-            // 前進差分法
-            double forward(const double& x) const noexcept {
-                return (1 / h_) * (f_(x + h_) - f_(x));
-            }
-            // 中心差分法
-            double central(const double& x) const noexcept {
-                return (1 / h_) * (f_(x + h_ / 2) - f_(x - h_ / 2));
-            }
-            // 後退差分法
-            double backward(const double& x) const noexcept {
-                return (1 / h_) * (f_(x) - f_(x - h_));
-            }
-            // 5点公式
-            double five_points(const double& x) const noexcept {
-                return (1 / (12 * h_)) * (f_(x - 2 * h_) - 8 * f_(x - h_) + 8 * f_(x + h_) - f_(x + 2 * h_));
-            }
-            // 7点公式
-            double seven_points(const double& x) const noexcept {
-                return (1 / (60 * h_)) * (
-                    -f_(x - 3 * h_) + 9 * f_(x - 2 * h_) - 45 * f_(x - h_) +
-                    45 * f_(x + h_) - 9 * f_(x + 2 * h_) + f_(x + 3 * h_)
-                );
-            }
+            // 1ブロックあたりの点数
+            static constexpr std::size_t block_size_ = 8;
+            // 等間隔格子での1タイルあたりの点数
+            static constexpr std::size_t tile_size_ = 256;
+            // 適応的微分で縮小する差分幅の段数
+            static constexpr std::size_t adaptive_levels_ = 16;
         public:
-            // f: 数値微分を行う関数, h: 差分幅
-            Derivative(const std::function<double(double)>& f, const double h = Constants::h) noexcept : f_(f), h_(h){}
             // 数値微分の方法
-            enum class Type { Forward, Central, Backward, FivePoints, SevenPoints };
+            using Type = DerivativeType;
+
+            // f: 数値微分を行う関数, h: 差分幅
+            BasicDerivative(const F& f, const double h = Constants::h) noexcept : f_(f), h_(h){}
+
             // xについてtypeの微分方法を用いて微分する
-            double with_respect_to(const double& x, const Type type = Type::Central) {
+            template <Type type>
+            double with_respect_to(const double& x) const {
+                using S = Stencil<type>;
+                const double step = h_ / S::steps_per_h;
+                double sum = 0;
+                for(std::size_t k = 0; k < S::offsets.size(); ++k) {
+                    sum += S::weights[k] * f_(x + S::offsets[k] * step);
+                }
+                return (1 / (S::divisor * h_)) * sum;
+            }
+            double with_respect_to(const double& x, const Type type = Type::Central) const {
                 switch(type) {
                 case Type::Forward:
-                    return forward(x);
+                    return with_respect_to<Type::Forward>(x);
                     break;
                 case Type::Central:
-                    return central(x);
+                    return with_respect_to<Type::Central>(x);
                     break;
                 case Type::Backward:
-                    return backward(x);
+                    return with_respect_to<Type::Backward>(x);
                     break;
                 case Type::FivePoints:
-                    return five_points(x);
+                    return with_respect_to<Type::FivePoints>(x);
                     break;
                 case Type::SevenPoints:
-                    return seven_points(x);
+                    return with_respect_to<Type::SevenPoints>(x);
                     break;
                 default:
                     return x;
                 }
             }
+
+            // xsの各点についてtypeの微分方法を用いて微分し、outに書き込む
+            template <Type type>
+            void with_respect_to(std::span<const double> xs, std::span<double> out) const {
+                assert(xs.size() == out.size());
+                using S = Stencil<type>;
+                const double step = h_ / S::steps_per_h;
+                const double scale = 1 / (S::divisor * h_);
+
+                for(std::size_t i = 0; i < xs.size(); i += block_size_) {
+                    const std::size_t m = std::min(block_size_, xs.size() - i);
+                    std::array<double, block_size_> sum{};
+                    for(std::size_t k = 0; k < S::offsets.size(); ++k) {
+                        const double offset = S::offsets[k] * step;
+                        for(std::size_t l = 0; l < m; ++l) {
+                            sum[l] += S::weights[k] * f_(xs[i + l] + offset);
+                        }
+                    }
+                    for(std::size_t l = 0; l < m; ++l) {
+                        out[i + l] = scale * sum[l];
+                    }
+                }
+            }
+            void with_respect_to(std::span<const double> xs, std::span<double> out, const Type type = Type::Central) const {
+                switch(type) {
+                case Type::Forward:
+                    return with_respect_to<Type::Forward>(xs, out);
+                case Type::Central:
+                    return with_respect_to<Type::Central>(xs, out);
+                case Type::Backward:
+                    return with_respect_to<Type::Backward>(xs, out);
+                case Type::FivePoints:
+                    return with_respect_to<Type::FivePoints>(xs, out);
+                case Type::SevenPoints:
+                    return with_respect_to<Type::SevenPoints>(xs, out);
+                }
+            }
+
+            // xについて差分幅を自動で選択して微分する (toleranceは誤差の推定値の目標値)
+            AdaptiveDerivativeResult adaptive(const double& x, const double& tolerance = Constants::epsilon) const {
+                // 差分幅h / 2^kでの中心差分と、その標本
+                std::array<std::array<double, 2>, adaptive_levels_> samples;
+                std::array<bool, adaptive_levels_> sampled{};
+                std::size_t evaluations = 0;
+                const auto central = [&](const std::size_t& k) {
+                    const double step = std::ldexp(h_, -static_cast<int>(k));
+                    if(!sampled[k]) {
+                        samples[k] = {f_(x + step), f_(x - step)};
+                        sampled[k] = true;
+                        evaluations += 2;
+                    }
+                    return (samples[k][0] - samples[k][1]) / (2 * step);
+                };
+
+                AdaptiveDerivativeResult best = {std::numeric_limits<double>::quiet_NaN(), std::numeric_limits<double>::infinity(), 0};
+                std::array<std::array<double, adaptive_levels_>, adaptive_levels_> tableau;
+                for(std::size_t start = 0; start + 1 < adaptive_levels_; ++start) {
+                    AdaptiveDerivativeResult current = {std::numeric_limits<double>::quiet_NaN(), std::numeric_limits<double>::infinity(), 0};
+                    tableau[0][0] = central(start);
+                    for(std::size_t i = 1; start + i < adaptive_levels_; ++i) {
+                        tableau[i][0] = central(start + i);
+                        double factor = 4;
+                        for(std::size_t j = 1; j <= i; ++j) {
+                            tableau[i][j] = (factor * tableau[i][j - 1] - tableau[i - 1][j - 1]) / (factor - 1);
+                            factor *= 4;
+                            const double error = std::max(
+                                std::abs(tableau[i][j] - tableau[i][j - 1]),
+                                std::abs(tableau[i][j] - tableau[i - 1][j - 1])
+                            );
+                            if(error <= current.error) {
+                                current.value = tableau[i][j];
+                                current.error = error;
+                            }
+                        }
+                        // 誤差が目標値を下回ったか、丸め誤差により対角要素の差が広がり始めたら終了
+                        if(current.error <= tolerance || std::abs(tableau[i][i] - tableau[i - 1][i - 1]) >= 2 * current.error) {
+                            break;
+                        }
+                    }
+                    if(current.error < best.error) {
+                        best = current;
+                    }
+                    if(best.error <= tolerance) {
+                        break;
+                    }
+                }
+                best.evaluations = evaluations;
+                return best;
+            }
+
+            // 等間隔格子x0 + j * dx上でtypeの微分方法を用いて微分し、outに書き込む (差分幅hは使用しない)
+            template <Type type>
+            void on_uniform_grid(const double& x0, const double& dx, std::span<double> out) const {
+                using S = Stencil<type>;
+                constexpr int first = S::offsets.front();
+                constexpr int last  = S::offsets.back();
+                constexpr std::size_t halo = static_cast<std::size_t>(last - first);
+                const double scale = 1 / (S::divisor * dx * S::steps_per_h);
+
+                // samples[s]はf(x0 + (begin + s + first) * dx)
+                std::array<double, tile_size_ + halo> samples;
+                std::size_t sampled = 0;
+                for(std::size_t begin = 0; begin < out.size(); begin += tile_size_) {
+                    const std::size_t m = std::min(tile_size_, out.size() - begin);
+                    // 前のタイルと重なる標本は再利用する
+                    if(begin != 0) {
+                        std::copy(samples.begin() + tile_size_, samples.begin() + tile_size_ + halo, samples.begin());
+                        sampled = halo;
+                    }
+                    for(std::size_t s = sampled; s < m + halo; ++s) {
+                        const auto j = static_cast<double>(static_cast<long long>(begin + s) + first);
+                        samples[s] = f_(x0 + j * dx);
+                    }
+                    for(std::size_t l = 0; l < m; ++l) {
+                        double sum = 0;
+                        for(std::size_t k = 0; k < S::offsets.size(); ++k) {
+                            sum += S::weights[k] * samples[l + static_cast<std::size_t>(S::offsets[k] - first)];
+                        }
+                        out[begin + l] = scale * sum;
+                    }
+                }
+            }
+            void on_uniform_grid(const double& x0, const double& dx, std::span<double> out, const Type type = Type::Central) const {
+                switch(type) {
+                case Type::Forward:
+                    return on_uniform_grid<Type::Forward>(x0, dx, out);
+                case Type::Central:
+                    return on_uniform_grid<Type::Central>(x0, dx, out);
+                case Type::Backward:
+                    return on_uniform_grid<Type::Backward>(x0, dx, out);
+                case Type::FivePoints:
+                    return on_uniform_grid<Type::FivePoints>(x0, dx, out);
+                case Type::SevenPoints:
+                    return on_uniform_grid<Type::SevenPoints>(x0, dx, out);
+                }
+            }
     };
+
+    // std::function<double(double)>を保持する数値微分クラス
+    using Derivative = BasicDerivative<std::function<double(double)>>;
 }
-#endif // numerical_differentiation
+#endif // numerical_differentiation
\ No newline at end of file
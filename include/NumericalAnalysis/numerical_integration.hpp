@@ -0,0 +1,261 @@
+#ifndef numerical_integration
+#define numerical_integration
+#include <array>
+#include <queue>
+#include <vector>
+#include <cmath>
+#include <cstddef>
+#include <algorithm>
+#include "constants.hpp"
+#include "solver_status.hpp"
+#include "./../Parallel/parallel_for.hpp"
+namespace numerical_analysis {
+    // Gauss-Kronrod求積則
+    enum class GaussKronrodRule { G7K15, G10K21 };
+
+    /*
+     * GaussKronrodNodes 構造体
+     *
+     * [-1, 1]上のKronrod点の非負側(降順、最後が0)と、その重みおよび埋め込まれたGauss則の重みを定義する。
+     * Gauss点はKronrod点のうち奇数番目(1, 3, 5, ...)である。
+     * 値はQUADPACK(qk15, qk21)による。
+     */
+    template <GaussKronrodRule rule>
+    struct GaussKronrodNodes;
+
+    template <>
+    struct GaussKronrodNodes<GaussKronrodRule::G7K15> {
+        static constexpr std::array<double, 8> nodes = {
+            0.991455371120812639206854697526329, 0.949107912342758524526189684047851,
+            0.864864423359769072789712788640926, 0.741531185599394439863864773280788,
+            0.586087235467691130294144845693013, 0.405845151377397166906606412076961,
+            0.207784955007898467600689403773245, 0.000000000000000000000000000000000
+        };
+        static constexpr std::array<double, 8> kronrod_weights = {
+            0.022935322010529224963732008058970, 0.063092092629978553290700663189204,
+            0.104790010322250183839876322541518, 0.140653259715525918745189590510238,
+            0.169004726639267902826583426598550, 0.190350578064785409913256402421014,
+            0.204432940075298892414161999234649, 0.209482141084727828012999174891714
+        };
+        static constexpr std::array<double, 8> gauss_weights = {
+            0, 0.129484966168869693270611432679082,
+            0, 0.279705391489276667901467771423780,
+            0, 0.381830050505118944950369775488975,
+            0, 0.417959183673469387755102040816327
+        };
+    };
+    template <>
+    struct GaussKronrodNodes<GaussKronrodRule::G10K21> {
+        static constexpr std::array<double, 11> nodes = {
+            0.995657163025808080735527280689003, 0.973906528517171720077964012084452,
+            0.930157491355708226001207180059508, 0.865063366688984510732096688423493,
+            0.780817726586416897063717578345042, 0.679409568299024406234327365114874,
+            0.562757134668604683339000099272694, 0.433395394129247190799265943165784,
+            0.294392862701460198131126603103866, 0.148874338981631210884826001129720,
+            0.000000000000000000000000000000000
+        };
+        static constexpr std::array<double, 11> kronrod_weights = {
+            0.011694638867371874278064396062192, 0.032558162307964727478818972459390,
+            0.054755896574351996031381300244580, 0.075039674810919952767043140916190,
+            0.093125454583697605535065465083366, 0.109387158802297641899210590325805,
+            0.123491976262065851077600938624016, 0.134709217311473325928054001771707,
+            0.142775938577060080797094273138717, 0.147739104901338491374841515972068,
+            0.149445554002916905664936468389821
+        };
+        static constexpr std::array<double, 11> gauss_weights = {
+            0, 0.066671344308688137593568809893332,
+            0, 0.149451349150580593145776339657697,
+            0, 0.219086362515982043995534934228163,
+            0, 0.269266719309996355091226921569469,
+            0, 0.295524224714752870173892994651338,
+            0
+        };
+    };
+
+    /*
+     * 数値積分の結果
+     *
+     * - value          : 積分値
+     * - error          : 誤差の推定値 (各区間のKronrod則とGauss則の差の和)
+     * - status         : 終了状態 (最大分割数に達した場合はMaxAttemptsReached)
+     * - evaluations    : f(x)の評価回数
+     * - subdivisions   : 区間の分割回数
+     */
+    struct IntegrationResult {
+        double          value;
+        double          error;
+        SolverStatus    status;
+        std::size_t     evaluations;
+        std::size_t     subdivisions;
+    };
+
+    namespace detail {
+        struct IntegrationSegment {
+            double l;
+            double r;
+            double value;
+            double error;
+            friend bool operator<(const IntegrationSegment& lhs, const IntegrationSegment& rhs) {
+                return lhs.error < rhs.error;
+            }
+        };
+
+        // [l, r]に求積則を適用する。全ての標本点を先にまとめて評価してから重み付き和をとる
+        template <GaussKronrodRule rule, class F>
+        IntegrationSegment gauss_kronrod_panel(const F& f, const double& l, const double& r) {
+            using Nodes = GaussKronrodNodes<rule>;
+            constexpr std::size_t K = Nodes::nodes.size();
+            const double center = (l + r) / 2;
+            const double half   = (r - l) / 2;
+
+            std::array<double, K> lower;
+            std::array<double, K> upper;
+            for(std::size_t k = 0; k + 1 < K; ++k) {
+                lower[k] = f(center - half * Nodes::nodes[k]);
+                upper[k] = f(center + half * Nodes::nodes[k]);
+            }
+            lower[K - 1] = f(center);
+            upper[K - 1] = 0;
+
+            double kronrod = 0;
+            double gauss = 0;
+            for(std::size_t k = 0; k < K; ++k) {
+                const double sum = lower[k] + upper[k];
+                kronrod += Nodes::kronrod_weights[k] * sum;
+                gauss   += Nodes::gauss_weights[k] * sum;
+            }
+            return {l, r, kronrod * half, std::abs((kronrod - gauss) * half)};
+        }
+
+        // [a, b]を誤差の大きい区間から順に二等分する適応積分
+        template <GaussKronrodRule rule, class F>
+        IntegrationResult adaptive_gauss_kronrod(
+            const F& f,
+            const double& a,
+            const double& b,
+            const double& tolerance,
+            const std::size_t& max_subdivisions
+        ) {
+            constexpr std::size_t evaluations_per_panel = 2 * GaussKronrodNodes<rule>::nodes.size() - 1;
+            std::priority_queue<IntegrationSegment> segments;
+            segments.push(gauss_kronrod_panel<rule>(f, a, b));
+            IntegrationResult result = {segments.top().value, segments.top().error, SolverStatus::Converged, evaluations_per_panel, 0};
+
+            while(result.error > tolerance) {
+                if(result.subdivisions == max_subdivisions) {
+                    result.status = SolverStatus::MaxAttemptsReached;
+                    break;
+                }
+                const IntegrationSegment worst = segments.top();
+                segments.pop();
+                const double m = (worst.l + worst.r) / 2;
+                const IntegrationSegment left  = gauss_kronrod_panel<rule>(f, worst.l, m);
+                const IntegrationSegment right = gauss_kronrod_panel<rule>(f, m, worst.r);
+                result.value += left.value + right.value - worst.value;
+                result.error += left.error + right.error - worst.error;
+                result.evaluations += 2 * evaluations_per_panel;
+                ++result.subdivisions;
+                segments.push(left);
+                segments.push(right);
+            }
+            // 逐次更新による丸め誤差を避けるため最後に総和をとり直す
+            result.value = 0;
+            result.error = 0;
+            while(!segments.empty()) {
+                result.value += segments.top().value;
+                result.error += segments.top().error;
+                segments.pop();
+            }
+            return result;
+        }
+    }
+
+    /*
+     * [a, b]についてf(x)の定積分を適応Gauss-Kronrod求積により求める
+     *
+     * 誤差の推定値が最大の区間を優先度付きキューから取り出して二等分することを、
+     * 誤差の推定値の総和がtoleranceを下回るまで繰り返す。
+     * 各区間では全ての標本点をまとめて評価してから重み付き和をとる。
+     *
+     * threadsに2以上(0の場合はハードウェアの並列数)を指定すると、[a, b]をスレッド数で等分し、
+     * 各部分区間を独立に適応積分する。許容誤差と最大分割数は最初は部分区間に等しく配分される。
+     * 収束しなかった部分区間がある場合は、収束した部分区間で使われなかった分割回数と許容誤差をそれらに配分し直し、
+     * 先頭から積分し直す (評価回数には積分し直す前の評価も含まれる)。
+     * 部分区間の結果は添え字の順に足し合わせるため、結果はスレッドの実行順序によらない。
+     *
+     * integrate(f, 0.0, 1.0);
+     * integrate<GaussKronrodRule::G10K21>(f, 0.0, 1.0, 1e-12);
+     *
+     * 引数
+     * - f                  : f(x) (threadsが2以上の場合は複数のスレッドから同時に呼び出される)
+     * - a                  : 積分範囲の下端
+     * - b                  : 積分範囲の上端
+     * - tolerance          : 許容する誤差の推定値 (絶対誤差)
+     * - max_subdivisions   : 最大分割回数
+     * - threads            : 使用するスレッド数
+     */
+    template <GaussKronrodRule rule = GaussKronrodRule::G7K15, class F>
+    IntegrationResult integrate(
+        const F& f,
+        const double& a,
+        const double& b,
+        const double& tolerance             = Constants::epsilon,
+        const std::size_t& max_subdivisions = 1000,
+        const std::size_t& threads          = 1
+    ) {
+        const std::size_t pieces = std::max<std::size_t>(1, std::min(klibrary::parallel::thread_count(threads), max_subdivisions));
+        if(pieces == 1) {
+            return detail::adaptive_gauss_kronrod<rule>(f, a, b, tolerance, max_subdivisions);
+        }
+
+        const double width = (b - a) / static_cast<double>(pieces);
+        const auto lower = [&](const std::size_t& i) { return a + static_cast<double>(i) * width; };
+        const auto upper = [&](const std::size_t& i) { return (i + 1 == pieces) ? b : a + static_cast<double>(i + 1) * width; };
+        std::vector<IntegrationResult> parts(pieces);
+        klibrary::parallel::parallel_for(0, pieces, pieces, [&](const std::size_t& begin, const std::size_t& end) {
+            for(std::size_t i = begin; i < end; ++i) {
+                parts[i] = detail::adaptive_gauss_kronrod<rule>(f, lower(i), upper(i), tolerance / static_cast<double>(pieces), max_subdivisions / pieces);
+            }
+        });
+
+        // 収束しなかった部分区間に、収束した部分区間の残りの分割回数と許容誤差を配分して積分し直す
+        std::vector<std::size_t> failed;
+        std::size_t used = 0;
+        double converged_error = 0;
+        for(std::size_t i = 0; i < pieces; ++i) {
+            if(parts[i].status == SolverStatus::Converged) {
+                used += parts[i].subdivisions;
+                converged_error += parts[i].error;
+            } else {
+                failed.push_back(i);
+            }
+        }
+        if(!failed.empty()) {
+            const std::size_t budget = (max_subdivisions - used) / failed.size();
+            const double remaining = std::max(tolerance - converged_error, 0.0) / static_cast<double>(failed.size());
+            if(budget > max_subdivisions / pieces) {
+                klibrary::parallel::parallel_for(0, failed.size(), failed.size(), [&](const std::size_t& begin, const std::size_t& end) {
+                    for(std::size_t j = begin; j < end; ++j) {
+                        const std::size_t i = failed[j];
+                        const std::size_t evaluations = parts[i].evaluations;
+                        parts[i] = detail::adaptive_gauss_kronrod<rule>(f, lower(i), upper(i), remaining, budget);
+                        parts[i].evaluations += evaluations;
+                    }
+                });
+            }
+        }
+
+        IntegrationResult result = {0, 0, SolverStatus::Converged, 0, 0};
+        for(const auto& part : parts) {
+            result.value += part.value;
+            result.error += part.error;
+            result.evaluations += part.evaluations;
+            result.subdivisions += part.subdivisions;
+            if(part.status != SolverStatus::Converged) {
+                result.status = part.status;
+            }
+        }
+        return result;
+    }
+}
+#endif // numerical_integration
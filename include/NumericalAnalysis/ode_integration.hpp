@@ -0,0 +1,539 @@
+#ifndef ode_integration
+#define ode_integration
+#include <span>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cassert>
+#include <utility>
+#include <algorithm>
+#include "solver_status.hpp"
+#include "state_size.hpp"
+#include "batch_root_finding.hpp"
+#include "./../Parallel/parallel_for.hpp"
+#include "./../LinearAlgebra/StaticMatrix/Base/staticmatrix_base.hpp"
+#include "./../LinearAlgebra/StaticMatrix/Vector/staticvector.hpp"
+namespace numerical_analysis {
+    /*
+     * DormandPrinceTableau 構造体
+     *
+     * Dormand-Prince法(5次解と4次の誤差推定、FSAL)の係数と、Hairerらによる4次の密出力の係数を定義する。
+     * - c      : 各段の時刻
+     * - aij    : 各段の係数 (a7jは5次解の重みと一致する)
+     * - ej     : 5次解と4次解の重みの差
+     * - dj     : 密出力の係数
+     */
+    struct DormandPrinceTableau {
+        static constexpr std::array<double, 7> c = {0.0, 1.0 / 5, 3.0 / 10, 4.0 / 5, 8.0 / 9, 1.0, 1.0};
+
+        static constexpr double a21 = 1.0 / 5;
+        static constexpr double a31 = 3.0 / 40,         a32 = 9.0 / 40;
+        static constexpr double a41 = 44.0 / 45,        a42 = -56.0 / 15,       a43 = 32.0 / 9;
+        static constexpr double a51 = 19372.0 / 6561,   a52 = -25360.0 / 2187,  a53 = 64448.0 / 6561,   a54 = -212.0 / 729;
+        static constexpr double a61 = 9017.0 / 3168,    a62 = -355.0 / 33,      a63 = 46732.0 / 5247,   a64 = 49.0 / 176,   a65 = -5103.0 / 18656;
+        static constexpr double a71 = 35.0 / 384,       a73 = 500.0 / 1113,     a74 = 125.0 / 192,      a75 = -2187.0 / 6784,   a76 = 11.0 / 84;
+
+        static constexpr double e1 = 71.0 / 57600,      e3 = -71.0 / 16695,     e4 = 71.0 / 1920;
+        static constexpr double e5 = -17253.0 / 339200, e6 = 22.0 / 525,        e7 = -1.0 / 40;
+
+        static constexpr double d1 = -12715105075.0 / 11282082432,  d3 = 87487479700.0 / 32700410799;
+        static constexpr double d4 = -10690763975.0 / 1880347072,   d5 = 701980252875.0 / 199316789632;
+        static constexpr double d6 = -1453857185.0 / 822651844,     d7 = 69997945.0 / 29380423;
+
+        // 誤差に応じた刻み幅の倍率の範囲と安全係数
+        static constexpr double safety      = 0.9;
+        static constexpr double min_factor  = 0.2;
+        static constexpr double max_factor  = 10.0;
+    };
+
+    /*
+     * 常微分方程式の求解結果
+     *
+     * - y                  : 終端での状態
+     * - status             : 終了状態 (最大ステップ数に達した場合はMaxAttemptsReached、
+     *                        刻み幅が小さくなりすぎた場合や状態が有限でなくなった場合はDiverged)
+     * - steps              : 受理されたステップ数
+     * - rejected_steps     : 棄却されたステップ数
+     * - evaluations        : f(t, y)の評価回数
+     */
+    template <class State>
+    struct OdeResult {
+        State           y;
+        SolverStatus    status;
+        std::size_t     steps;
+        std::size_t     rejected_steps;
+        std::size_t     evaluations;
+    };
+
+    namespace detail {
+        // 相対誤差rtol、絶対誤差atolで重み付けした二乗平均平方根ノルム
+        template <class State>
+        double ode_error_norm(const State& error, const State& y, const State& y_next, const double& rtol, const double& atol) {
+            constexpr std::size_t N = state_size_v<State>;
+            double sum = 0;
+            for(std::size_t i = 0; i < N; ++i) {
+                const double scale = atol + rtol * std::max(std::abs(y[i]), std::abs(y_next[i]));
+                const double ratio = error[i] / scale;
+                sum += ratio * ratio;
+            }
+            return std::sqrt(sum / N);
+        }
+
+        // 初期刻み幅の推定 (Hairer, Nørsett, Wanner)。f(t, y)を1回評価する
+        template <class State, class F>
+        double ode_initial_step(
+            const F& f,
+            const double& t,
+            const State& y,
+            const State& dy,
+            const double& rtol,
+            const double& atol,
+            const double& max_step,
+            State& scratch
+        ) {
+            constexpr std::size_t N = state_size_v<State>;
+            double dny = 0;
+            double dnf = 0;
+            for(std::size_t i = 0; i < N; ++i) {
+                const double scale = atol + rtol * std::abs(y[i]);
+                dny += (y[i] / scale) * (y[i] / scale);
+                dnf += (dy[i] / scale) * (dy[i] / scale);
+            }
+            double h = (dnf <= 1e-10 || dny <= 1e-10) ? 1e-6 : 0.01 * std::sqrt(dny / dnf);
+            h = std::min(h, max_step);
+
+            for(std::size_t i = 0; i < N; ++i) {
+                scratch[i] = y[i] + h * dy[i];
+            }
+            const State dy_next = f(t + h, scratch);
+            double der2 = 0;
+            for(std::size_t i = 0; i < N; ++i) {
+                const double scale = atol + rtol * std::abs(y[i]);
+                der2 += ((dy_next[i] - dy[i]) / scale) * ((dy_next[i] - dy[i]) / scale);
+            }
+            const double der12 = std::max(std::sqrt(der2) / h, std::sqrt(dnf));
+            const double h1 = der12 <= 1e-15 ? std::max(1e-6, h * 1e-3) : std::pow(0.01 / der12, 1.0 / 5);
+            return std::min({100 * h, h1, max_step});
+        }
+
+        // 誤差のノルムから次の刻み幅の倍率を求める
+        inline double ode_step_factor(const double& norm, const bool& accepted) {
+            using T = DormandPrinceTableau;
+            const double factor = std::max(T::min_factor, T::safety * std::pow(norm, -1.0 / 5));
+            return std::min(factor, accepted ? T::max_factor : 1.0);
+        }
+    }
+
+    /*
+     * DormandPrince45 クラス
+     *
+     * Dormand-Prince法(RK45)による適応刻み幅の常微分方程式 dy/dt = f(t, y) のソルバ。
+     * 状態yはStaticColVector<double, N>、StaticRowVector<double, N>またはStaticMatrixBase<double, R, C>で表し、
+     * f(t, y)はStateに変換可能な値を返す。
+     *
+     * - 段の計算は要素ごとのループで行い、ベクトル演算の一時オブジェクトを生成しない
+     * - 全ての作業領域はメンバとして保持されるため、ステップごとのヒープ確保は行わない
+     * - 最終段の評価値を次のステップの初段として再利用する(FSAL)ため、受理されたステップあたりのf(t, y)の評価は6回である
+     * - 直前のステップの区間内の任意の時刻の状態を、4次の密出力により追加の評価なしに求められる
+     *
+     * DormandPrince45 solver(f, 0.0, y0, 1e-8, 1e-10);
+     * while(solver.t() < 10.0) {
+     *     solver.step(10.0);
+     *     solver.dense_output(...);
+     * }
+     *
+     * 引数
+     * - f              : f(t, y)
+     * - t0             : 初期時刻
+     * - y0             : 初期状態
+     * - rtol           : 相対許容誤差
+     * - atol           : 絶対許容誤差
+     * - initial_step   : 初期刻み幅 (0の場合は自動で推定する)
+     */
+    template <class State, class F>
+    class DormandPrince45 {
+        private:
+            static constexpr std::size_t N = state_size_v<State>;
+            using Tableau = DormandPrinceTableau;
+
+            F f_;
+            double rtol_;
+            double atol_;
+            double t_;
+            double h_;
+            double t_old_;
+            double h_old_;
+            State y_;
+            State y_next_;
+            State stage_;
+            std::array<State, 7> k_;
+            // 密出力の係数
+            std::array<State, 5> dense_;
+            std::size_t steps_;
+            std::size_t rejected_steps_;
+            std::size_t evaluations_;
+            bool failed_;
+
+            void prepare_dense_output(const double& h) {
+                using T = Tableau;
+                for(std::size_t i = 0; i < N; ++i) {
+                    const double diff = this->y_next_[i] - this->y_[i];
+                    const double bspl = h * this->k_[0][i] - diff;
+                    this->dense_[0][i] = this->y_[i];
+                    this->dense_[1][i] = diff;
+                    this->dense_[2][i] = bspl;
+                    this->dense_[3][i] = diff - h * this->k_[6][i] - bspl;
+                    this->dense_[4][i] = h * (T::d1 * this->k_[0][i] + T::d3 * this->k_[2][i] + T::d4 * this->k_[3][i]
+                                            + T::d5 * this->k_[4][i] + T::d6 * this->k_[5][i] + T::d7 * this->k_[6][i]);
+                }
+            }
+        public:
+            DormandPrince45(
+                const F& f,
+                const double& t0,
+                const State& y0,
+                const double& rtol          = 1e-6,
+                const double& atol          = 1e-9,
+                const double& initial_step  = 0
+            ) : f_(f), rtol_(rtol), atol_(atol), t_(t0), h_(initial_step), t_old_(t0), h_old_(0), y_(y0),
+                steps_(0), rejected_steps_(0), evaluations_(1), failed_(false) {
+                this->k_[0] = this->f_(this->t_, this->y_);
+                for(auto& coefficient : this->dense_) {
+                    coefficient = y0;
+                }
+            }
+
+            /*
+             * t_endを超えない範囲で1ステップ進める
+             * 誤差が許容誤差を超えた場合は刻み幅を縮めて同じステップをやり直す。
+             * 刻み幅が時刻に対して小さくなりすぎた場合、または状態が有限でなくなった場合はfalseを返す。
+             */
+            bool step(const double& t_end) {
+                using T = Tableau;
+                if(this->failed_) {
+                    return false;
+                }
+                if(!(this->t_ < t_end)) {
+                    return true;
+                }
+                if(this->h_ <= 0) {
+                    this->h_ = detail::ode_initial_step(this->f_, this->t_, this->y_, this->k_[0], this->rtol_, this->atol_, t_end - this->t_, this->stage_);
+                    ++this->evaluations_;
+                }
+
+                auto& k = this->k_;
+                const double t = this->t_;
+                const State& y = this->y_;
+                bool rejected = false;
+                while(true) {
+                    const double h = std::min(this->h_, t_end - t);
+                    if(!(h > std::abs(t) * 1e-14) || !std::isfinite(h)) {
+                        this->failed_ = true;
+                        return false;
+                    }
+
+                    for(std::size_t i = 0; i < N; ++i) {
+                        this->stage_[i] = y[i] + h * (T::a21 * k[0][i]);
+                    }
+                    k[1] = this->f_(t + T::c[1] * h, this->stage_);
+                    for(std::size_t i = 0; i < N; ++i) {
+                        this->stage_[i] = y[i] + h * (T::a31 * k[0][i] + T::a32 * k[1][i]);
+                    }
+                    k[2] = this->f_(t + T::c[2] * h, this->stage_);
+                    for(std::size_t i = 0; i < N; ++i) {
+                        this->stage_[i] = y[i] + h * (T::a41 * k[0][i] + T::a42 * k[1][i] + T::a43 * k[2][i]);
+                    }
+                    k[3] = this->f_(t + T::c[3] * h, this->stage_);
+                    for(std::size_t i = 0; i < N; ++i) {
+                        this->stage_[i] = y[i] + h * (T::a51 * k[0][i] + T::a52 * k[1][i] + T::a53 * k[2][i] + T::a54 * k[3][i]);
+                    }
+                    k[4] = this->f_(t + T::c[4] * h, this->stage_);
+                    for(std::size_t i = 0; i < N; ++i) {
+                        this->stage_[i] = y[i] + h * (T::a61 * k[0][i] + T::a62 * k[1][i] + T::a63 * k[2][i] + T::a64 * k[3][i] + T::a65 * k[4][i]);
+                    }
+                    k[5] = this->f_(t + h, this->stage_);
+                    for(std::size_t i = 0; i < N; ++i) {
+                        this->y_next_[i] = y[i] + h * (T::a71 * k[0][i] + T::a73 * k[2][i] + T::a74 * k[3][i] + T::a75 * k[4][i] + T::a76 * k[5][i]);
+                    }
+                    k[6] = this->f_(t + h, this->y_next_);
+                    this->evaluations_ += 6;
+
+                    for(std::size_t i = 0; i < N; ++i) {
+                        this->stage_[i] = h * (T::e1 * k[0][i] + T::e3 * k[2][i] + T::e4 * k[3][i] + T::e5 * k[4][i] + T::e6 * k[5][i] + T::e7 * k[6][i]);
+                    }
+                    const double norm = detail::ode_error_norm(this->stage_, y, this->y_next_, this->rtol_, this->atol_);
+
+                    if(norm <= 1) {
+                        this->prepare_dense_output(h);
+                        this->t_old_ = t;
+                        this->h_old_ = h;
+                        this->t_ = (h == t_end - t) ? t_end : t + h;
+                        std::swap(this->y_, this->y_next_);
+                        std::swap(k[0], k[6]);
+                        ++this->steps_;
+                        // 直前に棄却されたステップの直後は刻み幅を増やさない
+                        const double factor = detail::ode_step_factor(norm, !rejected);
+                        this->h_ = h * factor;
+                        return true;
+                    }
+                    ++this->rejected_steps_;
+                    rejected = true;
+                    this->h_ = h * detail::ode_step_factor(norm, false);
+                }
+            }
+
+            /*
+             * t_endまでステップを繰り返す
+             * max_stepsは受理されたステップと棄却されたステップの合計の上限である。
+             */
+            SolverStatus integrate(const double& t_end, const std::size_t& max_steps = 100000) {
+                while(this->t_ < t_end) {
+                    if(this->steps_ + this->rejected_steps_ >= max_steps) {
+                        return SolverStatus::MaxAttemptsReached;
+                    }
+                    if(!this->step(t_end)) {
+                        return SolverStatus::Diverged;
+                    }
+                }
+                return SolverStatus::Converged;
+            }
+
+            // 直前に受理されたステップの区間[t_old, t]内の時刻tにおける状態をoutに書き込む
+            void dense_output(const double& t, State& out) const {
+                const double theta  = this->h_old_ == 0 ? 0 : (t - this->t_old_) / this->h_old_;
+                const double theta1 = 1 - theta;
+                const auto& d = this->dense_;
+                for(std::size_t i = 0; i < N; ++i) {
+                    out[i] = d[0][i] + theta * (d[1][i] + theta1 * (d[2][i] + theta * (d[3][i] + theta1 * d[4][i])));
+                }
+            }
+            State dense_output(const double& t) const {
+                State out;
+                this->dense_output(t, out);
+                return out;
+            }
+
+            const double& t() const noexcept { return this->t_; }
+            const State& y() const noexcept { return this->y_; }
+            // 次のステップで試みる刻み幅
+            const double& step_size() const noexcept { return this->h_; }
+            // 直前に受理されたステップの開始時刻
+            const double& previous_t() const noexcept { return this->t_old_; }
+            const std::size_t& steps() const noexcept { return this->steps_; }
+            const std::size_t& rejected_steps() const noexcept { return this->rejected_steps_; }
+            const std::size_t& evaluations() const noexcept { return this->evaluations_; }
+    };
+
+    /*
+     * Dormand-Prince法(RK45)により dy/dt = f(t, y) を初期値y0から時刻t1まで積分する
+     *
+     * 引数
+     * - f              : f(t, y)
+     * - t0             : 初期時刻
+     * - y0             : 初期状態
+     * - t1             : 終端時刻
+     * - rtol           : 相対許容誤差
+     * - atol           : 絶対許容誤差
+     * - max_steps      : 最大ステップ数 (棄却されたステップを含む)
+     */
+    template <class State, class F>
+    OdeResult<State> integrate_ode(
+        const F& f,
+        const double& t0,
+        const State& y0,
+        const double& t1,
+        const double& rtol          = 1e-6,
+        const double& atol          = 1e-9,
+        const std::size_t& max_steps = 100000
+    ) {
+        DormandPrince45<State, const F&> solver(f, t0, y0, rtol, atol);
+        const SolverStatus status = solver.integrate(t1, max_steps);
+        return {solver.y(), status, solver.steps(), solver.rejected_steps(), solver.evaluations()};
+    }
+
+    /*
+     * 複数の初期状態についてDormand-Prince法(RK45)により dy/dt = f(t, y) を時刻t1まで積分する
+     *
+     * 初期状態をbatch::lanes_per_block個ずつのブロックに分け、ブロック内の全軌道を同時に進める。
+     * ブロック内の状態は要素ごとに全レーンを並べた配列(SoA)で保持し、段の計算はレーンについての
+     * 最内ループで行うため、コンパイラによりSIMD化される。
+     * 各レーンは独立した刻み幅を持ち、棄却・終了はマスクにより扱う。ブロック内の全レーンが
+     * 終了した時点でそのブロックの積分を終了する。
+     *
+     * threadsに2以上(0の場合はハードウェアの並列数)を指定すると、ブロックを複数のスレッドで処理する。
+     *
+     * 引数
+     * - f              : f(t, y) (threadsが2以上の場合は複数のスレッドから同時に呼び出される)
+     * - t0             : 初期時刻
+     * - ys             : 初期状態
+     * - t1             : 終端時刻
+     * - results        : 終端での状態の書き込み先
+     * - status         : 終了状態の書き込み先
+     * - rtol           : 相対許容誤差
+     * - atol           : 絶対許容誤差
+     * - max_steps      : 各軌道の最大ステップ数 (棄却されたステップを含む)
+     * - threads        : 使用するスレッド数
+     */
+    template <class State, class F>
+    void integrate_ode_batch(
+        const F& f,
+        const double& t0,
+        std::span<const State> ys,
+        const double& t1,
+        std::span<State> results,
+        std::span<SolverStatus> status,
+        const double& rtol              = 1e-6,
+        const double& atol              = 1e-9,
+        const std::size_t& max_steps    = 100000,
+        const std::size_t& threads      = 1
+    ) {
+        assert(ys.size() == results.size() && ys.size() == status.size());
+        using T = DormandPrinceTableau;
+        constexpr std::size_t W = batch::lanes_per_block;
+        constexpr std::size_t N = state_size_v<State>;
+        using Lanes = std::array<std::array<double, W>, N>;
+
+        const auto solve = [&](const std::size_t& begin, const std::size_t& end) {
+            for(std::size_t b = begin; b < end; b += W) {
+                const std::size_t m = std::min(W, end - b);
+                Lanes y{};
+                Lanes y_next{};
+                Lanes stage{};
+                std::array<Lanes, 7> k{};
+                std::array<double, W> t{};
+                std::array<double, W> h{};
+                std::array<double, W> step_h{};
+                std::array<bool, W> active{};
+                std::array<bool, W> rejected{};
+                std::array<std::size_t, W> attempts{};
+                std::array<SolverStatus, W> state;
+                state.fill(SolverStatus::Converged);
+                State lane;
+                State scratch;
+
+                // 端数のレーンは無効にする
+                for(std::size_t l = 0; l < m; ++l) {
+                    const State& y0 = ys[b + l];
+                    for(std::size_t i = 0; i < N; ++i) {
+                        y[i][l] = y0[i];
+                    }
+                    const State dy = f(t0, y0);
+                    for(std::size_t i = 0; i < N; ++i) {
+                        k[0][i][l] = dy[i];
+                    }
+                    t[l] = t0;
+                    active[l] = t0 < t1;
+                    h[l] = active[l] ? detail::ode_initial_step(f, t0, y0, dy, rtol, atol, t1 - t0, scratch) : 0;
+                }
+                // 有効なレーンについてf(t + c h, stage)を評価し、out段に書き込む
+                const auto evaluate = [&](const double& c, const Lanes& from, Lanes& out) {
+                    for(std::size_t l = 0; l < m; ++l) {
+                        if(!active[l]) {
+                            continue;
+                        }
+                        for(std::size_t i = 0; i < N; ++i) {
+                            lane[i] = from[i][l];
+                        }
+                        const State dy = f(t[l] + c * step_h[l], lane);
+                        for(std::size_t i = 0; i < N; ++i) {
+                            out[i][l] = dy[i];
+                        }
+                    }
+                };
+
+                while(true) {
+                    bool any = false;
+                    for(std::size_t l = 0; l < W; ++l) {
+                        any = any || active[l];
+                    }
+                    if(!any) {
+                        break;
+                    }
+                    for(std::size_t l = 0; l < W; ++l) {
+                        step_h[l] = std::min(h[l], t1 - t[l]);
+                    }
+
+                    for(std::size_t i = 0; i < N; ++i) {
+                        for(std::size_t l = 0; l < W; ++l) {
+                            stage[i][l] = y[i][l] + step_h[l] * (T::a21 * k[0][i][l]);
+                        }
+                    }
+                    evaluate(T::c[1], stage, k[1]);
+                    for(std::size_t i = 0; i < N; ++i) {
+                        for(std::size_t l = 0; l < W; ++l) {
+                            stage[i][l] = y[i][l] + step_h[l] * (T::a31 * k[0][i][l] + T::a32 * k[1][i][l]);
+                        }
+                    }
+                    evaluate(T::c[2], stage, k[2]);
+                    for(std::size_t i = 0; i < N; ++i) {
+                        for(std::size_t l = 0; l < W; ++l) {
+                            stage[i][l] = y[i][l] + step_h[l] * (T::a41 * k[0][i][l] + T::a42 * k[1][i][l] + T::a43 * k[2][i][l]);
+                        }
+                    }
+                    evaluate(T::c[3], stage, k[3]);
+                    for(std::size_t i = 0; i < N; ++i) {
+                        for(std::size_t l = 0; l < W; ++l) {
+                            stage[i][l] = y[i][l] + step_h[l] * (T::a51 * k[0][i][l] + T::a52 * k[1][i][l] + T::a53 * k[2][i][l] + T::a54 * k[3][i][l]);
+                        }
+                    }
+                    evaluate(T::c[4], stage, k[4]);
+                    for(std::size_t i = 0; i < N; ++i) {
+                        for(std::size_t l = 0; l < W; ++l) {
+                            stage[i][l] = y[i][l] + step_h[l] * (T::a61 * k[0][i][l] + T::a62 * k[1][i][l] + T::a63 * k[2][i][l]
+                                                                + T::a64 * k[3][i][l] + T::a65 * k[4][i][l]);
+                        }
+                    }
+                    evaluate(T::c[5], stage, k[5]);
+                    for(std::size_t i = 0; i < N; ++i) {
+                        for(std::size_t l = 0; l < W; ++l) {
+                            y_next[i][l] = y[i][l] + step_h[l] * (T::a71 * k[0][i][l] + T::a73 * k[2][i][l] + T::a74 * k[3][i][l]
+                                                                + T::a75 * k[4][i][l] + T::a76 * k[5][i][l]);
+                        }
+                    }
+                    evaluate(T::c[6], y_next, k[6]);
+
+                    std::array<double, W> sum{};
+                    for(std::size_t i = 0; i < N; ++i) {
+                        for(std::size_t l = 0; l < W; ++l) {
+                            const double error = step_h[l] * (T::e1 * k[0][i][l] + T::e3 * k[2][i][l] + T::e4 * k[3][i][l]
+                                                            + T::e5 * k[4][i][l] + T::e6 * k[5][i][l] + T::e7 * k[6][i][l]);
+                            const double scale = atol + rtol * std::max(std::abs(y[i][l]), std::abs(y_next[i][l]));
+                            sum[l] += (error / scale) * (error / scale);
+                        }
+                    }
+
+                    std::array<bool, W> accept{};
+                    for(std::size_t l = 0; l < W; ++l) {
+                        const double norm = std::sqrt(sum[l] / N);
+                        accept[l] = active[l] && norm <= 1;
+                        h[l] = step_h[l] * detail::ode_step_factor(norm, accept[l] && !rejected[l]);
+                        rejected[l] = active[l] && !accept[l];
+                        t[l] = accept[l] ? ((step_h[l] == t1 - t[l]) ? t1 : t[l] + step_h[l]) : t[l];
+                        ++attempts[l];
+                    }
+                    for(std::size_t i = 0; i < N; ++i) {
+                        for(std::size_t l = 0; l < W; ++l) {
+                            y[i][l]    = accept[l] ? y_next[i][l] : y[i][l];
+                            k[0][i][l] = accept[l] ? k[6][i][l] : k[0][i][l];
+                        }
+                    }
+                    for(std::size_t l = 0; l < W; ++l) {
+                        const bool underflow = !(h[l] > std::abs(t[l]) * 1e-14) || !std::isfinite(h[l]);
+                        const bool finished  = !(t[l] < t1);
+                        state[l]  = !active[l] || finished ? state[l]
+                                  : (underflow ? SolverStatus::Diverged : (attempts[l] >= max_steps ? SolverStatus::MaxAttemptsReached : state[l]));
+                        active[l] = active[l] && !finished && !underflow && attempts[l] < max_steps;
+                    }
+                }
+                for(std::size_t l = 0; l < m; ++l) {
+                    for(std::size_t i = 0; i < N; ++i) {
+                        results[b + l][i] = y[i][l];
+                    }
+                    status[b + l] = state[l];
+                }
+            }
+        };
+        klibrary::parallel::parallel_for(0, ys.size(), threads, solve, W);
+    }
+}
+#endif // ode_integration
@@ -0,0 +1,141 @@
+#ifndef root_scanning
+#define root_scanning
+#include <vector>
+#include <mutex>
+#include <cmath>
+#include <cstddef>
+#include <algorithm>
+#include "constants.hpp"
+#include "approximation_algorithm.hpp"
+#include "./../Parallel/parallel_for.hpp"
+namespace numerical_analysis {
+    namespace detail {
+        // [l, r]内に解が存在すれば探索し、rootsに追加する
+        template <class F>
+        void scan_interval(
+            const F& f,
+            const double& l, const double& r,
+            const double& fl, const double& fr,
+            const double& epsilon,
+            const std::size_t& depth,
+            std::vector<double>& roots
+        ) {
+            if(fl == 0) {
+                // lは解として記録し、(l, r]に残る解は中点で分割して探す (lの直後の符号変化はfmとfrの比較で現れる)
+                roots.push_back(l);
+                if(depth == 0 || r - l <= epsilon) {
+                    return;
+                }
+                const double m  = (l + r) / 2;
+                const double fm = f(m);
+                scan_interval(f, l, m, fl, fm, epsilon, depth - 1, roots);
+                scan_interval(f, m, r, fm, fr, epsilon, depth - 1, roots);
+                return;
+            }
+            if((fl < 0) != (fr < 0)) {
+                if(fr != 0) {
+                    roots.push_back(brent_method(f, l, r, epsilon).root);
+                }
+                return;
+            }
+            if(depth == 0 || r - l <= epsilon) {
+                return;
+            }
+            // 符号変化がない区間は中点で|f(x)|が小さくなる場合に限り分割する (近接した2解の検出)
+            const double m  = (l + r) / 2;
+            const double fm = f(m);
+            if((std::abs(fm) < std::abs(fl) && std::abs(fm) < std::abs(fr)) || fm == 0 || (fm < 0) != (fl < 0)) {
+                scan_interval(f, l, m, fl, fm, epsilon, depth - 1, roots);
+                scan_interval(f, m, r, fm, fr, epsilon, depth - 1, roots);
+            }
+        }
+    }
+
+    /*
+     * [a, b]に含まれるf(x)=0の全ての解を探索する
+     *
+     * [a, b]をsamples個の区間に等分してf(x)を標本化し、
+     * - 両端の符号が異なる区間はBrent法で解を求める
+     * - 符号変化はないが|f(x)|が極小となる標本点に隣接する区間は、中点で|f(x)|が減少する限り
+     *   最大max_depth回まで再帰的に分割して符号変化を探す (重解に近い近接した2解の検出)
+     * - 左端の標本点が解である区間は、その点を解とし、残りの区間を同様に分割して別の解を探す
+     *
+     * 区間はthreads個(0の場合はハードウェアの並列数)のスレッドに分配され、各スレッドは担当区間の標本化と
+     * 解の探索を独立に行う。得られた解は昇順に整列し、epsilon以内の重複を取り除いて返す。
+     *
+     * 標本間隔より狭い範囲にある偶数個の解は、|f(x)|の極小として現れない場合検出できない。
+     *
+     * 引数
+     * - f              : f(x) (複数のスレッドから同時に呼び出される)
+     * - a              : 探索範囲の左端
+     * - b              : 探索範囲の右端
+     * - samples        : 区間の分割数
+     * - epsilon        : 収束判定条件 (Brent法の収束判定条件および解の重複判定)
+     * - threads        : 使用するスレッド数
+     * - max_depth      : 近接した解を探すための区間の最大分割回数
+     */
+    template <class F>
+    std::vector<double> find_all_roots(
+        const F& f,
+        const double& a,
+        const double& b,
+        const std::size_t& samples  = 1000,
+        const double& epsilon       = Constants::epsilon,
+        const std::size_t& threads  = 0,
+        const std::size_t& max_depth = 16
+    ) {
+        std::vector<double> roots;
+        if(!(a < b) || samples == 0) {
+            return roots;
+        }
+        std::mutex mutex;
+        const double width = (b - a) / static_cast<double>(samples);
+        const auto point = [&](const std::size_t& i) {
+            return i == samples ? b : a + static_cast<double>(i) * width;
+        };
+
+        const auto scan = [&](const std::size_t& begin, const std::size_t& end) {
+            // 担当区間[begin, end)の両側1点ずつを含めて標本化する
+            const std::size_t first = begin == 0 ? 0 : begin - 1;
+            const std::size_t last  = std::min(samples, end + 1);
+            std::vector<double> values(last - first + 1);
+            for(std::size_t i = first; i <= last; ++i) {
+                values[i - first] = f(point(i));
+            }
+            const auto value = [&](const std::size_t& i) { return values[i - first]; };
+            // 標本点iで|f(x)|が符号を変えずに極小となるか
+            const auto dip = [&](const std::size_t& i) {
+                if(i == 0 || i == samples) {
+                    return false;
+                }
+                const bool same_sign = (value(i - 1) < 0) == (value(i) < 0) && (value(i) < 0) == (value(i + 1) < 0);
+                return same_sign && std::abs(value(i)) <= std::abs(value(i - 1)) && std::abs(value(i)) <= std::abs(value(i + 1));
+            };
+
+            std::vector<double> local;
+            for(std::size_t i = begin; i < end; ++i) {
+                const double fl = value(i);
+                const double fr = value(i + 1);
+                const std::size_t depth = (dip(i) || dip(i + 1) || fl == 0) ? max_depth : 0;
+                detail::scan_interval(f, point(i), point(i + 1), fl, fr, epsilon, depth, local);
+            }
+            if(end == samples && value(samples) == 0) {
+                local.push_back(b);
+            }
+            const std::lock_guard<std::mutex> lock(mutex);
+            roots.insert(roots.end(), local.begin(), local.end());
+        };
+        klibrary::parallel::parallel_for(0, samples, threads, scan);
+
+        std::sort(roots.begin(), roots.end());
+        std::vector<double> unique;
+        unique.reserve(roots.size());
+        for(const double root : roots) {
+            if(unique.empty() || root - unique.back() > epsilon) {
+                unique.push_back(root);
+            }
+        }
+        return unique;
+    }
+}
+#endif // root_scanning
@@ -0,0 +1,78 @@
+#ifndef solver_options
+#define solver_options
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <optional>
+#include <string_view>
+#include "constants.hpp"
+#include "solver_status.hpp"
+#include "numerical_differentiation.hpp"
+namespace numerical_analysis {
+    /*
+     * 求解の結果
+     *
+     * - root           : 解
+     * - status         : 終了状態
+     * - iterations     : 反復回数
+     * - evaluations    : f(x)の評価回数 (数値微分による評価を含み、df(x)の評価は含まない)
+     * - residual       : 最後に評価した|f(x)|
+     * - elapsed        : 求解に要した時間 (SolverOptions::profilerが設定されている場合のみ計測される)
+     */
+    struct SolverResult {
+        double                      root;
+        SolverStatus                status;
+        std::size_t                 iterations;
+        std::size_t                 evaluations;
+        double                      residual;
+        std::chrono::nanoseconds    elapsed;
+    };
+
+    /*
+     * 求解の設定
+     *
+     * 実行時に指定する収束判定条件等をまとめたもので、既定値はConstantsの値である。
+     * max_attemptsを指定しなかった場合は関数ごとの既定値
+     * (二分法はConstants::bisection_max_attempts、Brent法はConstants::brent_max_attempts、
+     * それ以外はConstants::max_attempts) を使用する。
+     *
+     * newton_raphson(1.0, f, df, {.epsilon = 1e-12, .max_attempts = 50});
+     *
+     * - epsilon            : 収束判定条件
+     * - max_attempts       : 最大試行回数 (未指定の場合は関数ごとの既定値)
+     * - h                  : 数値微分に使用される差分幅
+     * - derivative_type    : 数値微分方法指定
+     * - profiler           : 求解の終了時に、関数名と計測時間を含む結果を受け取る関数
+     *                        (設定されていない場合は時間を計測しない)
+     */
+    struct SolverOptions {
+        double                                                      epsilon         = Constants::epsilon;
+        std::optional<std::size_t>                                  max_attempts    = std::nullopt;
+        double                                                      h               = Constants::h;
+        DerivativeType                                              derivative_type = DerivativeType::Central;
+        std::function<void(std::string_view, const SolverResult&)>  profiler        = nullptr;
+    };
+
+    namespace detail {
+        // profilerが設定されている場合に求解の開始から終了までの時間を計測し、結果を通知する
+        class SolverProfile {
+            private:
+                using Clock = std::chrono::steady_clock;
+                const SolverOptions& options_;
+                std::string_view name_;
+                Clock::time_point start_;
+            public:
+                SolverProfile(const SolverOptions& options, std::string_view name)
+                    : options_(options), name_(name), start_(options.profiler ? Clock::now() : Clock::time_point()) {}
+
+                SolverResult finish(SolverResult result) const {
+                    if(this->options_.profiler) {
+                        result.elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - this->start_);
+                        this->options_.profiler(this->name_, result);
+                    }
+                    return result;
+                }
+        };
+    }
+}
+#endif // solver_options
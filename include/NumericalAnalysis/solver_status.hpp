@@ -0,0 +1,15 @@
+#ifndef solver_status
+#define solver_status
+namespace numerical_analysis {
+    /*
+     * 反復解法の終了状態
+     *
+     * - Converged          : 収束判定条件を満たした
+     * - MaxAttemptsReached : 収束判定条件を満たさないまま最大試行回数に達した
+     * - InvalidBracket     : 探索範囲の両端でf(x)の符号が異なっていない
+     * - Diverged           : 反復の途中で値が有限でなくなった (微分が0である場合など)
+     * - Singular           : 解くべき線形方程式の係数行列が特異である (最小二乗法で計画行列の階数が落ちている場合など)
+     */
+    enum class SolverStatus { Converged, MaxAttemptsReached, InvalidBracket, Diverged, Singular };
+}
+#endif // solver_status
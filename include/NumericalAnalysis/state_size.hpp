@@ -0,0 +1,19 @@
+#ifndef state_size_hpp
+#define state_size_hpp
+#include <cstddef>
+#include <utility>
+#include <type_traits>
+#include "./../LinearAlgebra/StaticMatrix/Base/staticmatrix_base.hpp"
+#include "./../LinearAlgebra/StaticMatrix/Vector/staticvector.hpp"
+namespace numerical_analysis {
+    namespace detail {
+        template <class ElemT, klibrary::linear_algebra::alias_and_concepts::SizeT Rows, klibrary::linear_algebra::alias_and_concepts::SizeT Cols>
+        std::integral_constant<std::size_t, Rows * Cols> state_extent(const klibrary::linear_algebra::StaticMatrixBase<ElemT, Rows, Cols>&);
+        template <class ElemT, klibrary::linear_algebra::alias_and_concepts::SizeT Rows, klibrary::linear_algebra::alias_and_concepts::SizeT Cols>
+        std::integral_constant<std::size_t, Rows * Cols> state_extent(const klibrary::linear_algebra::StaticVectorBase<ElemT, Rows, Cols>&);
+    }
+    // 状態(StaticMatrixBase、StaticColVectorおよびStaticRowVector)の要素数
+    template <class State>
+    constexpr std::size_t state_size_v = decltype(detail::state_extent(std::declval<const State&>()))::value;
+}
+#endif // state_size_hpp
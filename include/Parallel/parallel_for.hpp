@@ -0,0 +1,78 @@
+#ifndef parallel_for_hpp
+#define parallel_for_hpp
+#include <cstddef>
+#include <thread>
+#include <vector>
+#include <exception>
+#include <algorithm>
+namespace klibrary::parallel {
+    /*
+     * 使用するスレッド数を返す
+     *
+     * threadsが0の場合はハードウェアの並列数を、それ以外の場合はthreadsをそのまま返す。
+     */
+    inline std::size_t thread_count(const std::size_t& threads) {
+        if(threads != 0) {
+            return threads;
+        }
+        const std::size_t hardware = std::thread::hardware_concurrency();
+        return hardware == 0 ? 1 : hardware;
+    }
+
+    /*
+     * [first, last)をthreads個の連続した区間に分割し、各区間についてbody(begin, end)を並列に呼び出す。
+     *
+     * - 区間の境界はgrainの倍数に揃えられる
+     * - threadsが0の場合はハードウェアの並列数を使用する
+     * - 分割数が1以下の場合は呼び出し元のスレッドで実行する
+     * - bodyが例外を送出した場合は全てのスレッドの終了を待ってから最初の例外を再送出する
+     */
+    template <class Body>
+    void parallel_for(
+        const std::size_t& first,
+        const std::size_t& last,
+        const std::size_t& threads,
+        const Body& body,
+        const std::size_t& grain = 1
+    ) {
+        if(first >= last) {
+            return;
+        }
+        const std::size_t n = last - first;
+        const std::size_t blocks = (n + grain - 1) / grain;
+        const std::size_t workers = std::min(thread_count(threads), blocks);
+        if(workers <= 1) {
+            body(first, last);
+            return;
+        }
+
+        std::vector<std::exception_ptr> exceptions(workers);
+        const auto run = [&](const std::size_t& w) {
+            const std::size_t begin = first + std::min(n, (blocks * w / workers) * grain);
+            const std::size_t end   = first + std::min(n, (blocks * (w + 1) / workers) * grain);
+            try {
+                if(begin < end) {
+                    body(begin, end);
+                }
+            } catch(...) {
+                exceptions[w] = std::current_exception();
+            }
+        };
+
+        std::vector<std::thread> pool;
+        pool.reserve(workers - 1);
+        for(std::size_t w = 1; w < workers; ++w) {
+            pool.emplace_back(run, w);
+        }
+        run(0);
+        for(auto& thread : pool) {
+            thread.join();
+        }
+        for(const auto& exception : exceptions) {
+            if(exception) {
+                std::rethrow_exception(exception);
+            }
+        }
+    }
+}
+#endif // parallel_for_hpp
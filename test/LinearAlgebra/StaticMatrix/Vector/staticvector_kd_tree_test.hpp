@@ -0,0 +1,105 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include <algorithm>
+#include "./../../../../include/LinearAlgebra/StaticMatrix/Vector/KDTree/staticvector_kd_tree.hpp"
+#include "./../../../../include/LinearAlgebra/StaticMatrix/Random/staticmatrix_random.hpp"
+namespace {
+    using namespace klibrary::linear_algebra;
+    using Tree = StaticVectorKDTree<float, 3>;
+    using Point = Tree::Point;
+
+    std::vector<Point> random_points(const std::size_t& n, const std::uint64_t& stream) {
+        Philox4x32 engine(1, stream);
+        std::vector<Point> points(n);
+        for(auto& point : points) {
+            point = Point::Random(engine, -1.0f, 1.0f);
+        }
+        return points;
+    }
+    float squared_distance(const Point& a, const Point& b) {
+        float sum = 0;
+        for(std::size_t d = 0; d < 3; ++d) {
+            sum += (a[d] - b[d]) * (a[d] - b[d]);
+        }
+        return sum;
+    }
+}
+TEST(LinearAlgebraStaticVectorKDTreeTest, NearestTest) {
+    const auto points = random_points(5000, 0);
+    const auto queries = random_points(200, 1);
+    const Tree tree(points);
+    EXPECT_EQ(tree.size(), points.size());
+
+    constexpr std::size_t k = 8;
+    for(const auto& query : queries) {
+        std::vector<float> expected(points.size());
+        for(std::size_t i = 0; i < points.size(); ++i) {
+            expected[i] = squared_distance(points[i], query);
+        }
+        std::partial_sort(expected.begin(), expected.begin() + k, expected.end());
+        const auto result = tree.nearest(query, k);
+        ASSERT_EQ(result.size(), k);
+        for(std::size_t j = 0; j < k; ++j) {
+            ASSERT_EQ(result[j].squared_distance, expected[j]);
+            ASSERT_EQ(result[j].squared_distance, squared_distance(points[result[j].index], query));
+        }
+    }
+}
+TEST(LinearAlgebraStaticVectorKDTreeTest, RadiusTest) {
+    const auto points = random_points(5000, 2);
+    const auto queries = random_points(100, 3);
+    const Tree tree(points, {.leaf_size = 4});
+    constexpr float radius = 0.2f;
+    for(const auto& query : queries) {
+        std::vector<std::size_t> expected;
+        for(std::size_t i = 0; i < points.size(); ++i) {
+            if(squared_distance(points[i], query) <= radius * radius) {
+                expected.push_back(i);
+            }
+        }
+        std::vector<std::size_t> found;
+        for(const auto& neighbor : tree.within_radius(query, radius)) {
+            found.push_back(neighbor.index);
+        }
+        std::sort(found.begin(), found.end());
+        ASSERT_EQ(found, expected);
+    }
+}
+TEST(LinearAlgebraStaticVectorKDTreeTest, ParallelTest) {
+    const auto points = random_points(20000, 4);
+    const auto queries = random_points(300, 5);
+    const Tree serial(points);
+    const Tree parallel(points, {.leaf_size = 16, .threads = 4});
+
+    // 構築結果はスレッド数に依らず、一括探索は1点ずつの探索と一致する
+    constexpr std::size_t k = 5;
+    const auto batch = parallel.nearest_batch(queries, k, 3);
+    ASSERT_EQ(batch.size(), queries.size() * k);
+    const auto batch_radius = parallel.within_radius_batch(queries, 0.1f, 3);
+    for(std::size_t q = 0; q < queries.size(); ++q) {
+        const auto expected = serial.nearest(queries[q], k);
+        for(std::size_t j = 0; j < k; ++j) {
+            ASSERT_EQ(batch[q * k + j].index, expected[j].index);
+            ASSERT_EQ(batch[q * k + j].squared_distance, expected[j].squared_distance);
+        }
+        const auto expected_radius = serial.within_radius(queries[q], 0.1f);
+        ASSERT_EQ(batch_radius[q].size(), expected_radius.size());
+        for(std::size_t j = 0; j < expected_radius.size(); ++j) {
+            ASSERT_EQ(batch_radius[q][j].index, expected_radius[j].index);
+        }
+    }
+}
+TEST(LinearAlgebraStaticVectorKDTreeTest, EdgeCaseTest) {
+    const Tree empty(std::vector<Point>{}, {.leaf_size = 16, .threads = 4});
+    EXPECT_TRUE(empty.nearest(Point{0.0f, 0.0f, 0.0f}, 3).empty());
+    EXPECT_TRUE(empty.within_radius(Point{0.0f, 0.0f, 0.0f}, 1.0f).empty());
+
+    // 同じ座標の点が多数ある場合とkが点の数より大きい場合
+    std::vector<Point> points(100, Point{1.0f, 2.0f, 3.0f});
+    points.push_back(Point{0.0f, 0.0f, 0.0f});
+    const Tree tree(points, {.leaf_size = 2, .threads = 2});
+    const auto nearest = tree.nearest(Point{0.1f, 0.0f, 0.0f}, 1000);
+    ASSERT_EQ(nearest.size(), points.size());
+    EXPECT_EQ(nearest[0].index, 100u);
+    EXPECT_EQ(tree.within_radius(Point{1.0f, 2.0f, 3.0f}, 0.0f).size(), 100u);
+}
@@ -0,0 +1,28 @@
+#include <gtest/gtest.h>
+#include <array>
+#include <cmath>
+#include "./../../../../include/LinearAlgebra/StaticMatrix/Vector/staticvector.hpp"
+namespace {
+    using namespace klibrary::linear_algebra;
+}
+TEST(LinearAlgebraStaticVectorTest, FunctionTest) {
+    StaticColVector<double, 3> v1{3, 4, 5};
+    StaticColVector<double, 3> v2 = std::array<double, 3>{7, 2, 4};
+    StaticRowVector<int, 3> v3{1, 2, 3};
+    static_assert(sizeof(v1) == 3 * sizeof(double));
+
+    // 全ての機能が同じ要素を参照する
+    v1 += v2;
+    EXPECT_EQ(v1[0], 10);
+    EXPECT_DOUBLE_EQ(v1.norm(1), 10.0 + 6.0 + 9.0);
+    EXPECT_DOUBLE_EQ(v1.dot(v2), 70.0 + 12.0 + 36.0);
+
+    // 演算結果から構築できる
+    StaticColVector<double, 3> sum = v1 + v2;
+    StaticColVector<double, 3> zero = StaticColVector<double, 3>::Zero();
+    StaticRowVector<int, 3> scaled = v3 * 2;
+    EXPECT_EQ(sum[2], 13);
+    EXPECT_EQ(zero[1], 0);
+    EXPECT_EQ(scaled[2], 6);
+    EXPECT_EQ(v3.size(), 3u);
+}
@@ -0,0 +1,118 @@
+#include <gtest/gtest.h>
+#include <array>
+#include <cmath>
+#include <complex>
+#include "./../../../include/LinearAlgebra/StaticMatrix/Base/staticmatrix_base.hpp"
+#include "./../../../include/LinearAlgebra/StaticMatrix/BasicTransforms/staticmatrix_basic_transforms.hpp"
+#include "./../../../include/LinearAlgebra/StaticMatrix/Power/staticmatrix_power.hpp"
+#include "./../../../include/LinearAlgebra/StaticMatrix/Vector/staticvector.hpp"
+namespace {
+    using namespace klibrary::linear_algebra;
+    using Complex = std::complex<double>;
+}
+TEST(LinearAlgebraStaticMatrixComplexTest, ConjugateTransposeTest) {
+    StaticMatrixBasicTransforms<Complex, 2, 3> a = {{Complex(1, 2), Complex(3, -1), Complex(0, 4)}, {Complex(-2, 0), Complex(5, 5), Complex(1, 1)}};
+    const auto h = StaticMatrixBasicTransforms<Complex, 2, 3>::ConjugateTranspose(a);
+    for(std::size_t r = 0; r < 2; ++r) {
+        for(std::size_t c = 0; c < 3; ++c) {
+            EXPECT_EQ(h(c, r), std::conj(a(r, c)));
+        }
+    }
+
+    StaticMatrixBasicTransforms<Complex, 2, 2> s = {{Complex(1, 1), Complex(2, -3)}, {Complex(4, 5), Complex(0, -2)}};
+    const auto original = s;
+    s.conjugate_transpose();
+    for(std::size_t r = 0; r < 2; ++r) {
+        for(std::size_t c = 0; c < 2; ++c) {
+            EXPECT_EQ(s(r, c), std::conj(original(c, r)));
+        }
+    }
+
+    // 実数型では転置と同じ
+    StaticMatrixBasicTransforms<int, 2, 2> real = {{1, 2}, {3, 4}};
+    real.conjugate_transpose();
+    EXPECT_EQ(real(0, 1), 3);
+    EXPECT_EQ(real(1, 0), 2);
+}
+TEST(LinearAlgebraStaticMatrixComplexTest, VectorTest) {
+    StaticColVector<Complex, 3> v = {Complex(1, 2), Complex(-3, 1), Complex(0, -1)};
+    StaticColVector<Complex, 3> w = {Complex(2, 0), Complex(1, 1), Complex(4, -2)};
+    // Σ conj(v_i) w_i
+    Complex expected = 0;
+    for(std::size_t i = 0; i < 3; ++i) {
+        expected += std::conj(v[i]) * w[i];
+    }
+    EXPECT_EQ(v.conjugate_dot(w), expected);
+    EXPECT_EQ(v.dot(w), v[0] * w[0] + v[1] * w[1] + v[2] * w[2]);
+    // <v, v>は実数で、2-ノルムの2乗に等しい
+    EXPECT_DOUBLE_EQ(v.conjugate_dot(v).real(), 16.0);
+    EXPECT_EQ(v.conjugate_dot(v).imag(), 0.0);
+    EXPECT_DOUBLE_EQ(v.norm(), 4.0);
+    EXPECT_DOUBLE_EQ(v.norm(1), std::sqrt(5.0) + std::sqrt(10.0) + 1.0);
+    EXPECT_DOUBLE_EQ(v.norm(Infinity), std::sqrt(10.0));
+
+    StaticColVector<double, 3> real = {1.0, -7.0, 2.0};
+    EXPECT_EQ(real.norm(Infinity), 7.0);
+}
+TEST(LinearAlgebraStaticMatrixComplexTest, ProductTest) {
+    constexpr std::size_t rows = 7, mids = 13, cols = 9;
+    StaticMatrixBase<Complex, rows, mids> a;
+    StaticMatrixBase<Complex, mids, cols> b;
+    for(std::size_t i = 0; i < rows * mids; ++i) {
+        a[i] = Complex(std::sin(static_cast<double>(i)), std::cos(static_cast<double>(2 * i)));
+    }
+    for(std::size_t i = 0; i < mids * cols; ++i) {
+        b[i] = Complex(std::cos(static_cast<double>(i)), -std::sin(static_cast<double>(3 * i)));
+    }
+    StaticMatrixBase<Complex, rows, cols> c;
+    multiply_into(a, b, c);
+    const auto expected = a * b;
+    for(std::size_t i = 0; i < rows * cols; ++i) {
+        EXPECT_NEAR(std::abs(c[i] - expected[i]), 0.0, 1e-13);
+    }
+
+    std::array<Complex, mids> x;
+    for(std::size_t i = 0; i < mids; ++i) {
+        x[i] = Complex(static_cast<double>(i), 1.0 - static_cast<double>(i));
+    }
+    StaticColVector<Complex, rows> y;
+    multiply_vector_into(a, x, y);
+    for(std::size_t r = 0; r < rows; ++r) {
+        Complex sum = 0;
+        for(std::size_t m = 0; m < mids; ++m) {
+            sum += a(r, m) * x[m];
+        }
+        EXPECT_NEAR(std::abs(y[r] - sum), 0.0, 1e-12);
+    }
+
+    // 要素数が大きい複素行列のoperator*、operator*=は分割形式の計算核を使用する
+    constexpr std::size_t n = 10;
+    StaticMatrixBase<Complex, n, n> p, q;
+    for(std::size_t i = 0; i < n * n; ++i) {
+        p[i] = Complex(std::cos(static_cast<double>(5 * i)), std::sin(static_cast<double>(i)));
+        q[i] = Complex(std::sin(static_cast<double>(7 * i)), 0.5 - std::cos(static_cast<double>(i)));
+    }
+    const auto pq = p * q;
+    auto product = p;
+    product *= q;
+    StaticMatrixBase<Complex, n, n> split;
+    split_complex::multiply(p, q, split);
+    for(std::size_t r = 0; r < n; ++r) {
+        for(std::size_t c = 0; c < n; ++c) {
+            Complex sum = 0;
+            for(std::size_t m = 0; m < n; ++m) {
+                sum += p(r, m) * q(m, c);
+            }
+            EXPECT_NEAR(std::abs(pq(r, c) - sum), 0.0, 1e-13);
+            EXPECT_EQ(pq(r, c), split(r, c));
+            EXPECT_EQ(product(r, c), split(r, c));
+        }
+    }
+
+    StaticMatrixBase<double, 2, 3> real = {{1, 2, 3}, {4, 5, 6}};
+    const std::array<double, 3> z = {1, 0, -1};
+    std::array<double, 2> real_y;
+    multiply_vector_into(real, z, real_y);
+    EXPECT_EQ(real_y[0], -2.0);
+    EXPECT_EQ(real_y[1], -2.0);
+}
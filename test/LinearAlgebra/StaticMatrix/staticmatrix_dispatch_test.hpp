@@ -0,0 +1,276 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <vector>
+#include <memory>
+#include <complex>
+#include <cstdint>
+#include <utility>
+#include "./../../../include/LinearAlgebra/StaticMatrix/Dispatch/staticmatrix_dispatch.hpp"
+#include "./../../../include/LinearAlgebra/StaticMatrix/Base/staticmatrix_base.hpp"
+#include "./../../../include/LinearAlgebra/StaticMatrix/Power/staticmatrix_power.hpp"
+#include "./../../../include/LinearAlgebra/StaticMatrix/Vector/staticvector.hpp"
+#include "./../../../include/LinearAlgebra/StaticMatrix/Complex/staticmatrix_complex.hpp"
+#include "./../../../include/LinearAlgebra/StaticMatrix/Quantized/staticmatrix_quantized.hpp"
+namespace {
+    using namespace klibrary::linear_algebra;
+    using dispatch::InstructionSet;
+
+    // CPUが対応する全ての命令セットについてbodyを実行する
+    template <class Body>
+    void for_each_instruction_set(const Body& body) {
+        const InstructionSet detected = dispatch::detected_instruction_set();
+        for(const InstructionSet isa : {InstructionSet::Scalar, InstructionSet::SSE42, InstructionSet::AVX2, InstructionSet::AVX512}) {
+            if(isa > detected) {
+                break;
+            }
+            dispatch::set_instruction_set(isa);
+            body(isa);
+        }
+        dispatch::reset_instruction_set();
+    }
+    // Scalarの計算核でbodyを実行した結果 (各命令セットの結果はこれとビット単位で一致する)
+    template <class Body>
+    auto scalar_result(const Body& body) {
+        const InstructionSet previous = dispatch::set_instruction_set(InstructionSet::Scalar);
+        auto result = body();
+        dispatch::set_instruction_set(previous);
+        return result;
+    }
+}
+TEST(LinearAlgebraStaticMatrixDispatchTest, SelectionTest) {
+    const InstructionSet detected = dispatch::detected_instruction_set();
+    EXPECT_EQ(dispatch::active_instruction_set(), detected);
+
+    // CPUが対応しない命令セットは対応する最も新しい命令セットに制限される
+    EXPECT_EQ(dispatch::set_instruction_set(InstructionSet::Scalar), detected);
+    EXPECT_EQ(dispatch::active_instruction_set(), InstructionSet::Scalar);
+    EXPECT_EQ(&dispatch::kernels<double>(), &dispatch::kernels_for<double>(InstructionSet::Scalar));
+    EXPECT_EQ(dispatch::set_instruction_set(InstructionSet::AVX512), InstructionSet::Scalar);
+    EXPECT_EQ(dispatch::active_instruction_set(), detected);
+    EXPECT_EQ(&dispatch::kernels<float>(), &dispatch::kernels_for<float>(detected));
+
+    dispatch::set_instruction_set(InstructionSet::Scalar);
+    dispatch::reset_instruction_set();
+    EXPECT_EQ(dispatch::active_instruction_set(), detected);
+}
+TEST(LinearAlgebraStaticMatrixDispatchTest, KernelTest) {
+    constexpr std::size_t n = 1003;
+    std::vector<double> a(n), b(n);
+    for(std::size_t i = 0; i < n; ++i) {
+        a[i] = std::sin(static_cast<double>(i));
+        b[i] = std::cos(static_cast<double>(3 * i));
+    }
+    double expected_dot = 0, expected_squares = 0;
+    for(std::size_t i = 0; i < n; ++i) {
+        expected_dot += a[i] * b[i];
+        expected_squares += a[i] * a[i];
+    }
+
+    const auto& scalar = dispatch::kernels_for<double>(InstructionSet::Scalar);
+    EXPECT_NEAR(scalar.dot(a.data(), b.data(), n), expected_dot, 1e-12);
+    EXPECT_NEAR(scalar.sum_of_squares(a.data(), n), expected_squares, 1e-12);
+    std::vector<double> scalar_y = b;
+    scalar.axpy(2.0, a.data(), scalar_y.data(), n);
+
+    for_each_instruction_set([&](const InstructionSet&) {
+        const auto& kernels = dispatch::kernels<double>();
+        EXPECT_EQ(kernels.dot(a.data(), b.data(), n), scalar.dot(a.data(), b.data(), n));
+        EXPECT_EQ(kernels.sum_of_squares(a.data(), n), scalar.sum_of_squares(a.data(), n));
+        // 端数の要素のみの場合
+        EXPECT_EQ(kernels.dot(a.data(), b.data(), 3), scalar.dot(a.data(), b.data(), 3));
+        EXPECT_EQ(kernels.dot(a.data(), b.data(), 0), 0.0);
+
+        std::vector<double> out(n), y = b;
+        kernels.add(a.data(), b.data(), out.data(), n);
+        for(std::size_t i = 0; i < n; ++i) {
+            ASSERT_EQ(out[i], a[i] + b[i]);
+        }
+        kernels.subtract(a.data(), b.data(), out.data(), n);
+        for(std::size_t i = 0; i < n; ++i) {
+            ASSERT_EQ(out[i], a[i] - b[i]);
+        }
+        kernels.scale(0.5, out.data(), n);
+        for(std::size_t i = 0; i < n; ++i) {
+            ASSERT_EQ(out[i], (a[i] - b[i]) * 0.5);
+        }
+        kernels.axpy(2.0, a.data(), y.data(), n);
+        for(std::size_t i = 0; i < n; ++i) {
+            ASSERT_NEAR(y[i], b[i] + 2.0 * a[i], 1e-15);
+            ASSERT_EQ(y[i], scalar_y[i]);
+        }
+    });
+}
+TEST(LinearAlgebraStaticMatrixDispatchTest, GemmTest) {
+    // 行の間隔が列数より大きい部分行列の積 (ブロックの大きさの端数を含む)
+    constexpr std::size_t m = 37, k = 130, n = 71, ld = 150;
+    std::vector<float> a(m * ld), b(k * ld);
+    for(std::size_t i = 0; i < a.size(); ++i) {
+        a[i] = static_cast<float>(std::sin(static_cast<double>(i)));
+    }
+    for(std::size_t i = 0; i < b.size(); ++i) {
+        b[i] = static_cast<float>(std::cos(static_cast<double>(i)));
+    }
+    std::vector<double> expected(m * n);
+    for(std::size_t r = 0; r < m; ++r) {
+        for(std::size_t c = 0; c < n; ++c) {
+            for(std::size_t p = 0; p < k; ++p) {
+                expected[r * n + c] += static_cast<double>(a[r * ld + p]) * b[p * ld + c];
+            }
+        }
+    }
+
+    std::vector<float> scalar(m * ld, -1.0f);
+    dispatch::kernels_for<float>(InstructionSet::Scalar).gemm(a.data(), ld, b.data(), ld, scalar.data(), ld, m, k, n);
+
+    for_each_instruction_set([&](const InstructionSet&) {
+        std::vector<float> c(m * ld, -1.0f);
+        dispatch::kernels<float>().gemm(a.data(), ld, b.data(), ld, c.data(), ld, m, k, n);
+        for(std::size_t r = 0; r < m; ++r) {
+            for(std::size_t j = 0; j < n; ++j) {
+                ASSERT_NEAR(c[r * ld + j], expected[r * n + j], 1e-4);
+                ASSERT_EQ(c[r * ld + j], scalar[r * ld + j]);
+            }
+            // 範囲外の要素は変更しない
+            ASSERT_EQ(c[r * ld + n], -1.0f);
+        }
+    });
+}
+TEST(LinearAlgebraStaticMatrixDispatchTest, IntegrationTest) {
+    constexpr std::size_t n = 96;
+    using Matrix = StaticMatrixBase<double, n, n>;
+    const auto a = std::make_unique<Matrix>();
+    const auto b = std::make_unique<Matrix>();
+    for(std::size_t i = 0; i < n * n; ++i) {
+        (*a)[i] = std::sin(static_cast<double>(i));
+        (*b)[i] = std::cos(static_cast<double>(i));
+    }
+    // 各要素の積をkの昇順に加えた値
+    const auto expected = std::make_unique<Matrix>();
+    for(std::size_t r = 0; r < n; ++r) {
+        for(std::size_t c = 0; c < n; ++c) {
+            double sum = 0;
+            for(std::size_t k = 0; k < n; ++k) {
+                sum += (*a)(r, k) * (*b)(k, c);
+            }
+            (*expected)(r, c) = sum;
+        }
+    }
+    StaticVectorGeometory<double, 1, 4096> v, w;
+    for(std::size_t i = 0; i < 4096; ++i) {
+        v[i] = std::sin(0.1 * static_cast<double>(i));
+        w[i] = 1.0 / static_cast<double>(i + 1);
+    }
+    const double expected_dot = v.dot<reduction::MultiAccumulator<16>>(w);
+    const double expected_norm = v.norm<double, reduction::MultiAccumulator<16>>();
+    const auto scalar = scalar_result([&] {
+        auto product = std::make_unique<Matrix>();
+        multiply_into(*a, *b, *product);
+        return product;
+    });
+    const double scalar_dot = scalar_result([&] { return v.dot<reduction::Vectorized>(w); });
+    const double scalar_norm = scalar_result([&] { return v.norm<double, reduction::Vectorized>(); });
+
+    for_each_instruction_set([&](const InstructionSet&) {
+        const auto result = std::make_unique<Matrix>();
+        multiply_into(*a, *b, *result);
+        for(std::size_t i = 0; i < n * n; ++i) {
+            ASSERT_NEAR((*result)[i], (*expected)[i], 1e-12);
+            ASSERT_EQ((*result)[i], (*scalar)[i]);
+        }
+        // operator*、operator*=も計算核を使用し、加算順序は変わらない
+        *result = *a * *b;
+        auto product = std::make_unique<Matrix>(*a);
+        *product *= *b;
+        for(std::size_t i = 0; i < n * n; ++i) {
+            ASSERT_EQ((*result)[i], (*scalar)[i]);
+            ASSERT_EQ((*product)[i], (*scalar)[i]);
+        }
+
+        auto sum = std::make_unique<Matrix>(*a);
+        *sum += *b;
+        *sum -= *a;
+        *sum *= 2.0;
+        for(std::size_t i = 0; i < n * n; ++i) {
+            ASSERT_NEAR((*sum)[i], 2.0 * (*b)[i], 1e-15);
+        }
+
+        EXPECT_NEAR(v.dot<reduction::Vectorized>(w), expected_dot, 1e-12);
+        EXPECT_NEAR((v.norm<double, reduction::Vectorized>()), expected_norm, 1e-12);
+        EXPECT_EQ(v.dot<reduction::Vectorized>(w), scalar_dot);
+        EXPECT_EQ((v.norm<double, reduction::Vectorized>()), scalar_norm);
+    });
+}
+TEST(LinearAlgebraStaticMatrixDispatchTest, QuantizedAndComplexTest) {
+    // VNNI(32要素)、vpmaddwd(16要素)、端数の全てを通る長さ
+    constexpr std::size_t n = 91;
+    std::vector<std::uint8_t> ua(n);
+    std::vector<std::int8_t> ia(n), ib(n);
+    std::vector<std::int16_t> wa(n), wb(n);
+    for(std::size_t i = 0; i < n; ++i) {
+        ua[i] = static_cast<std::uint8_t>(i * 37 % 256);
+        ia[i] = static_cast<std::int8_t>(static_cast<int>(i * 71 % 256) - 128);
+        ib[i] = static_cast<std::int8_t>(static_cast<int>(i * 53 % 256) - 128);
+        wa[i] = static_cast<std::int16_t>(static_cast<int>(i * 4099 % 65536) - 32767);
+        wb[i] = static_cast<std::int16_t>(static_cast<int>(i * 911 % 2000) - 1000);
+    }
+    const std::int32_t expected_ub = quantized::dot_scalar(ua.data(), ib.data(), n);
+    const std::int32_t expected_ib = quantized::dot_scalar(ia.data(), ib.data(), n);
+    const std::int32_t expected_w = quantized::dot_scalar(wa.data(), wb.data(), n);
+
+    using Complex = std::complex<double>;
+    constexpr std::size_t rows = 9, mids = 17, cols = 11;
+    StaticMatrixBase<Complex, rows, mids> a;
+    StaticMatrixBase<Complex, mids, cols> b;
+    for(std::size_t i = 0; i < rows * mids; ++i) {
+        a[i] = Complex(std::sin(static_cast<double>(i)), std::cos(static_cast<double>(3 * i)));
+    }
+    for(std::size_t i = 0; i < mids * cols; ++i) {
+        b[i] = Complex(std::cos(static_cast<double>(i)), -std::sin(static_cast<double>(2 * i)));
+    }
+    std::array<Complex, rows * cols> expected;
+    for(std::size_t r = 0; r < rows; ++r) {
+        for(std::size_t c = 0; c < cols; ++c) {
+            Complex sum = 0;
+            for(std::size_t m = 0; m < mids; ++m) {
+                sum += a(r, m) * b(m, c);
+            }
+            expected[r * cols + c] = sum;
+        }
+    }
+
+    std::array<Complex, cols> x;
+    for(std::size_t i = 0; i < cols; ++i) {
+        x[i] = b(3, i);
+    }
+    const auto scalar = scalar_result([&] {
+        StaticMatrixBase<Complex, rows, cols> c;
+        split_complex::multiply(a, b, c);
+        std::array<Complex, rows> y;
+        split_complex::multiply_vector(c, x, y);
+        return std::make_pair(c, y);
+    });
+
+    // 量子化された内積、複素行列の積はいずれも命令セットによらず一致する
+    for_each_instruction_set([&](const InstructionSet&) {
+        EXPECT_EQ(quantized::dot(ua.data(), ib.data(), n), expected_ub);
+        EXPECT_EQ(quantized::dot(ia.data(), ib.data(), n), expected_ib);
+        EXPECT_EQ(quantized::dot(wa.data(), wb.data(), n), expected_w);
+
+        StaticMatrixBase<Complex, rows, cols> c;
+        split_complex::multiply(a, b, c);
+        std::array<Complex, rows> y;
+        split_complex::multiply_vector(StaticMatrixBase<Complex, rows, cols>(c), x, y);
+        for(std::size_t i = 0; i < rows * cols; ++i) {
+            ASSERT_NEAR(std::abs(c[i] - expected[i]), 0.0, 1e-12);
+            ASSERT_EQ(c[i], scalar.first[i]);
+        }
+        for(std::size_t r = 0; r < rows; ++r) {
+            Complex sum = 0;
+            for(std::size_t i = 0; i < cols; ++i) {
+                sum += c(r, i) * x[i];
+            }
+            ASSERT_NEAR(std::abs(y[r] - sum), 0.0, 1e-12);
+            ASSERT_EQ(y[r], scalar.second[r]);
+        }
+    });
+}
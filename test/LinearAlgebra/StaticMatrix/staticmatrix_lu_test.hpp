@@ -0,0 +1,41 @@
+#include <gtest/gtest.h>
+#include <array>
+#include <cmath>
+#include "./../../../include/LinearAlgebra/StaticMatrix/Base/staticmatrix_base.hpp"
+#include "./../../../include/LinearAlgebra/StaticMatrix/Decomposition/staticmatrix_lu.hpp"
+namespace {
+    using namespace klibrary::linear_algebra;
+}
+TEST(LinearAlgebraStaticMatrixLUTest, SolveTest) {
+    StaticMatrixBase<double, 3, 3> a = {{0, 2, 1}, {4, 1, -1}, {2, 3, 5}};
+    std::array<double, 3> x_test = {1, -2, 3};
+    std::array<double, 3> b;
+    for(std::size_t r = 0; r < 3; ++r) {
+        b[r] = 0;
+        for(std::size_t c = 0; c < 3; ++c) {
+            b[r] += a(r, c) * x_test[c];
+        }
+    }
+
+    const StaticMatrixLU<double, 3> lu(a);
+    EXPECT_FALSE(lu.singular());
+    lu.solve_in_place(b);
+    for(std::size_t i = 0; i < 3; ++i) {
+        EXPECT_NEAR(b[i], x_test[i], 1.0e-12);
+    }
+    // det = 0(5 + 3) - 2(20 + 2) + 1(12 - 2)
+    EXPECT_NEAR(lu.determinant(), -34.0, 1.0e-12);
+
+    const auto identity = a * lu.inverse();
+    for(std::size_t r = 0; r < 3; ++r) {
+        for(std::size_t c = 0; c < 3; ++c) {
+            EXPECT_NEAR(identity(r, c), r == c ? 1.0 : 0.0, 1.0e-12);
+        }
+    }
+}
+TEST(LinearAlgebraStaticMatrixLUTest, SingularTest) {
+    StaticMatrixBase<double, 3, 3> a = {{1, 2, 3}, {2, 4, 6}, {1, 0, 1}};
+    StaticMatrixLU<double, 3> lu;
+    EXPECT_FALSE(lu.factorize(a));
+    EXPECT_TRUE(lu.singular());
+}
@@ -0,0 +1,31 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include "./../../../include/LinearAlgebra/StaticMatrix/ModInt/staticmatrix_modint.hpp"
+namespace {
+    using namespace klibrary::linear_algebra;
+}
+TEST(LinearAlgebraStaticMatrixModIntTest, ArithmeticTest) {
+    using Mint = ModInt<998244353>;
+    constexpr std::uint64_t p = 998244353;
+    const Mint a = 123456789, b = -5, c = std::uint64_t(1) << 62;
+    EXPECT_EQ(a.value(), 123456789u);
+    EXPECT_EQ(b.value(), p - 5);
+    EXPECT_EQ(c.value(), (std::uint64_t(1) << 62) % p);
+    EXPECT_EQ((a + b).value(), (123456789 + p - 5) % p);
+    EXPECT_EQ((b - a).value(), (p - 5 - 123456789) % p);
+    EXPECT_EQ((a * b).value(), 123456789 * (p - 5) % p);
+    EXPECT_EQ((a * a.inverse()).value(), 1u);
+    EXPECT_EQ((a / a).value(), 1u);
+    EXPECT_EQ(Mint(3).pow(p - 1), Mint(1));
+    EXPECT_EQ((-Mint(0)).value(), 0u);
+
+    // 遅延還元: 還元せずに累積した内積は逐次還元した内積と一致する
+    Mint expected = 0;
+    Mint::Wide accumulator = 0;
+    for(int i = 0; i < 1000; ++i) {
+        const Mint x = p - 1 - static_cast<std::uint64_t>(i), y = p - 2 - static_cast<std::uint64_t>(3 * i);
+        expected += x * y;
+        Mint::lazy_add(accumulator, Mint::lazy_product(x, y));
+    }
+    EXPECT_EQ(Mint::lazy_reduce(accumulator), expected);
+}
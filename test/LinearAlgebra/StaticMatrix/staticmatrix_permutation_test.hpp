@@ -0,0 +1,103 @@
+#include <gtest/gtest.h>
+#include <array>
+#include <cmath>
+#include "./../../../include/LinearAlgebra/StaticMatrix/Base/staticmatrix_base.hpp"
+#include "./../../../include/LinearAlgebra/StaticMatrix/Permutation/staticmatrix_permutation.hpp"
+#include "./../../../include/LinearAlgebra/StaticMatrix/Decomposition/staticmatrix_lu.hpp"
+namespace {
+    using namespace klibrary::linear_algebra;
+}
+TEST(LinearAlgebraStaticMatrixPermutationTest, AlgebraTest) {
+    StaticPermutation<5> p;
+    EXPECT_TRUE(p.is_identity());
+    EXPECT_EQ(p.sign(), 1);
+    p.swap(0, 3).swap(1, 4).swap(0, 1);
+    EXPECT_EQ(p.map(), (std::array<std::size_t, 5>{4, 3, 2, 0, 1}));
+    EXPECT_EQ(p.sign(), -1);
+
+    const StaticPermutation<5> q({1, 2, 0, 4, 3});
+    EXPECT_EQ(q.sign(), -1);
+    EXPECT_TRUE((p * p.inverse()).is_identity());
+    EXPECT_TRUE((p.inverse() * p).is_identity());
+    EXPECT_EQ((p * q).sign(), p.sign() * q.sign());
+
+    // 合成と逆置換は置換行列の積と転置に一致する
+    const auto dense_p = p.to_matrix<int>();
+    const auto dense_q = q.to_matrix<int>();
+    const auto dense_pq = (p * q).to_matrix<int>();
+    const auto product = dense_p * dense_q;
+    const auto inverse = p.inverse().to_matrix<int>();
+    for(std::size_t r = 0; r < 5; ++r) {
+        for(std::size_t c = 0; c < 5; ++c) {
+            EXPECT_EQ(dense_pq(r, c), product(r, c));
+            EXPECT_EQ(inverse(r, c), dense_p(c, r));
+        }
+    }
+}
+TEST(LinearAlgebraStaticMatrixPermutationTest, ApplyTest) {
+    const StaticPermutation<4> p({2, 0, 3, 1});
+    StaticMatrixBase<int, 4, 3> a;
+    StaticMatrixBase<int, 3, 4> b;
+    for(std::size_t i = 0; i < 12; ++i) {
+        a[i] = static_cast<int>(i);
+        b[i] = static_cast<int>(i * i);
+    }
+    const auto dense = p.to_matrix<int>();
+
+    // 行列を作らない積は置換行列との積に一致する
+    const auto pa = p * a;
+    const auto expected_pa = dense * a;
+    const auto bp = b * p;
+    const auto expected_bp = b * dense;
+    for(std::size_t i = 0; i < 12; ++i) {
+        EXPECT_EQ(pa[i], expected_pa[i]);
+        EXPECT_EQ(bp[i], expected_bp[i]);
+    }
+    auto in_place = a;
+    p.permute_rows_in_place(in_place);
+    for(std::size_t i = 0; i < 12; ++i) {
+        EXPECT_EQ(in_place[i], expected_pa[i]);
+    }
+
+    // 記録した行の入れ替えを1度に適用した結果はswap_rowsを順に行った結果に一致する
+    StaticPermutation<4> recorded;
+    auto swapped = a;
+    for(const auto& [i, j] : {std::pair<std::size_t, std::size_t>{0, 3}, {1, 2}, {3, 1}, {2, 2}}) {
+        recorded.swap(i, j);
+        swapped.swap_rows(i, j);
+    }
+    const auto applied = recorded * a;
+    for(std::size_t i = 0; i < 12; ++i) {
+        EXPECT_EQ(applied[i], swapped[i]);
+    }
+
+    const std::array<int, 4> x = {10, 20, 30, 40};
+    std::array<int, 4> y;
+    p.apply(x, y);
+    EXPECT_EQ(y, (std::array<int, 4>{30, 10, 40, 20}));
+}
+TEST(LinearAlgebraStaticMatrixPermutationTest, LUTest) {
+    StaticMatrixBase<double, 4, 4> a = {{0, 2, 1, 3}, {4, 1, -1, 2}, {2, 3, 5, -2}, {1, -3, 2, 6}};
+    const StaticMatrixLU<double, 4> lu(a);
+    ASSERT_FALSE(lu.singular());
+    const auto& p = lu.permutation();
+    EXPECT_FALSE(p.is_identity());
+    EXPECT_EQ(p[0], 1u);
+
+    // PAは既にピボット順に並んでいるため、PAの分解では行を入れ替えない。det(PA) = sign(P) det(A)
+    const StaticMatrixLU<double, 4> permuted(p * a);
+    EXPECT_TRUE(permuted.permutation().is_identity());
+    EXPECT_NEAR(permuted.determinant(), p.sign() * lu.determinant(), 1e-12);
+
+    // 行を移動せずに分解した結果で解く
+    std::array<double, 4> b = {1, 2, 3, 4};
+    std::array<double, 4> x = b;
+    lu.solve_in_place(x);
+    for(std::size_t r = 0; r < 4; ++r) {
+        double sum = 0;
+        for(std::size_t c = 0; c < 4; ++c) {
+            sum += a(r, c) * x[c];
+        }
+        EXPECT_NEAR(sum, b[r], 1e-12);
+    }
+}
@@ -0,0 +1,66 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstdint>
+#include "./../../../include/LinearAlgebra/StaticMatrix/Base/staticmatrix_base.hpp"
+#include "./../../../include/LinearAlgebra/StaticMatrix/ModInt/staticmatrix_modint.hpp"
+#include "./../../../include/LinearAlgebra/StaticMatrix/Power/staticmatrix_power.hpp"
+namespace {
+    using namespace klibrary::linear_algebra;
+}
+TEST(LinearAlgebraStaticMatrixPowerTest, PowTest) {
+    const StaticMatrixBase<long long, 2, 2> fibonacci = {{1, 1}, {1, 0}};
+    const auto f0 = pow(fibonacci, 0);
+    EXPECT_EQ(f0(0, 0), 1);
+    EXPECT_EQ(f0(0, 1), 0);
+    const auto f1 = pow(fibonacci, 1);
+    EXPECT_EQ(f1(0, 1), 1);
+    const auto f90 = pow(fibonacci, 90);
+    EXPECT_EQ(f90(0, 1), 2880067194370816120LL);
+    EXPECT_EQ(f90(0, 0), f90(0, 1) + f90(1, 1));
+
+    StaticMatrixBase<double, 3, 3> a = {{0.5, 0.1, 0.0}, {0.2, 0.3, 0.1}, {0.0, 0.4, 0.6}};
+    auto expected = a;
+    for(int i = 1; i < 13; ++i) {
+        expected = expected * a;
+    }
+    const auto a13 = pow(a, 13);
+    for(std::size_t i = 0; i < 9; ++i) {
+        EXPECT_NEAR(a13[i], expected[i], 1e-15);
+    }
+}
+TEST(LinearAlgebraStaticMatrixPowerTest, ModularPowTest) {
+    using Mint = ModInt<1000000007>;
+    // F(10^18) mod 1e9+7 = 209783453
+    const StaticMatrixBase<Mint, 2, 2> fibonacci = {{1, 1}, {1, 0}};
+    EXPECT_EQ(pow(fibonacci, 1000000000000000000ULL)(0, 1).value(), 209783453u);
+
+    // 遅延還元の積と通常の積の比較
+    StaticMatrixBase<Mint, 24, 24> m;
+    for(std::size_t i = 0; i < 24 * 24; ++i) {
+        m[i] = Mint(1000000006 - static_cast<long long>(i * i * 7919));
+    }
+    StaticMatrixBase<Mint, 24, 24> lazy;
+    multiply_into(m, m, lazy);
+    const auto naive = m * m;
+    for(std::size_t i = 0; i < 24 * 24; ++i) {
+        EXPECT_EQ(lazy[i], naive[i]);
+    }
+}
+TEST(LinearAlgebraStaticMatrixPowerTest, ExpmTest) {
+    // exp([[0, t], [-t, 0]]) = [[cos t, sin t], [-sin t, cos t]] (各次数とスケーリングを通る)
+    for(const double t : {0.001, 0.1, 0.5, 1.5, 4.0, 50.0}) {
+        const StaticMatrixBase<double, 2, 2> rotation = {{0, t}, {-t, 0}};
+        const auto e = expm(rotation);
+        EXPECT_NEAR(e(0, 0), std::cos(t), 1e-13 * (1 + t));
+        EXPECT_NEAR(e(0, 1), std::sin(t), 1e-13 * (1 + t));
+        EXPECT_NEAR(e(1, 0), -std::sin(t), 1e-13 * (1 + t));
+        EXPECT_NEAR(e(1, 1), std::cos(t), 1e-13 * (1 + t));
+    }
+    // 上三角: exp([[a, b], [0, c]]) = [[e^a, b (e^a - e^c) / (a - c)], [0, e^c]]
+    const StaticMatrixBase<double, 2, 2> triangular = {{1.0, 2.0}, {0.0, -3.0}};
+    const auto e = expm(triangular);
+    EXPECT_NEAR(e(0, 0), std::exp(1.0), 1e-13);
+    EXPECT_NEAR(e(0, 1), 2 * (std::exp(1.0) - std::exp(-3.0)) / 4, 1e-13);
+    EXPECT_NEAR(e(1, 0), 0, 1e-15);
+    EXPECT_NEAR(e(1, 1), std::exp(-3.0), 1e-14);
+}
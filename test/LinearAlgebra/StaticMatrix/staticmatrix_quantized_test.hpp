@@ -0,0 +1,91 @@
+#include <gtest/gtest.h>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include "./../../../include/LinearAlgebra/StaticMatrix/Base/staticmatrix_base.hpp"
+#include "./../../../include/LinearAlgebra/StaticMatrix/Quantized/staticmatrix_quantized.hpp"
+namespace {
+    using namespace klibrary::linear_algebra;
+}
+TEST(LinearAlgebraStaticMatrixQuantizedTest, QuantizationTest) {
+    const auto q = choose_quantization<std::uint8_t>(-1.0f, 3.0f);
+    EXPECT_FLOAT_EQ(q.scale, 4.0f / 255);
+    EXPECT_EQ(quantize<std::uint8_t>(0.0f, q), q.zero_point);
+    EXPECT_EQ(quantize<std::uint8_t>(3.0f, q), 255);
+    EXPECT_EQ(quantize<std::uint8_t>(-5.0f, q), 0);
+    const auto s = choose_quantization<std::int8_t>(0.5f, 2.0f);
+    EXPECT_EQ(s.zero_point, -128);
+    EXPECT_EQ(quantize<std::int8_t>(100.0f, s), 127);
+}
+TEST(LinearAlgebraStaticMatrixQuantizedTest, MultiplyTest) {
+    // ベクトル化部分と端数の両方を通る大きさ
+    constexpr std::size_t rows = 5, mids = 75, cols = 6;
+    StaticMatrixBase<std::uint8_t, rows, mids> a;
+    StaticMatrixBase<std::int8_t, mids, cols> b;
+    Array<Quantization, rows> qa;
+    Array<Quantization, cols> qb;
+    for(std::size_t i = 0; i < rows * mids; ++i) {
+        a[i] = static_cast<std::uint8_t>(i * 37 % 256);
+    }
+    for(std::size_t i = 0; i < mids * cols; ++i) {
+        b[i] = static_cast<std::int8_t>(static_cast<int>(i * 53 % 256) - 128);
+    }
+    for(std::size_t r = 0; r < rows; ++r) {
+        qa[r] = {0.01f, static_cast<std::int32_t>(100 + r)};
+    }
+    for(std::size_t c = 0; c < cols; ++c) {
+        qb[c] = {0.02f, static_cast<std::int32_t>(c) - 3};
+    }
+
+    StaticMatrixBase<std::int32_t, rows, cols> accumulator;
+    quantized_multiply_into(a, qa, b, qb, accumulator);
+    for(std::size_t r = 0; r < rows; ++r) {
+        for(std::size_t c = 0; c < cols; ++c) {
+            std::int32_t expected = 0;
+            for(std::size_t m = 0; m < mids; ++m) {
+                expected += (a(r, m) - qa[r].zero_point) * (b(m, c) - qb[c].zero_point);
+            }
+            EXPECT_EQ(accumulator(r, c), expected);
+        }
+    }
+
+    // 行列-ベクトル積は1列の行列積と一致する
+    Array<std::int8_t, mids> x;
+    for(std::size_t m = 0; m < mids; ++m) {
+        x[m] = b(m, 2);
+    }
+    Array<std::int32_t, rows> y;
+    quantized_multiply_vector_into(a, qa, x, qb[2], y);
+    for(std::size_t r = 0; r < rows; ++r) {
+        EXPECT_EQ(y[r], accumulator(r, 2));
+    }
+
+    // int16 x int16
+    StaticMatrixBase<std::int16_t, 2, 33> wide_a(-30000);
+    StaticMatrixBase<std::int16_t, 33, 2> wide_b(2);
+    StaticMatrixBase<std::int32_t, 2, 2> wide;
+    quantized_multiply_into(wide_a, Array<Quantization, 2>{}, wide_b, Array<Quantization, 2>{}, wide);
+    EXPECT_EQ(wide(1, 1), -30000 * 2 * 33);
+}
+TEST(LinearAlgebraStaticMatrixQuantizedTest, RequantizeTest) {
+    const StaticMatrixBase<float, 3, 4> a = {{0.5f, -1.0f, 2.0f, 0.0f}, {1.5f, 0.25f, -0.75f, 1.0f}, {-2.0f, 0.5f, 0.5f, -0.5f}};
+    const StaticMatrixBase<float, 4, 2> b = {{1.0f, -0.5f}, {0.5f, 2.0f}, {-1.0f, 1.0f}, {0.25f, 0.0f}};
+    const auto expected = a * b;
+
+    StaticMatrixBase<std::uint8_t, 3, 4> qa;
+    StaticMatrixBase<std::int8_t, 4, 2> qb;
+    const auto lhs = quantize_rows(a, qa);
+    const auto rhs = quantize_cols(b, qb);
+    StaticMatrixBase<std::int32_t, 3, 2> accumulator;
+    quantized_multiply_into(qa, lhs, qb, rhs, accumulator);
+
+    StaticMatrixBase<float, 3, 2> real;
+    dequantize_into(accumulator, lhs, rhs, real);
+    const auto output = choose_quantization<std::int8_t>(-4.0f, 4.0f);
+    StaticMatrixBase<std::int8_t, 3, 2> requantized;
+    requantize_into(accumulator, lhs, rhs, output, requantized);
+    for(std::size_t i = 0; i < 6; ++i) {
+        EXPECT_NEAR(real[i], expected[i], 0.05);
+        EXPECT_NEAR(output.scale * static_cast<float>(requantized[i] - output.zero_point), expected[i], 0.06);
+    }
+}
@@ -0,0 +1,145 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <vector>
+#include <random>
+#include "./../../../include/LinearAlgebra/StaticMatrix/Random/staticmatrix_random.hpp"
+#include "./../../../include/LinearAlgebra/StaticMatrix/BasicMatrices/staticmatrix_basic_matrices.hpp"
+#include "./../../../include/LinearAlgebra/StaticMatrix/Vector/staticvector.hpp"
+#include "./../../../include/Parallel/parallel_for.hpp"
+namespace {
+    using namespace klibrary::linear_algebra;
+}
+TEST(LinearAlgebraStaticMatrixRandomTest, PhiloxTest) {
+    // Random123の既知解
+    using Block = Philox4x32::Block;
+    EXPECT_EQ(Philox4x32::block({0, 0}, {0, 0, 0, 0}), (Block{0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8}));
+    EXPECT_EQ(Philox4x32::block({0xffffffff, 0xffffffff}, {0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff}), (Block{0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd}));
+    EXPECT_EQ(Philox4x32::block({0xa4093822, 0x299f31d0}, {0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344}), (Block{0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1}));
+
+    // 系列はブロック(ブロック番号、ストリーム番号)を順に並べたもの
+    constexpr std::uint64_t seed = 0x0123456789abcdef, stream = 0x1122334455667788;
+    Philox4x32 engine(seed, stream);
+    for(std::uint32_t b = 0; b < 3; ++b) {
+        const Block expected = Philox4x32::block({0x89abcdef, 0x01234567}, {b, 0, 0x55667788, 0x11223344});
+        for(const std::uint32_t word : expected) {
+            ASSERT_EQ(engine(), word);
+        }
+    }
+
+    // generate、operator()、discardを混ぜても同じ系列を取り出す
+    constexpr std::size_t n = 1000;
+    std::vector<std::uint32_t> expected(n);
+    Philox4x32 reference(seed, stream);
+    for(auto& word : expected) {
+        word = reference();
+    }
+    Philox4x32 mixed(seed, stream);
+    std::vector<std::uint32_t> words(n);
+    std::size_t i = 0;
+    words[i++] = mixed();
+    mixed.generate(words.data() + i, 6);
+    i += 6;
+    mixed.discard(3);
+    i += 3;
+    mixed.generate(words.data() + i, 301);
+    i += 301;
+    mixed.discard(130);
+    i += 130;
+    words[i++] = mixed();
+    mixed.generate(words.data() + i, n - i);
+    for(std::size_t j = 0; j < n; ++j) {
+        if((7 <= j && j < 10) || (311 <= j && j < 441)) {
+            continue;
+        }
+        ASSERT_EQ(words[j], expected[j]);
+    }
+
+    // ストリームは独立であり、splitは先頭から生成する
+    Philox4x32 other = mixed.split(stream + 1);
+    EXPECT_EQ(other.stream(), stream + 1);
+    EXPECT_NE(other(), expected[0]);
+    EXPECT_EQ(mixed.split(stream)(), expected[0]);
+
+    // <random>の分布と組み合わせられる
+    std::uniform_int_distribution<int> distribution(1, 6);
+    const int die = distribution(engine);
+    EXPECT_TRUE(1 <= die && die <= 6);
+}
+TEST(LinearAlgebraStaticMatrixRandomTest, DistributionTest) {
+    Philox4x32 engine(42);
+    const auto uniform = StaticMatrixBasicMatrices<double, 100, 100>::Random(engine, -1.0, 3.0);
+    double mean = 0, square = 0;
+    for(std::size_t i = 0; i < 100 * 100; ++i) {
+        ASSERT_TRUE(-1.0 <= uniform[i] && uniform[i] < 3.0);
+        mean += uniform[i];
+        square += uniform[i] * uniform[i];
+    }
+    mean /= 10000;
+    EXPECT_NEAR(mean, 1.0, 0.05);
+    EXPECT_NEAR(square / 10000 - mean * mean, 16.0 / 12.0, 0.05);
+
+    const auto normal = StaticVectorBasicVectors<float, 1, 10001>::RandomNormal(engine, 2.0f, 0.5f);
+    mean = 0;
+    square = 0;
+    for(std::size_t i = 0; i < 10001; ++i) {
+        ASSERT_TRUE(std::isfinite(normal[i]));
+        mean += normal[i];
+        square += normal[i] * normal[i];
+    }
+    mean /= 10001;
+    EXPECT_NEAR(mean, 2.0, 0.02);
+    EXPECT_NEAR(std::sqrt(square / 10001 - mean * mean), 0.5, 0.02);
+}
+TEST(LinearAlgebraStaticMatrixRandomTest, StructuredMatrixTest) {
+    constexpr std::size_t n = 12;
+    Philox4x32 engine(7);
+    const auto q = StaticMatrixBasicMatrices<double, n, n>::RandomOrthogonal(engine);
+    for(std::size_t r = 0; r < n; ++r) {
+        for(std::size_t c = 0; c < n; ++c) {
+            double sum = 0;
+            for(std::size_t k = 0; k < n; ++k) {
+                sum += q(k, r) * q(k, c);
+            }
+            ASSERT_NEAR(sum, r == c ? 1.0 : 0.0, 1e-12);
+        }
+    }
+
+    const auto spd = StaticMatrixBasicMatrices<double, n, n>::RandomSPD(engine, 2.0, 5.0);
+    const auto x = StaticVectorBasicVectors<double, n, 1>::RandomNormal(engine);
+    double xx = 0, xax = 0, trace = 0;
+    for(std::size_t r = 0; r < n; ++r) {
+        trace += spd(r, r);
+        xx += x[r] * x[r];
+        for(std::size_t c = 0; c < n; ++c) {
+            ASSERT_EQ(spd(r, c), spd(c, r));
+            xax += x[r] * spd(r, c) * x[c];
+        }
+    }
+    // Rayleigh商と固有値の平均は固有値の範囲に含まれる
+    EXPECT_TRUE(2.0 <= xax / xx && xax / xx < 5.0);
+    EXPECT_TRUE(2.0 <= trace / n && trace / n < 5.0);
+}
+TEST(LinearAlgebraStaticMatrixRandomTest, ParallelStreamTest) {
+    // スレッドごとにストリームを分けると、スレッド数に依らず同じ結果になる
+    constexpr std::size_t batches = 64;
+    using Matrix = StaticMatrixBasicMatrices<float, 8, 8>;
+    const Philox4x32 root(2024);
+    const auto fill = [&](const std::size_t& threads) {
+        std::vector<Matrix> result(batches);
+        klibrary::parallel::parallel_for(0, batches, threads, [&](const std::size_t& begin, const std::size_t& end) {
+            for(std::size_t b = begin; b < end; ++b) {
+                Philox4x32 engine = root.split(b);
+                result[b] = Matrix::RandomNormal(engine);
+            }
+        });
+        return result;
+    };
+    const auto serial = fill(1);
+    const auto parallel = fill(4);
+    for(std::size_t b = 0; b < batches; ++b) {
+        for(std::size_t i = 0; i < 64; ++i) {
+            ASSERT_EQ(serial[b][i], parallel[b][i]);
+        }
+    }
+    EXPECT_NE(serial[0][0], serial[1][0]);
+}
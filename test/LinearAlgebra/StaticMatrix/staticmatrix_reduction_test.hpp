@@ -0,0 +1,74 @@
+#include <gtest/gtest.h>
+#include <array>
+#include <cmath>
+#include "./../../../include/LinearAlgebra/StaticMatrix/Base/staticmatrix_base.hpp"
+#include "./../../../include/LinearAlgebra/StaticMatrix/Reduction/staticmatrix_reduction.hpp"
+#include "./../../../include/LinearAlgebra/StaticMatrix/Vector/Geometory/staticvector_geometory.hpp"
+namespace {
+    using namespace klibrary::linear_algebra;
+}
+template <class Policy>
+void reduction_exact_test() {
+    // 整数の総和はどのポリシーでも一致する
+    for(std::size_t n = 0; n < 200; ++n) {
+        const auto sum = Policy::template sum<long long>(n, [](const std::size_t& i){ return static_cast<long long>(i); });
+        EXPECT_EQ(sum, static_cast<long long>(n * (n - (n > 0 ? 1 : 0)) / 2));
+    }
+}
+TEST(LinearAlgebraStaticMatrixReductionTest, ExactTest) {
+    reduction_exact_test<reduction::Sequential>();
+    reduction_exact_test<reduction::MultiAccumulator<>>();
+    reduction_exact_test<reduction::MultiAccumulator<4>>();
+    reduction_exact_test<reduction::Pairwise<>>();
+    reduction_exact_test<reduction::Pairwise<8>>();
+    reduction_exact_test<reduction::Compensated<>>();
+}
+TEST(LinearAlgebraStaticMatrixReductionTest, AccuracyTest) {
+    // floatでの総和の誤差をdoubleでの総和と比較する
+    constexpr std::size_t n = 1 << 16;
+    const auto term = [](const std::size_t& i){ return 0.1f + static_cast<float>(i % 7) * 1.0e-3f; };
+
+    double reference = 0.0;
+    for(std::size_t i = 0; i < n; ++i) {
+        reference += static_cast<double>(term(i));
+    }
+    const auto error = [&](const float sum){ return std::abs(static_cast<double>(sum) - reference) / reference; };
+
+    const float sequential  = reduction::Sequential::sum<float>(n, term);
+    const float pairwise    = reduction::Pairwise<>::sum<float>(n, term);
+    const float compensated = reduction::Compensated<>::sum<float>(n, term);
+
+    EXPECT_LT(error(pairwise), error(sequential));
+    EXPECT_LT(error(compensated), 1.0e-7);
+    EXPECT_LE(error(compensated), error(pairwise));
+}
+TEST(LinearAlgebraStaticMatrixReductionTest, VectorTest) {
+    StaticVectorGeometory<float, 1, 1024> v1(0.1f);
+    StaticVectorGeometory<float, 1, 1024> v2(3.0f);
+    StaticVectorGeometory<int, 1, 3> v3{3, 4, 5};
+    StaticVectorGeometory<int, 1, 3> v4{7, 2, 4};
+
+    const double dot_test = 1024 * static_cast<double>(0.1f) * 3.0;
+    const double norm_test = std::sqrt(1024.0) * static_cast<double>(0.1f);
+
+    EXPECT_NEAR(v1.dot<reduction::Compensated<>>(v2), dot_test, dot_test * 1.0e-7);
+    EXPECT_NEAR(v1.dot<reduction::Pairwise<>>(v2), dot_test, dot_test * 1.0e-6);
+    EXPECT_NEAR((v1.norm<float, reduction::Compensated<>>()), norm_test, norm_test * 1.0e-7);
+    EXPECT_NEAR((v1.norm<double, reduction::MultiAccumulator<>>(1)), 1024 * static_cast<double>(0.1f), 1.0e-9);
+    EXPECT_EQ(v3.dot<reduction::MultiAccumulator<>>(v4), 21 + 8 + 20);
+    EXPECT_DOUBLE_EQ((v3.norm<double, reduction::Pairwise<>>(3)), std::cbrt(27.0 + 64.0 + 125.0));
+}
+TEST(LinearAlgebraStaticMatrixReductionTest, MultiplyTest) {
+    StaticMatrixBase<int, 2, 3>     m1 = {1, 2, 3, 4, 5, 6};
+    StaticMatrixBase<double, 3, 4>  m2 = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12};
+    StaticMatrixBase<double, 2, 4>  m3 = {38, 44, 50, 56, 83, 98, 113, 128};
+
+    const auto mul1 = multiply<reduction::MultiAccumulator<>>(m1, m2);
+    const auto mul2 = multiply<reduction::Pairwise<>>(m1, m2);
+    const auto mul3 = multiply<reduction::Compensated<>>(m1, m2);
+    for(std::size_t i = 0; i < 8; ++i) {
+        EXPECT_EQ(mul1.at(i), m3.at(i));
+        EXPECT_EQ(mul2.at(i), m3.at(i));
+        EXPECT_EQ(mul3.at(i), m3.at(i));
+    }
+}
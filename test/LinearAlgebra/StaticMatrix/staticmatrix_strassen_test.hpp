@@ -0,0 +1,60 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <memory>
+#include "./../../../include/LinearAlgebra/StaticMatrix/Base/staticmatrix_base.hpp"
+#include "./../../../include/LinearAlgebra/StaticMatrix/Power/staticmatrix_power.hpp"
+#include "./../../../include/LinearAlgebra/StaticMatrix/Strassen/staticmatrix_strassen.hpp"
+namespace {
+    using namespace klibrary::linear_algebra;
+}
+TEST(LinearAlgebraStaticMatrixStrassenTest, ExactTest) {
+    // 整数行列では結果は古典的な乗算と完全に一致する (奇数次の切り出しを含む)
+    constexpr std::size_t n = 203;
+    using Matrix = StaticMatrixBase<long long, n, n>;
+    const auto a = std::make_unique<Matrix>();
+    const auto b = std::make_unique<Matrix>();
+    for(std::size_t i = 0; i < n * n; ++i) {
+        (*a)[i] = static_cast<long long>(i * 7 % 23) - 11;
+        (*b)[i] = static_cast<long long>(i * 13 % 17) - 8;
+    }
+    const auto expected = std::make_unique<Matrix>();
+    multiply_into(*a, *b, *expected);
+
+    for(const std::size_t threads : {1, 3}) {
+        const StrassenOptions options = {.crossover = 16, .threads = threads};
+        StrassenWorkspace<long long> workspace(n, options);
+        EXPECT_EQ(workspace.size(), StrassenWorkspace<long long>::required_size(n, options));
+        const auto result = std::make_unique<Matrix>();
+        strassen_multiply_into(*a, *b, *result, workspace, options);
+        for(std::size_t i = 0; i < n * n; ++i) {
+            ASSERT_EQ((*result)[i], (*expected)[i]);
+        }
+    }
+}
+TEST(LinearAlgebraStaticMatrixStrassenTest, FloatingPointTest) {
+    constexpr std::size_t n = 256;
+    using Matrix = StaticMatrixBase<double, n, n>;
+    const auto a = std::make_unique<Matrix>();
+    const auto b = std::make_unique<Matrix>();
+    for(std::size_t i = 0; i < n * n; ++i) {
+        (*a)[i] = std::sin(static_cast<double>(i));
+        (*b)[i] = std::cos(static_cast<double>(3 * i));
+    }
+    const auto expected = std::make_unique<Matrix>();
+    const auto result = std::make_unique<Matrix>();
+    multiply_into(*a, *b, *expected);
+    strassen_multiply_into(*a, *b, *result, {.crossover = 32, .threads = 2});
+    // 誤差の上限 [(n/n0)^log2(18) (n0^2 + 6 n0) - 6n] u max|A| max|B| より十分小さい
+    for(std::size_t i = 0; i < n * n; ++i) {
+        ASSERT_NEAR((*result)[i], (*expected)[i], 1e-11);
+    }
+
+    // crossover以下では古典的な乗算のみを行う
+    StaticMatrixBase<double, 4, 4> small = {{1, 2, 3, 4}, {5, 6, 7, 8}, {9, 10, 11, 12}, {13, 14, 15, 16}};
+    StaticMatrixBase<double, 4, 4> square;
+    strassen_multiply_into(small, small, square);
+    const auto product = small * small;
+    for(std::size_t i = 0; i < 16; ++i) {
+        EXPECT_EQ(square[i], product[i]);
+    }
+}
@@ -0,0 +1,78 @@
+#include <gtest/gtest.h>
+#include "../../include/NumericalAnalysis/batch_root_finding.hpp"
+#include "../../include/NumericalAnalysis/approximation_algorithm.hpp"
+
+#include <vector>
+#include <cmath>
+namespace {
+    using namespace numerical_analysis;
+}
+TEST(NumericalAnalysisBatchRootFindingTest, NewtonRaphsonBatchTest) {
+    // x^3 - 2 = 0 を多数の初期値について解き、1つずつ解いた結果と比較する
+    constexpr std::size_t n = 1003;
+    const auto f  = [](const double x) { return x * x * x - 2.0; };
+    const auto df = [](const double x) { return 3 * x * x; };
+    std::vector<double> xs(n);
+    for(std::size_t i = 0; i < n; ++i) {
+        xs[i] = 0.5 + 0.01 * static_cast<double>(i);
+    }
+    for(const std::size_t threads : {1, 4}) {
+        std::vector<double> roots(n);
+        std::vector<SolverStatus> status(n);
+        newton_raphson_batch(xs, f, df, roots, status, 1.0e-12, 100, threads);
+        for(std::size_t i = 0; i < n; ++i) {
+            EXPECT_EQ(status[i], SolverStatus::Converged);
+            EXPECT_NEAR(roots[i], std::cbrt(2.0), 1.0e-12);
+            EXPECT_DOUBLE_EQ(roots[i], newton_raphson(xs[i], f, df, 1.0e-12, 100));
+        }
+    }
+}
+TEST(NumericalAnalysisBatchRootFindingTest, NewtonRaphsonBatchStatusTest) {
+    // 微分が0になるレーン、最大試行回数に達するレーンの状態
+    const std::vector<double> xs = {0.0, 1.0, 1.0e6};
+    std::vector<double> roots(3);
+    std::vector<SolverStatus> status(3);
+    newton_raphson_batch(xs, [](const double x){ return x * x - 2.0; }, [](const double x){ return 2 * x; }, roots, status, 1.0e-12, 8);
+    EXPECT_EQ(status[0], SolverStatus::Diverged);
+    EXPECT_EQ(status[1], SolverStatus::Converged);
+    EXPECT_EQ(status[2], SolverStatus::MaxAttemptsReached);
+    EXPECT_NEAR(roots[1], std::sqrt(2.0), 1.0e-12);
+}
+TEST(NumericalAnalysisBatchRootFindingTest, BisectionMethodBatchTest) {
+    // cos(x) - x/k = 0 の解をkごとに求める (各レーンの範囲は[0, π/2])
+    constexpr std::size_t n = 517;
+    std::vector<double> ls(n, 0.0);
+    std::vector<double> rs(n, 1.5707963267948966);
+    std::vector<double> roots(n);
+    std::vector<SolverStatus> status(n);
+    rs[3] = 0.1;
+    for(const std::size_t threads : {1, 3}) {
+        bisection_method_batch(ls, rs, [](const double x){ return std::cos(x) - x; }, roots, status, 1.0e-10, Constants::bisection_max_attempts, threads);
+        for(std::size_t i = 0; i < n; ++i) {
+            if(i == 3) {
+                EXPECT_EQ(status[i], SolverStatus::InvalidBracket);
+                continue;
+            }
+            EXPECT_EQ(status[i], SolverStatus::Converged);
+            EXPECT_NEAR(roots[i], 0.7390851332151607, 1.0e-10);
+        }
+    }
+}
+TEST(NumericalAnalysisBatchRootFindingTest, BisectionMethodBatchStatusTest) {
+    // 中点が端点と一致して幅がepsilonより小さくならないレーン、最大試行回数に達するレーンの状態
+    const std::vector<double> ls = {1.0e12, 0.0, 0.0};
+    const std::vector<double> rs = {1.0e12 + 10.0, 1.5707963267948966, 1.5707963267948966};
+    std::vector<double> roots(3);
+    std::vector<SolverStatus> status(3);
+    const auto f = [](const double x){ return x < 1.0e6 ? std::cos(x) - x : x - 1.000000000002e12; };
+    for(const double epsilon : {1.0e-10, 0.0}) {
+        bisection_method_batch(ls, rs, f, roots, status, epsilon);
+        EXPECT_EQ(status[0], SolverStatus::Converged);
+        EXPECT_EQ(status[1], SolverStatus::Converged);
+        EXPECT_NEAR(roots[0], 1.000000000002e12, 1.0e-3);
+        EXPECT_NEAR(roots[1], 0.7390851332151607, 1.0e-10);
+    }
+    bisection_method_batch(ls, rs, f, roots, status, 1.0e-10, 5);
+    EXPECT_EQ(status[0], SolverStatus::MaxAttemptsReached);
+    EXPECT_EQ(status[2], SolverStatus::MaxAttemptsReached);
+}
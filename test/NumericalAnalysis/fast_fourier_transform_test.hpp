@@ -0,0 +1,113 @@
+#include <gtest/gtest.h>
+#include "../../include/NumericalAnalysis/fast_fourier_transform.hpp"
+
+#include <cmath>
+#include <vector>
+#include <numbers>
+namespace {
+    using namespace numerical_analysis;
+    std::vector<Complex> naive_dft(const std::vector<Complex>& x) {
+        const std::size_t n = x.size();
+        std::vector<Complex> result(n);
+        for(std::size_t k = 0; k < n; ++k) {
+            for(std::size_t j = 0; j < n; ++j) {
+                const double phase = -2 * std::numbers::pi * static_cast<double>((j * k) % n) / static_cast<double>(n);
+                result[k] += x[j] * Complex(std::cos(phase), std::sin(phase));
+            }
+        }
+        return result;
+    }
+    std::vector<Complex> test_signal(const std::size_t& n) {
+        std::vector<Complex> x(n);
+        for(std::size_t j = 0; j < n; ++j) {
+            x[j] = {std::sin(0.3 * j + 0.1) + 0.5, std::cos(1.7 * j) - 0.25 * j / n};
+        }
+        return x;
+    }
+}
+TEST(NumericalAnalysisFFTTest, ComplexTransformTest) {
+    // 基数4, 2, 3, 5, 一般の基数、Bluesteinのアルゴリズム(97, 2 * 37)を含む長さ
+    for(const std::size_t n : {1u, 2u, 3u, 4u, 5u, 6u, 8u, 12u, 16u, 30u, 49u, 64u, 74u, 97u, 100u, 1000u, 1024u}) {
+        const auto x = test_signal(n);
+        const auto expected = naive_dft(x);
+        auto y = x;
+        fft(y);
+        for(std::size_t k = 0; k < n; ++k) {
+            EXPECT_NEAR(std::abs(y[k] - expected[k]), 0.0, 1e-9 * static_cast<double>(n)) << "n = " << n << ", k = " << k;
+        }
+        ifft(y);
+        for(std::size_t k = 0; k < n; ++k) {
+            EXPECT_NEAR(std::abs(y[k] - x[k]), 0.0, 1e-12) << "n = " << n;
+        }
+    }
+}
+TEST(NumericalAnalysisFFTTest, RealTransformTest) {
+    for(const std::size_t n : {1u, 2u, 7u, 8u, 10u, 97u, 128u, 194u}) {
+        std::vector<double> x(n);
+        std::vector<Complex> complex_x(n);
+        for(std::size_t j = 0; j < n; ++j) {
+            x[j] = std::sin(0.7 * j) + 0.1 * j;
+            complex_x[j] = x[j];
+        }
+        const auto expected = naive_dft(complex_x);
+        std::vector<Complex> spectrum(n / 2 + 1);
+        rfft(x, spectrum);
+        for(std::size_t k = 0; k < spectrum.size(); ++k) {
+            EXPECT_NEAR(std::abs(spectrum[k] - expected[k]), 0.0, 1e-9 * static_cast<double>(n)) << "n = " << n << ", k = " << k;
+        }
+        std::vector<double> restored(n);
+        irfft(spectrum, restored);
+        for(std::size_t j = 0; j < n; ++j) {
+            EXPECT_NEAR(restored[j], x[j], 1e-12) << "n = " << n;
+        }
+    }
+}
+TEST(NumericalAnalysisFFTTest, PlanCacheTest) {
+    const auto plan = fft_plan(48);
+    EXPECT_EQ(plan, fft_plan(48));
+    EXPECT_EQ(plan->size(), 48u);
+    EXPECT_NE(plan, fft_plan(96));
+    EXPECT_EQ(real_fft_plan(48), real_fft_plan(48));
+}
+TEST(NumericalAnalysisFFTTest, StaticRowVectorTest) {
+    klibrary::linear_algebra::StaticRowVector<double, 8> x;
+    for(std::size_t j = 0; j < 8; ++j) {
+        x[j] = std::cos(2 * std::numbers::pi * j / 8);
+    }
+    const auto spectrum = rfft(x);
+    EXPECT_NEAR(spectrum[1].real(), 4.0, 1e-12);
+    EXPECT_NEAR(std::abs(spectrum[0]) + std::abs(spectrum[2]) + std::abs(spectrum[3]) + std::abs(spectrum[4]), 0.0, 1e-12);
+    const auto restored = irfft<8>(spectrum);
+    for(std::size_t j = 0; j < 8; ++j) {
+        EXPECT_NEAR(restored[j], x[j], 1e-12);
+    }
+
+    klibrary::linear_algebra::StaticRowVector<Complex, 4> z;
+    z[1] = 1;
+    const auto transformed = fft(z);
+    EXPECT_NEAR(std::abs(transformed[1] - Complex(0, -1)), 0.0, 1e-15);
+    EXPECT_NEAR(std::abs(ifft(transformed)[1] - Complex(1, 0)), 0.0, 1e-15);
+}
+TEST(NumericalAnalysisFFTTest, SpectralDerivativeAndConvolutionTest) {
+    const std::size_t n = 64;
+    std::vector<double> samples(n);
+    std::vector<double> derivative(n);
+    for(std::size_t j = 0; j < n; ++j) {
+        const double x = 2 * std::numbers::pi * j / n;
+        samples[j] = std::sin(3 * x) + std::exp(std::cos(x));
+    }
+    spectral_derivative(samples, 2 * std::numbers::pi, derivative);
+    for(std::size_t j = 0; j < n; ++j) {
+        const double x = 2 * std::numbers::pi * j / n;
+        EXPECT_NEAR(derivative[j], 3 * std::cos(3 * x) - std::sin(x) * std::exp(std::cos(x)), 1e-11);
+    }
+
+    const std::vector<double> a = {1, 2, 3};
+    const std::vector<double> b = {0, 1, 0.5, -1};
+    std::vector<double> c(a.size() + b.size() - 1);
+    convolve(a, b, c);
+    const std::vector<double> expected = {0, 1, 2.5, 3, -0.5, -3};
+    for(std::size_t i = 0; i < c.size(); ++i) {
+        EXPECT_NEAR(c[i], expected[i], 1e-12);
+    }
+}
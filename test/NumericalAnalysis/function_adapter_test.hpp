@@ -0,0 +1,83 @@
+#include <gtest/gtest.h>
+#include "../../include/NumericalAnalysis/function_adapter.hpp"
+#include "../../include/NumericalAnalysis/approximation_algorithm.hpp"
+#include "../../include/NumericalAnalysis/numerical_integration.hpp"
+
+#include <cmath>
+#include <vector>
+#include <limits>
+#include <numbers>
+namespace {
+    using namespace numerical_analysis;
+}
+TEST(NumericalAnalysisFunctionAdapterTest, MemoizedFunctionTest) {
+    std::size_t calls = 0;
+    const auto f = [&](const double x) { ++calls; return x * x - 2; };
+    const MemoizedFunction memo(f);
+    EXPECT_EQ(memo(3.0), 7.0);
+    EXPECT_EQ(memo(3.0), 7.0);
+    EXPECT_EQ(calls, 1u);
+    EXPECT_EQ(memo.hits(), 1u);
+    EXPECT_EQ(memo.misses(), 1u);
+
+    // 前進差分のNewton-Raphson法はf(x)を反復ごとに2回評価するため、そのうち1回は記憶した値が返される
+    // std::functionへの変換でコピーされても記憶領域は共有される
+    calls = 0;
+    memo.clear();
+    const double root = newton_raphson(1.0, memo, 1e-7, 1e-12, Derivative::Type::Forward, 20);
+    EXPECT_NEAR(root, std::numbers::sqrt2, 1e-10);
+    EXPECT_EQ(calls, memo.misses());
+    EXPECT_GT(memo.hits(), 0u);
+
+    // 同じ範囲の二分法を繰り返すと2回目はf(x)を評価しない
+    bisection_method(memo, 0.0, 2.0, 1e-9);
+    const std::size_t first = calls;
+    const double repeated = bisection_method(memo, 0.0, 2.0, 1e-9);
+    EXPECT_EQ(calls, first);
+    EXPECT_NEAR(repeated, std::numbers::sqrt2, 1e-8);
+}
+TEST(NumericalAnalysisFunctionAdapterTest, MemoizedFunctionCollisionTest) {
+    // 表より多くの点を評価しても値は常に正しい
+    std::size_t calls = 0;
+    const auto f = [&](const double x) { ++calls; return std::sin(x); };
+    const MemoizedFunction<decltype(f), 16> memo(f);
+    for(int round = 0; round < 2; ++round) {
+        for(int i = 0; i < 100; ++i) {
+            EXPECT_EQ(memo(0.01 * i), std::sin(0.01 * i));
+        }
+    }
+    EXPECT_EQ(memo.hits() + memo.misses(), 200u);
+    EXPECT_EQ(calls, memo.misses());
+}
+TEST(NumericalAnalysisFunctionAdapterTest, TabulatedFunctionTest) {
+    std::size_t calls = 0;
+    const auto f = [&](const double x) { ++calls; return std::sin(x); };
+    const TabulatedFunction table(f, 0.0, std::numbers::pi, 256);
+    EXPECT_EQ(calls, 257u);
+    EXPECT_EQ(table.intervals(), 256u);
+
+    std::vector<double> xs(1000);
+    std::vector<double> ys(xs.size());
+    for(std::size_t i = 0; i < xs.size(); ++i) {
+        xs[i] = std::numbers::pi * static_cast<double>(i) / static_cast<double>(xs.size() - 1);
+    }
+    table(xs, ys);
+    for(std::size_t i = 0; i < xs.size(); ++i) {
+        EXPECT_NEAR(table(xs[i]), std::sin(xs[i]), 1e-9);
+        EXPECT_EQ(ys[i], table(xs[i]));
+    }
+    EXPECT_EQ(calls, 257u);
+
+    // NaNを与えた場合はNaNを返す
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    EXPECT_TRUE(std::isnan(table(nan)));
+    std::vector<double> nans = {0.5, nan};
+    std::vector<double> results(nans.size());
+    table(nans, results);
+    EXPECT_EQ(results[0], table(0.5));
+    EXPECT_TRUE(std::isnan(results[1]));
+
+    // 表はそのまま他の関数に渡せる
+    EXPECT_NEAR(brent_method(table, 3.0, 3.3, 1e-14).root, std::numbers::pi, 1e-9);
+    EXPECT_NEAR(integrate(table, 0.0, std::numbers::pi, 1e-10).value, 2.0, 1e-9);
+}
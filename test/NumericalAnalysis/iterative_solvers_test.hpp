@@ -0,0 +1,127 @@
+#include <gtest/gtest.h>
+#include "../../include/NumericalAnalysis/iterative_solvers.hpp"
+
+#include <cmath>
+#include <vector>
+namespace {
+    using namespace numerical_analysis;
+    // 対角がdiagonal、隣接要素がlower, upperの三重対角行列
+    CsrMatrix tridiagonal(const std::size_t& n, const double& lower, const double& diagonal, const double& upper) {
+        CsrMatrix a = {n, {0}, {}, {}};
+        for(std::size_t r = 0; r < n; ++r) {
+            if(r > 0) { a.columns.push_back(r - 1); a.values.push_back(lower); }
+            a.columns.push_back(r); a.values.push_back(diagonal);
+            if(r + 1 < n) { a.columns.push_back(r + 1); a.values.push_back(upper); }
+            a.row_offsets.push_back(a.columns.size());
+        }
+        return a;
+    }
+    template <class Operator>
+    double relative_residual(const Operator& a, const std::vector<double>& b, const std::vector<double>& x) {
+        std::vector<double> ax(b.size());
+        a.apply(x, ax);
+        double r = 0, nb = 0;
+        for(std::size_t i = 0; i < b.size(); ++i) {
+            r += (b[i] - ax[i]) * (b[i] - ax[i]);
+            nb += b[i] * b[i];
+        }
+        return std::sqrt(r / nb);
+    }
+}
+TEST(NumericalAnalysisIterativeSolversTest, ConjugateGradientTest) {
+    static_assert(LinearOperator<CsrMatrix> && DiagonalAccessible<CsrMatrix>);
+    static_assert(LinearOperator<IncompleteCholeskyPreconditioner>);
+    const std::size_t n = 200;
+    // 1次元Poisson方程式 (対角成分を変化させた対称正定値行列)
+    CsrMatrix a = tridiagonal(n, -1, 2, -1);
+    for(std::size_t r = 0; r < n; ++r) {
+        a.values[a.row_offsets[r] + (r > 0)] += 0.01 * static_cast<double>(r);
+    }
+    std::vector<double> b(n);
+    for(std::size_t i = 0; i < n; ++i) {
+        b[i] = std::sin(0.1 * static_cast<double>(i)) + 1;
+    }
+    const IterativeSolverOptions options = {.tolerance = 1e-10, .max_iterations = 1000};
+
+    std::vector<double> x(n, 0.0);
+    const auto plain = conjugate_gradient(a, b, x, options);
+    EXPECT_EQ(plain.status, SolverStatus::Converged);
+    EXPECT_EQ(plain.residual_history.size(), plain.iterations + 1);
+    EXPECT_LE(plain.residual, 1e-10);
+    EXPECT_LT(relative_residual(a, b, x), 1e-9);
+
+    std::fill(x.begin(), x.end(), 0.0);
+    const auto jacobi = conjugate_gradient(a, b, x, JacobiPreconditioner(a), options);
+    EXPECT_EQ(jacobi.status, SolverStatus::Converged);
+    EXPECT_LT(jacobi.iterations, plain.iterations);
+    EXPECT_LT(relative_residual(a, b, x), 1e-9);
+
+    // 三重対角行列のIC(0)は完全なCholesky分解であるため1反復で収束する
+    std::fill(x.begin(), x.end(), 0.0);
+    const auto ic = conjugate_gradient(a, b, x, IncompleteCholeskyPreconditioner(a), options);
+    EXPECT_EQ(ic.status, SolverStatus::Converged);
+    EXPECT_LE(ic.iterations, 2u);
+    EXPECT_LT(relative_residual(a, b, x), 1e-9);
+
+    // 正定値でない行列
+    std::fill(x.begin(), x.end(), 0.0);
+    EXPECT_EQ(conjugate_gradient(tridiagonal(n, -1, -2, -1), b, x).status, SolverStatus::Diverged);
+}
+TEST(NumericalAnalysisIterativeSolversTest, DenseAndFunctionOperatorTest) {
+    const klibrary::linear_algebra::StaticMatrixBase<double, 3, 3> m = {
+        {4, 1, 0},
+        {1, 3, 1},
+        {0, 1, 2}
+    };
+    const DenseOperator dense(m);
+    const std::vector<double> b = {1, 2, 3};
+    std::vector<double> x(3, 0.0);
+    const auto result = conjugate_gradient(dense, b, x, JacobiPreconditioner(dense));
+    EXPECT_EQ(result.status, SolverStatus::Converged);
+    EXPECT_LE(result.iterations, 3u);
+    EXPECT_LT(relative_residual(dense, b, x), 1e-10);
+
+    // 行列を持たない作用素 (巡回差分)
+    const std::size_t n = 64;
+    const auto laplacian = FunctionOperator(n, [n](std::span<const double> in, std::span<double> out) {
+        for(std::size_t i = 0; i < n; ++i) {
+            out[i] = 3 * in[i] - in[(i + 1) % n] - in[(i + n - 1) % n];
+        }
+    });
+    std::vector<double> rhs(n, 1.0), y(n, 0.0);
+    EXPECT_EQ(conjugate_gradient(laplacian, rhs, y).status, SolverStatus::Converged);
+    for(const double value : y) {
+        EXPECT_NEAR(value, 1.0, 1e-9);
+    }
+}
+TEST(NumericalAnalysisIterativeSolversTest, GmresTest) {
+    // 非対称な移流拡散行列
+    const std::size_t n = 150;
+    const CsrMatrix a = tridiagonal(n, -1.4, 2.5, -0.6);
+    std::vector<double> b(n);
+    for(std::size_t i = 0; i < n; ++i) {
+        b[i] = std::cos(0.05 * static_cast<double>(i));
+    }
+    for(const std::size_t restart : {10u, 150u}) {
+        std::vector<double> x(n, 0.0);
+        const auto result = gmres(a, b, x, {.tolerance = 1e-10, .max_iterations = 2000, .restart = restart});
+        EXPECT_EQ(result.status, SolverStatus::Converged) << restart;
+        EXPECT_EQ(result.residual_history.size(), result.iterations + 1);
+        EXPECT_LT(relative_residual(a, b, x), 1e-9);
+        for(std::size_t i = 1; i < result.residual_history.size(); ++i) {
+            if(i % restart != 0) {
+                EXPECT_LE(result.residual_history[i], result.residual_history[i - 1] * (1 + 1e-12));
+            }
+        }
+    }
+
+    std::vector<double> x(n, 0.0);
+    const auto preconditioned = gmres(a, b, x, JacobiPreconditioner(a), {.tolerance = 1e-10, .max_iterations = 2000, .restart = 20});
+    EXPECT_EQ(preconditioned.status, SolverStatus::Converged);
+    EXPECT_LT(relative_residual(a, b, x), 1e-9);
+
+    std::fill(x.begin(), x.end(), 0.0);
+    const auto limited = gmres(a, b, x, {.tolerance = 1e-14, .max_iterations = 5, .restart = 3});
+    EXPECT_EQ(limited.status, SolverStatus::MaxAttemptsReached);
+    EXPECT_EQ(limited.iterations, 5u);
+}
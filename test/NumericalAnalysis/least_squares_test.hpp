@@ -0,0 +1,116 @@
+#include <gtest/gtest.h>
+#include "../../include/NumericalAnalysis/approximation_algorithm.hpp"
+
+#include <cmath>
+#include <vector>
+namespace {
+    using namespace numerical_analysis;
+    // 0.5 - 1.25x + 2x^2 + 0.75x^3 に決定的な微小摂動を加えた標本
+    void cubic_samples(const std::size_t& n, std::vector<double>& xs, std::vector<double>& ys, const double& noise) {
+        xs.resize(n);
+        ys.resize(n);
+        for(std::size_t i = 0; i < n; ++i) {
+            const double x = -1 + 2 * static_cast<double>(i) / static_cast<double>(n - 1);
+            xs[i] = x;
+            ys[i] = 0.5 - 1.25 * x + 2 * x * x + 0.75 * x * x * x + noise * std::sin(97.0 * static_cast<double>(i));
+        }
+    }
+}
+TEST(NumericalAnalysisLeastSquaresTest, PolynomialFitTest) {
+    std::vector<double> xs, ys;
+    cubic_samples(1001, xs, ys, 0);
+    const std::array<double, 4> expected = {0.5, -1.25, 2, 0.75};
+
+    const auto qr = fit_polynomial<3>(xs, ys);
+    EXPECT_EQ(qr.status, SolverStatus::Converged);
+    EXPECT_EQ(qr.samples, 1001u);
+    EXPECT_LT(qr.residual, 1e-20);
+    for(std::size_t k = 0; k < 4; ++k) {
+        EXPECT_NEAR(qr.coefficients[k], expected[k], 1e-12);
+    }
+    for(const std::size_t threads : {1, 3}) {
+        const auto streaming = fit_polynomial_streaming<3>(xs, ys, threads);
+        EXPECT_EQ(streaming.status, SolverStatus::Converged);
+        EXPECT_EQ(streaming.samples, 1001u);
+        for(std::size_t k = 0; k < 4; ++k) {
+            EXPECT_NEAR(streaming.coefficients[k], expected[k], 1e-10);
+        }
+    }
+}
+TEST(NumericalAnalysisLeastSquaresTest, NoisyFitTest) {
+    // 摂動を含む場合は両方法の係数と残差が一致する
+    std::vector<double> xs, ys;
+    cubic_samples(10007, xs, ys, 1e-2);
+    const auto qr = fit_polynomial<3>(xs, ys);
+    const auto streaming = fit_polynomial_streaming<3>(xs, ys, 4);
+    EXPECT_GT(qr.residual, 0.1);
+    EXPECT_NEAR(streaming.residual, qr.residual, 1e-8 * qr.residual);
+    for(std::size_t k = 0; k < 4; ++k) {
+        EXPECT_NEAR(streaming.coefficients[k], qr.coefficients[k], 1e-10);
+    }
+    // 区間の順に統合するため、スレッドの終了順によらず毎回同じ結果になる
+    for(std::size_t trial = 0; trial < 20; ++trial) {
+        const auto again = fit_polynomial_streaming<3>(xs, ys, 4);
+        EXPECT_EQ(again.residual, streaming.residual);
+        for(std::size_t k = 0; k < 4; ++k) {
+            EXPECT_EQ(again.coefficients[k], streaming.coefficients[k]);
+        }
+    }
+
+    // 分割して累積した結果を統合しても同じ
+    LeastSquaresAccumulator<4> left, right;
+    const std::span<const double> x(xs), y(ys);
+    left.add_polynomial(x.first(5000), y.first(5000));
+    right.add_polynomial(x.subspan(5000), y.subspan(5000));
+    const auto merged = left.merge(right).solve();
+    EXPECT_EQ(merged.samples, xs.size());
+    for(std::size_t k = 0; k < 4; ++k) {
+        EXPECT_NEAR(merged.coefficients[k], qr.coefficients[k], 1e-10);
+    }
+}
+TEST(NumericalAnalysisLeastSquaresTest, LinearModelTest) {
+    // y = 2 + 3 sin(x) - cos(x)
+    std::vector<double> xs(200), ys(200);
+    LeastSquaresAccumulator<3> accumulator;
+    for(std::size_t i = 0; i < xs.size(); ++i) {
+        xs[i] = 0.05 * static_cast<double>(i);
+        ys[i] = 2 + 3 * std::sin(xs[i]) - std::cos(xs[i]);
+        Vector<3> row;
+        row[0] = 1; row[1] = std::sin(xs[i]); row[2] = std::cos(xs[i]);
+        accumulator.add(row, ys[i]);
+    }
+    const auto basis = [](const double& x) {
+        Vector<3> row;
+        row[0] = 1; row[1] = std::sin(x); row[2] = std::cos(x);
+        return row;
+    };
+    const auto qr = fit_least_squares<3>(xs, ys, basis);
+    const auto normal = accumulator.solve();
+    EXPECT_NEAR(qr.coefficients[0], 2, 1e-12);
+    EXPECT_NEAR(qr.coefficients[1], 3, 1e-12);
+    EXPECT_NEAR(qr.coefficients[2], -1, 1e-12);
+    EXPECT_NEAR(normal.coefficients[1], 3, 1e-9);
+
+    // 同じ基底関数が2つある場合は階数が落ちる
+    const auto degenerate = [](const double& x) {
+        Vector<2> row;
+        row[0] = x; row[1] = 2 * x;
+        return row;
+    };
+    EXPECT_EQ((fit_least_squares<2>(xs, ys, degenerate).status), SolverStatus::Singular);
+    EXPECT_EQ(LeastSquaresAccumulator<2>().solve().status, SolverStatus::Singular);
+}
+TEST(NumericalAnalysisLeastSquaresTest, HornerEvaluationTest) {
+    Vector<4> c;
+    c[0] = 0.5; c[1] = -1.25; c[2] = 2; c[3] = 0.75;
+    std::vector<double> xs(19), out(19);
+    for(std::size_t i = 0; i < xs.size(); ++i) {
+        xs[i] = -2 + 0.25 * static_cast<double>(i);
+    }
+    evaluate_polynomial(c, xs, out);
+    for(std::size_t i = 0; i < xs.size(); ++i) {
+        const double x = xs[i];
+        EXPECT_NEAR(out[i], 0.5 - 1.25 * x + 2 * x * x + 0.75 * x * x * x, 1e-13);
+        EXPECT_EQ(out[i], evaluate_polynomial(c, x));
+    }
+}
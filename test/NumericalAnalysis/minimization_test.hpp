@@ -0,0 +1,127 @@
+#include <gtest/gtest.h>
+#include "../../include/NumericalAnalysis/minimization.hpp"
+
+#include <cmath>
+#include <atomic>
+#include <vector>
+namespace {
+    using namespace numerical_analysis;
+    // 拡張Rosenbrock関数 (最小点は全ての要素が1)
+    template <class State>
+    double rosenbrock(const State& x, const std::size_t& n) {
+        double sum = 0;
+        for(std::size_t i = 0; i + 1 < n; ++i) {
+            const double a = x[i + 1] - x[i] * x[i];
+            const double b = 1 - x[i];
+            sum += 100 * a * a + b * b;
+        }
+        return sum;
+    }
+    template <class State>
+    void rosenbrock_gradient(const State& x, State& g, const std::size_t& n) {
+        for(std::size_t i = 0; i < n; ++i) {
+            g[i] = 0;
+        }
+        for(std::size_t i = 0; i + 1 < n; ++i) {
+            const double a = x[i + 1] - x[i] * x[i];
+            g[i] += -400 * x[i] * a - 2 * (1 - x[i]);
+            g[i + 1] += 200 * a;
+        }
+    }
+}
+TEST(NumericalAnalysisMinimizationTest, LbfgsTest) {
+    Vector<2> x0 = {-1.2, 1.0};
+    const auto f = [](const Vector<2>& x) { return rosenbrock(x, 2); };
+    const auto g = [](const Vector<2>& x) {
+        Vector<2> result;
+        rosenbrock_gradient(x, result, 2);
+        return result;
+    };
+    const auto result = lbfgs(x0, f, g, {.tolerance = 1e-10, .max_iterations = 200});
+    EXPECT_EQ(result.status, SolverStatus::Converged);
+    EXPECT_NEAR(result.x[0], 1, 1e-8);
+    EXPECT_NEAR(result.x[1], 1, 1e-8);
+    EXPECT_EQ(result.gradient_evaluations, result.iterations + 1);
+
+    // std::vector<double>とgradient(x, g)の形式
+    const std::size_t n = 20;
+    std::vector<double> y0(n, -1.0);
+    const auto fy = [&](const std::vector<double>& x) { return rosenbrock(x, n); };
+    const auto gy = [&](const std::vector<double>& x, std::vector<double>& out) { rosenbrock_gradient(x, out, n); };
+    const auto dynamic = lbfgs(y0, fy, gy, {.tolerance = 1e-9, .max_iterations = 1000, .history = 10});
+    EXPECT_EQ(dynamic.status, SolverStatus::Converged);
+    for(std::size_t i = 0; i < n; ++i) {
+        EXPECT_NEAR(dynamic.x[i], 1, 1e-6);
+    }
+
+    // 非凸関数 (Himmelblau関数) ではs・yが正でない更新が履歴が一杯の状態で起こるが、
+    // 破棄した更新で保持している組が壊れないため収束する
+    const auto himmelblau = [](const Vector<2>& x) {
+        const double a = x[0] * x[0] + x[1] - 11;
+        const double b = x[0] + x[1] * x[1] - 7;
+        return a * a + b * b;
+    };
+    const auto himmelblau_gradient = [](const Vector<2>& x) {
+        const double a = x[0] * x[0] + x[1] - 11;
+        const double b = x[0] + x[1] * x[1] - 7;
+        Vector<2> result;
+        result[0] = 4 * a * x[0] + 2 * b;
+        result[1] = 2 * a + 4 * b * x[1];
+        return result;
+    };
+    for(const std::size_t history : {1, 2}) {
+        const auto nonconvex = lbfgs(Vector<2>{-4.0, 0.0}, himmelblau, himmelblau_gradient, {.tolerance = 1e-10, .max_iterations = 200, .history = history});
+        EXPECT_EQ(nonconvex.status, SolverStatus::Converged);
+        EXPECT_NEAR(nonconvex.x[0], -3.779310253377747, 1e-9);
+        EXPECT_NEAR(nonconvex.x[1], -3.283185991286170, 1e-9);
+        EXPECT_LT(nonconvex.value, 1e-18);
+    }
+
+    // 数値微分による勾配
+    const auto numerical = lbfgs(x0, f, 1e-6, {.tolerance = 1e-6, .max_iterations = 200, .threads = 2});
+    EXPECT_EQ(numerical.status, SolverStatus::Converged);
+    EXPECT_NEAR(numerical.x[0], 1, 1e-5);
+    EXPECT_NEAR(numerical.x[1], 1, 1e-5);
+    EXPECT_GT(numerical.evaluations, 4 * numerical.gradient_evaluations);
+
+    // 有限でない値
+    const auto nan = lbfgs(x0, [](const Vector<2>&) { return std::nan(""); }, g);
+    EXPECT_EQ(nan.status, SolverStatus::Diverged);
+}
+TEST(NumericalAnalysisMinimizationTest, NelderMeadTest) {
+    const Vector<2> x0 = {-1.2, 1.0};
+    const auto f = [](const Vector<2>& x) { return rosenbrock(x, 2); };
+    const auto result = nelder_mead(x0, f, {.tolerance = 1e-10, .max_iterations = 2000});
+    EXPECT_EQ(result.status, SolverStatus::Converged);
+    EXPECT_NEAR(result.x[0], 1, 1e-6);
+    EXPECT_NEAR(result.x[1], 1, 1e-6);
+    EXPECT_EQ(result.value, f(result.x));
+
+    // 頂点の並列評価 (評価回数は逐次の場合と一致する)
+    const std::size_t n = 6;
+    const std::vector<double> y0 = {0.5, -0.3, 1.2, 0.1, 2.0, -1.0};
+    std::atomic<std::size_t> calls = 0;
+    const auto quadratic = [&](const std::vector<double>& x) {
+        ++calls;
+        double sum = 0;
+        for(std::size_t i = 0; i < n; ++i) {
+            sum += static_cast<double>(i + 1) * (x[i] - static_cast<double>(i)) * (x[i] - static_cast<double>(i));
+        }
+        return sum;
+    };
+    const auto serial = nelder_mead(y0, quadratic, {.tolerance = 1e-9, .max_iterations = 20000});
+    EXPECT_EQ(serial.status, SolverStatus::Converged);
+    EXPECT_EQ(calls, serial.evaluations);
+    calls = 0;
+    const auto parallel = nelder_mead(y0, quadratic, {.tolerance = 1e-9, .max_iterations = 20000, .threads = 4});
+    EXPECT_EQ(calls, parallel.evaluations);
+    EXPECT_EQ(serial.evaluations, parallel.evaluations);
+    for(std::size_t i = 0; i < n; ++i) {
+        EXPECT_NEAR(serial.x[i], static_cast<double>(i), 1e-6);
+        EXPECT_EQ(serial.x[i], parallel.x[i]);
+    }
+
+    const auto limited = nelder_mead(x0, f, {.max_iterations = 5});
+    EXPECT_EQ(limited.status, SolverStatus::MaxAttemptsReached);
+    EXPECT_EQ(limited.iterations, 5u);
+}
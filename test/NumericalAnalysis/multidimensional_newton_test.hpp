@@ -0,0 +1,73 @@
+#include <gtest/gtest.h>
+#include "../../include/NumericalAnalysis/multidimensional_newton.hpp"
+
+#include <cmath>
+namespace {
+    using namespace numerical_analysis;
+}
+TEST(NumericalAnalysisMultidimensionalNewtonTest, NewtonRaphsonSystemTest) {
+    /*
+     * 入力関数とそのヤコビ行列
+     * F(x, y)  : (x^2 + y^2 - 4, e^x + y - 1)
+     * J(x, y)  : ((2x, 2y), (e^x, 1))
+     */
+    const auto f = [](const Vector<2>& v) {
+        Vector<2> r;
+        r[0] = v[0] * v[0] + v[1] * v[1] - 4;
+        r[1] = std::exp(v[0]) + v[1] - 1;
+        return r;
+    };
+    const auto j = [](const Vector<2>& v) {
+        return Jacobian<2>{2 * v[0], 2 * v[1], std::exp(v[0]), 1};
+    };
+    const Vector<2> x0{1.0, -1.0};
+
+    const auto exact = newton_raphson(x0, f, j, 1.0e-12, 50);
+    const auto finite_difference = newton_raphson(x0, f, 1.0e-12, 50);
+    const auto broyden = newton_raphson(x0, f, j, 1.0e-12, 50, JacobianUpdate::Broyden);
+
+    for(const auto& result : {exact, finite_difference, broyden}) {
+        EXPECT_EQ(result.status, SolverStatus::Converged);
+        const auto residual = f(result.x);
+        EXPECT_LT(std::abs(residual[0]), 1.0e-10);
+        EXPECT_LT(std::abs(residual[1]), 1.0e-10);
+        EXPECT_NEAR(result.x[0], 1.0041687384, 1.0e-9);
+        EXPECT_NEAR(result.x[1], -1.7296372870, 1.0e-9);
+    }
+    // 有限差分のヤコビ行列は1回あたりN回Fを評価する
+    EXPECT_EQ(finite_difference.evaluations, 1 + finite_difference.iterations + 2 * finite_difference.jacobian_evaluations);
+    // Broyden法はヤコビ行列を評価し直さない
+    EXPECT_EQ(exact.jacobian_evaluations, exact.iterations);
+    EXPECT_LT(broyden.jacobian_evaluations, broyden.iterations);
+}
+TEST(NumericalAnalysisMultidimensionalNewtonTest, BroydenSystemTest) {
+    // 3変数の非線形方程式 (解は(1, 2, 3))
+    const auto f = [](const Vector<3>& v) {
+        Vector<3> r;
+        r[0] = v[0] + v[1] * v[1] - 5;
+        r[1] = v[0] * v[2] + v[1] - 5;
+        r[2] = std::sin(v[0] - 1) + v[2] * v[2] - 9;
+        return r;
+    };
+    const Vector<3> x0{1.2, 1.8, 3.1};
+    const auto result = newton_raphson(x0, f, 1.0e-12, 100, JacobianUpdate::Broyden);
+    EXPECT_EQ(result.status, SolverStatus::Converged);
+    EXPECT_NEAR(result.x[0], 1.0, 1.0e-9);
+    EXPECT_NEAR(result.x[1], 2.0, 1.0e-9);
+    EXPECT_NEAR(result.x[2], 3.0, 1.0e-9);
+}
+TEST(NumericalAnalysisMultidimensionalNewtonTest, SingularJacobianTest) {
+    // F(x, y) = (x^2 - 1, y - 1) のヤコビ行列はx = 0で特異になる
+    const auto f = [](const Vector<2>& v) {
+        Vector<2> r;
+        r[0] = v[0] * v[0] - 1;
+        r[1] = v[1] - 1;
+        return r;
+    };
+    const auto j = [](const Vector<2>& v) {
+        return Jacobian<2>{2 * v[0], 0, 0, 1};
+    };
+    const Vector<2> x0{0.0, 0.0};
+    EXPECT_EQ(newton_raphson(x0, f, j, 1.0e-12, 50).status, SolverStatus::Singular);
+    EXPECT_EQ(newton_raphson(x0, f, j, 1.0e-12, 50, JacobianUpdate::Broyden).status, SolverStatus::Singular);
+}
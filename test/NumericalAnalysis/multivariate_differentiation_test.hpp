@@ -0,0 +1,105 @@
+#include <gtest/gtest.h>
+#include "../../include/NumericalAnalysis/multivariate_differentiation.hpp"
+
+#include <cmath>
+#include <atomic>
+namespace {
+    using namespace numerical_analysis;
+    // f(x) = x0^2 x1 + sin(x2) + x0 x2^3
+    double scalar_field(const Vector<3>& x) {
+        return x[0] * x[0] * x[1] + std::sin(x[2]) + x[0] * x[2] * x[2] * x[2];
+    }
+}
+TEST(NumericalAnalysisMultivariateDifferentiationTest, GradientTest) {
+    const Vector<3> x = {0.7, -1.3, 0.4};
+    const double expected[3] = {
+        2 * x[0] * x[1] + x[2] * x[2] * x[2],
+        x[0] * x[0],
+        std::cos(x[2]) + 3 * x[0] * x[2] * x[2]
+    };
+    std::atomic<std::size_t> calls = 0;
+    const auto f = [&](const Vector<3>& v) { ++calls; return scalar_field(v); };
+
+    const auto central = gradient(f, x, 1e-4);
+    EXPECT_EQ(calls, 6u);
+    calls = 0;
+    const auto forward = gradient<DerivativeType::Forward>(f, x, 1e-6);
+    EXPECT_EQ(calls, 4u);
+    calls = 0;
+    const auto seven = gradient<DerivativeType::SevenPoints>(f, x, 1e-2, 3);
+    EXPECT_EQ(calls, 18u);
+    for(std::size_t i = 0; i < 3; ++i) {
+        EXPECT_NEAR(central[i], expected[i], 1e-7);
+        EXPECT_NEAR(forward[i], expected[i], 1e-5);
+        EXPECT_NEAR(seven[i], expected[i], 1e-10);
+    }
+}
+TEST(NumericalAnalysisMultivariateDifferentiationTest, JacobianTest) {
+    // F: R^3 -> R^2
+    const auto f = [](const Vector<3>& x) {
+        Vector<2> y;
+        y[0] = x[0] * x[1] - x[2];
+        y[1] = std::exp(x[0]) + x[1] * x[2] * x[2];
+        return y;
+    };
+    const Vector<3> x = {0.2, 1.5, -0.5};
+    const double expected[2][3] = {
+        {x[1], x[0], -1},
+        {std::exp(x[0]), x[2] * x[2], 2 * x[1] * x[2]}
+    };
+    for(const std::size_t threads : {1, 3}) {
+        const klibrary::linear_algebra::StaticMatrixBase<double, 2, 3> j = jacobian<DerivativeType::FivePoints>(f, x, 1e-3, threads);
+        const auto backward = jacobian<DerivativeType::Backward>(f, x, 1e-7, threads);
+        for(std::size_t r = 0; r < 2; ++r) {
+            for(std::size_t c = 0; c < 3; ++c) {
+                EXPECT_NEAR(j(r, c), expected[r][c], 1e-10);
+                EXPECT_NEAR(backward(r, c), expected[r][c], 1e-6);
+            }
+        }
+    }
+}
+TEST(NumericalAnalysisMultivariateDifferentiationTest, HessianTest) {
+    const Vector<3> x = {0.7, -1.3, 0.4};
+    const double expected[3][3] = {
+        {2 * x[1], 2 * x[0], 3 * x[2] * x[2]},
+        {2 * x[0], 0, 0},
+        {3 * x[2] * x[2], 0, -std::sin(x[2]) + 6 * x[0] * x[2]}
+    };
+    std::atomic<std::size_t> calls = 0;
+    const auto f = [&](const Vector<3>& v) { ++calls; return scalar_field(v); };
+    for(const std::size_t threads : {1, 2}) {
+        calls = 0;
+        const auto hessian_matrix = hessian(f, x, 1e-4, threads);
+        // 1 + N + N^2 回
+        EXPECT_EQ(calls, 13u);
+        for(std::size_t r = 0; r < 3; ++r) {
+            for(std::size_t c = 0; c < 3; ++c) {
+                EXPECT_NEAR(hessian_matrix(r, c), expected[r][c], 1e-5);
+                EXPECT_EQ(hessian_matrix(r, c), hessian_matrix(c, r));
+            }
+        }
+    }
+
+    // 組の分割の境界が行の途中にある場合
+    Vector<6> y;
+    for(std::size_t i = 0; i < 6; ++i) {
+        y[i] = 0.1 * static_cast<double>(i + 1);
+    }
+    const auto quadratic = [](const Vector<6>& v) {
+        double sum = 0;
+        for(std::size_t i = 0; i < 6; ++i) {
+            for(std::size_t j = 0; j < 6; ++j) {
+                sum += static_cast<double>(i + 2 * j + 1) * v[i] * v[j];
+            }
+        }
+        return sum;
+    };
+    const auto serial = hessian(quadratic, y, 1e-3, 1);
+    const auto parallel = hessian(quadratic, y, 1e-3, 4);
+    for(std::size_t i = 0; i < 6; ++i) {
+        for(std::size_t j = 0; j < 6; ++j) {
+            EXPECT_NEAR(serial(i, j), static_cast<double>(3 * i + 3 * j + 2), 1e-6);
+            EXPECT_EQ(serial(i, j), parallel(i, j));
+        }
+    }
+}
@@ -2,11 +2,15 @@
 #include "../../include/NumericalAnalysis/numerical_differentiation.hpp"
 #include "../../include/NumericalAnalysis/approximation_algorithm.hpp"
 #include "../../include/NumericalAnalysis/constants.hpp"
+#include "../../include/NumericalAnalysis/dual_number.hpp"
+#include "../../include/LinearAlgebra/StaticMatrix/Base/staticmatrix_base.hpp"
 
 #include <limits>
 #include <functional>
 #include <cmath>
 #include <numbers>
+#include <array>
+#include <vector>
 namespace {
     using namespace numerical_analysis;
 }
@@ -59,6 +63,77 @@ TEST(NumericalAnalysisTest, SevenPointsDerivativeTest) {
     derivative_test(Derivative::Type::SevenPoints, std::pow(Constants::h, 6));
 }
 
+TEST(NumericalAnalysisTest, GenericDerivativeTest) {
+    // 関数オブジェクトの型を保持する場合も、微分方法をコンパイル時に指定する場合も結果は一致する
+    const auto f = [](const double x) { return std::atan(x) * std::sin(x) * std::exp(0.5 * x); };
+    const auto generic = BasicDerivative(f, 0.01);
+    EXPECT_DOUBLE_EQ(generic.with_respect_to<DerivativeType::Forward>(3.0)    , Derivative(f, 0.01).with_respect_to(3.0, Derivative::Type::Forward));
+    EXPECT_DOUBLE_EQ(generic.with_respect_to<DerivativeType::Central>(3.0)    , Derivative(f, 0.01).with_respect_to(3.0, Derivative::Type::Central));
+    EXPECT_DOUBLE_EQ(generic.with_respect_to<DerivativeType::Backward>(3.0)   , Derivative(f, 0.01).with_respect_to(3.0, Derivative::Type::Backward));
+    EXPECT_DOUBLE_EQ(generic.with_respect_to<DerivativeType::FivePoints>(3.0) , Derivative(f, 0.01).with_respect_to(3.0, Derivative::Type::FivePoints));
+    EXPECT_DOUBLE_EQ(generic.with_respect_to<DerivativeType::SevenPoints>(3.0), Derivative(f, 0.01).with_respect_to(3.0, Derivative::Type::SevenPoints));
+    EXPECT_LT(std::abs(generic.with_respect_to(3.0, DerivativeType::SevenPoints) - (-5.08359)), 10e-5);
+}
+TEST(NumericalAnalysisTest, BatchedDerivativeTest) {
+    // 複数点での微分は1点ずつの微分と一致する
+    const auto f = [](const double x) { return std::exp(3 * x) + std::pow(std::sin(x), 2); };
+    const auto derivative = BasicDerivative(f, 0.01);
+    std::array<double, 21> xs;
+    std::array<double, 21> out;
+    for(std::size_t i = 0; i < xs.size(); ++i) {
+        xs[i] = -1.0 + 0.1 * static_cast<double>(i);
+    }
+    for(const auto type : {DerivativeType::Forward, DerivativeType::Central, DerivativeType::Backward, DerivativeType::FivePoints, DerivativeType::SevenPoints}) {
+        derivative.with_respect_to(xs, out, type);
+        for(std::size_t i = 0; i < xs.size(); ++i) {
+            EXPECT_DOUBLE_EQ(out[i], derivative.with_respect_to(xs[i], type));
+        }
+    }
+}
+TEST(NumericalAnalysisTest, UniformGridDerivativeTest) {
+    // 等間隔格子上の微分は、格子間隔から決まる差分幅での1点ずつの微分と一致し、各点でfを1回だけ評価する
+    std::size_t calls = 0;
+    const auto f = [&calls](const double x) { ++calls; return std::sin(x) * std::exp(-0.1 * x); };
+    const double x0 = -2.0;
+    const double dx = 1.0e-3;
+    std::vector<double> out(1000);
+    const std::array<std::pair<DerivativeType, double>, 5> types = {{
+        {DerivativeType::Forward, dx}, {DerivativeType::Central, 2 * dx}, {DerivativeType::Backward, dx},
+        {DerivativeType::FivePoints, dx}, {DerivativeType::SevenPoints, dx}
+    }};
+    for(const auto& [type, h] : types) {
+        calls = 0;
+        BasicDerivative(f).on_uniform_grid(x0, dx, out, type);
+        EXPECT_LE(calls, out.size() + 6);
+        for(std::size_t j = 0; j < out.size(); j += 37) {
+            const double x = x0 + static_cast<double>(j) * dx;
+            EXPECT_NEAR(out[j], BasicDerivative(f, h).with_respect_to(x, type), 1.0e-9);
+            EXPECT_NEAR(out[j], std::exp(-0.1 * x) * (std::cos(x) - 0.1 * std::sin(x)), 1.0e-2);
+        }
+    }
+}
+
+TEST(NumericalAnalysisTest, AdaptiveDerivativeTest) {
+    std::size_t calls = 0;
+    const auto f0 = [&calls](const double x) { ++calls; return std::exp(3 * x) + std::pow(std::sin(x), 2); };
+    const auto f1 = [&calls](const double x) { ++calls; return std::sin(50 * x); };
+
+    // 目標誤差を達成し、誤差の推定値は実際の誤差程度である
+    calls = 0;
+    const auto r0 = BasicDerivative(f0).adaptive(0.21, 1.0e-9);
+    const double df0 = 3 * std::exp(0.63) + std::sin(0.42);
+    EXPECT_LT(std::abs(r0.value - df0), 1.0e-8);
+    EXPECT_LE(r0.error, 1.0e-9);
+    EXPECT_EQ(r0.evaluations, calls);
+    EXPECT_LE(r0.evaluations, 16u);
+
+    // 初期差分幅が大きすぎる場合もやり直しにより収束し、同じ点を再評価しない
+    calls = 0;
+    const auto r1 = BasicDerivative(f1, 0.5).adaptive(0.3, 1.0e-7);
+    EXPECT_LT(std::abs(r1.value - 50 * std::cos(15.0)), 1.0e-6);
+    EXPECT_EQ(r1.evaluations, calls);
+    EXPECT_LE(r1.evaluations, 32u);
+}
 TEST(NumericalAnalysisTest, NewtonRaphsonTest) {
     // 誤差の閾値
     const double epsilon = 10e-5;
@@ -113,6 +188,70 @@ TEST(NumericalAnalysisTest, NewtonRaphson_NumericDerivativeTest) {
     EXPECT_LT(std::abs(newton_raphson(2  , f3) - (1.84359)) , epsilon);
 }
 
+TEST(NumericalAnalysisTest, DualNumberTest) {
+    using klibrary::linear_algebra::StaticMatrixBase;
+    namespace concepts = klibrary::linear_algebra::alias_and_concepts;
+    static_assert(concepts::HasCommonTypeWith<Dual<double>, double>);
+    static_assert(concepts::IsAdditionDefined<Dual<double>, double>);
+    static_assert(concepts::IsSubtractionDefined<double, Dual<double>>);
+    static_assert(concepts::IsMultiplicationDefined<Dual<double>, int>);
+    static_assert(concepts::IsDivisionDefined<Dual<double>, Dual<double>>);
+
+    // 二重数による評価は関数値と微分値を同時に返す
+    const auto f = [](const auto& x) { return atan(x) * sin(x) * exp(0.5 * x) + pow(x, 3.0) / sqrt(x) - log10(x); };
+    const auto y = f(Dual<double>::variable(3.0));
+    EXPECT_DOUBLE_EQ(y.value(), f(3.0));
+    EXPECT_NEAR(y.derivative(), BasicDerivative(f, 0.01).adaptive(3.0, 1.0e-10).value, 1.0e-8);
+
+    // 行列の要素型として使用すると、行列積の微分 d(A(t)B(t))/dt = A'B + AB' が得られる
+    const Dual<double> t = Dual<double>::variable(0.5);
+    StaticMatrixBase<Dual<double>, 2, 2> a = {t, 2 * t, t * t, Dual<double>(1)};
+    StaticMatrixBase<Dual<double>, 2, 2> b = {Dual<double>(3), -t, sin(t), exp(t)};
+    const auto ab = a * b;
+    const double tv = 0.5;
+    const std::array<double, 4> dab = {
+        3 + 2 * std::sin(tv) + 2 * tv * std::cos(tv),
+        -2 * tv + 2 * std::exp(tv) + 2 * tv * std::exp(tv),
+        6 * tv + std::cos(tv),
+        -3 * tv * tv + std::exp(tv)
+    };
+    for(std::size_t i = 0; i < 4; ++i) {
+        EXPECT_NEAR(ab.at(i).derivative(), dab[i], 1.0e-12);
+    }
+}
+
+TEST(NumericalAnalysisTest, NewtonRaphson_AutomaticDifferentiationTest) {
+    // 誤差の閾値
+    const double epsilon = 10e-5;
+    /*
+     * 入力関数 (NewtonRaphsonTestの入力関数)
+     * f0   : 0.1(x - 1.2)^5 - 0.5(x + 3.1)^3 - 1.1(x - 0.3)^2 + 3.1(x + 2.0)
+     * f1   : 4.2cos(x) - 1.7x
+     * f2   : 1 / ln(x) + (x + 2.3)^2
+     * f3   : log((π^e)^x) - π
+     */
+    std::size_t calls = 0;
+    const auto f0 = [&](const auto& x) {
+        ++calls;
+        return 0.1 * pow(x - 1.2, 5.0) - 0.5 * pow(x + 3.1, 3.0) - 1.1 * pow(x - 0.3, 2.0) + 3.1 * (x + 2.0);
+    };
+    const auto f1 = [&](const auto& x) { ++calls; return 4.2 * cos(x) - 1.7 * x; };
+    const auto f2 = [&](const auto& x) { ++calls; return 1 / log(x) + pow(x + 2.3, 2.0); };
+    const auto f3 = [&](const auto& x) { ++calls; return log10(pow(std::numbers::pi, exp(x))) - std::numbers::pi; };
+
+    // 自動微分を使ったNewton-Raphson法による解と実解の差は閾値を下回るか
+    EXPECT_LT(std::abs(newton_raphson_ad(6  , f0) - (6.65052)) , epsilon);
+    EXPECT_LT(std::abs(newton_raphson_ad(0  , f1) - (1.10644)) , epsilon);
+    EXPECT_LT(std::abs(newton_raphson_ad(0.9, f2) - (0.90737)) , epsilon);
+    EXPECT_LT(std::abs(newton_raphson_ad(2  , f3) - (1.84359)) , epsilon);
+    // 1回の反復でfを1回だけ評価する
+    EXPECT_LE(calls, 4 * Constants::max_attempts);
+
+    // Dual<double>で呼び出せないジェネリックラムダは従来通り数値微分のnewton_raphsonで解く (第3引数は差分幅)
+    const auto generic = [](const auto& x) { return 4.2 * std::cos(x) - 1.7 * x; };
+    EXPECT_LT(std::abs(newton_raphson(0, generic, 1e-6) - (1.10644)), epsilon);
+}
+
 TEST(NumericalAnalysisTest, BisectionMethodTest) {
     // 誤差の閾値
     const double epsilon = 10e-5;
@@ -137,3 +276,128 @@ TEST(NumericalAnalysisTest, BisectionMethodTest) {
     EXPECT_LT(std::abs(bisection_method(f2, 0.90, 0.91)     - (0.90737)), epsilon);
     EXPECT_LT(std::abs(bisection_method(f3, 0, 2)           - (1.84359)), epsilon);
 }
+
+TEST(NumericalAnalysisTest, BisectionMethodEvaluationTest) {
+    // 1回の反復でfを1回だけ評価する
+    std::size_t calls = 0;
+    const auto f = [&calls](const double x) { ++calls; return 4.2 * std::cos(x) - 1.7 * x; };
+    EXPECT_LT(std::abs(bisection_method(f, 1, 1.2) - (1.10644)), 10e-5);
+    EXPECT_EQ(calls, 2 + static_cast<std::size_t>(std::ceil(std::log2(0.2 / Constants::epsilon))));
+    // 範囲が既に収束判定条件を満たしていれば中点を返す
+    EXPECT_DOUBLE_EQ(bisection_method(f, 1.1064, 1.1065, 0.01), 1.10645);
+}
+
+TEST(NumericalAnalysisTest, BrentMethodTest) {
+    // 誤差の閾値
+    const double epsilon = 10e-5;
+    /*
+     * 入力関数 (NewtonRaphsonTestの入力関数)
+     * f0   : 0.1(x - 1.2)^5 - 0.5(x + 3.1)^3 - 1.1(x - 0.3)^2 + 3.1(x + 2.0)
+     * f1   : 4.2cos(x) - 1.7x
+     * f2   : 1 / ln(x) + (x + 2.3)^2
+     * f3   : log((π^e)^x) - π
+     */
+    std::size_t calls = 0;
+    const auto f0  = [&calls](const double x) {
+        ++calls;
+        return 0.1 * std::pow(x - 1.2, 5) - 0.5 * std::pow(x + 3.1, 3) - 1.1 * std::pow(x - 0.3, 2) + 3.1 * (x + 2.0);
+    };
+    const auto f1  = [&calls](const double x) { ++calls; return 4.2 * std::cos(x) - 1.7 * x; };
+    const auto f2  = [&calls](const double x) { ++calls; return 1 / log(x) + std::pow(x + 2.3, 2); };
+    const auto f3  = [&calls](const double x) { ++calls; return std::log10(std::pow(std::numbers::pi, std::exp(x))) - std::numbers::pi; };
+
+    const std::array<BracketResult, 4> results = {
+        brent_method(f0, 5, 7),
+        brent_method(f1, 1, 1.2),
+        brent_method(f2, 0.90, 0.91),
+        brent_method(f3, 0, 2)
+    };
+    const std::array<double, 4> roots = {6.65052, 1.10644, 0.90737, 1.84359};
+    for(std::size_t i = 0; i < 4; ++i) {
+        EXPECT_EQ(results[i].status, SolverStatus::Converged);
+        EXPECT_LT(std::abs(results[i].root - roots[i]), epsilon);
+        // 二分法より少ない評価回数で収束する
+        EXPECT_LT(results[i].evaluations, 12u);
+    }
+    EXPECT_EQ(calls, results[0].evaluations + results[1].evaluations + results[2].evaluations + results[3].evaluations);
+
+    // 高精度の要求にも超一次収束で応える
+    const auto precise = brent_method(f1, 0, 2, 1.0e-14);
+    EXPECT_EQ(precise.status, SolverStatus::Converged);
+    EXPECT_NEAR(4.2 * std::cos(precise.root), 1.7 * precise.root, 1.0e-13);
+    EXPECT_LT(precise.evaluations, 15u);
+
+    // 両端の符号が同じ範囲
+    EXPECT_EQ(brent_method(f1, 2, 3).status, SolverStatus::InvalidBracket);
+}
+TEST(NumericalAnalysisTest, SolverOptionsTest) {
+    const auto f  = [](const double x) { return x * x - 2; };
+    const auto df = [](const double x) { return 2 * x; };
+
+    const SolverResult converged = newton_raphson(1.0, f, df, {.epsilon = 1e-12, .max_attempts = 50});
+    EXPECT_EQ(converged.status, SolverStatus::Converged);
+    EXPECT_NEAR(converged.root, std::numbers::sqrt2, 1e-12);
+    EXPECT_EQ(converged.evaluations, converged.iterations);
+    EXPECT_LT(converged.residual, 1e-10);
+    EXPECT_EQ(converged.elapsed.count(), 0);
+
+    // 反復回数の上限に達した場合と、微分が0となり発散した場合を区別できる
+    EXPECT_EQ(newton_raphson(1.0, f, df, {.epsilon = 1e-12, .max_attempts = 2}).status, SolverStatus::MaxAttemptsReached);
+    EXPECT_EQ(newton_raphson(0.0, f, df, {.max_attempts = 50}).status, SolverStatus::Diverged);
+
+    // 数値微分の評価回数を含む (中心差分は1反復あたりf(x)と2点)
+    const SolverResult numeric = newton_raphson(1.0, f, {.epsilon = 1e-12, .max_attempts = 50, .h = 1e-4});
+    EXPECT_EQ(numeric.status, SolverStatus::Converged);
+    EXPECT_EQ(numeric.evaluations, 3 * numeric.iterations);
+
+    const SolverResult automatic = newton_raphson_ad(1.0, [](const auto& x) { return x * x - 2.0; }, SolverOptions{.epsilon = 1e-12});
+    EXPECT_EQ(automatic.status, SolverStatus::Converged);
+    EXPECT_NEAR(automatic.root, std::numbers::sqrt2, 1e-12);
+
+    const SolverResult bisection = bisection_method(f, 0, 2, {.epsilon = 1e-9, .max_attempts = 100});
+    EXPECT_EQ(bisection.status, SolverStatus::Converged);
+    EXPECT_EQ(bisection.evaluations, bisection.iterations + 2);
+    EXPECT_EQ(bisection_method(f, 2, 3, SolverOptions{}).status, SolverStatus::InvalidBracket);
+    EXPECT_EQ(bisection_method(f, 0, 2, {.epsilon = 1e-9, .max_attempts = 5}).status, SolverStatus::MaxAttemptsReached);
+    // 幅がepsilonより小さくならない範囲やepsilon = 0でも中点が端点と一致した時点で終了する
+    const auto g = [](double x) { return x - 1.000000000002e12; };
+    const SolverResult large = bisection_method(g, 1e12, 1e12 + 10, {.epsilon = 1e-9, .max_attempts = 1000});
+    EXPECT_EQ(large.status, SolverStatus::Converged);
+    EXPECT_NEAR(large.root, 1.000000000002e12, 1e-3);
+    const SolverResult exact = bisection_method(f, 0, 2, {.epsilon = 0, .max_attempts = 1000});
+    EXPECT_EQ(exact.status, SolverStatus::Converged);
+    EXPECT_NEAR(exact.root, std::numbers::sqrt2, 1e-15);
+    EXPECT_NEAR(bisection_method(g, 1e12, 1e12 + 10, 0.0), 1.000000000002e12, 1e-3);
+    // max_attemptsを指定しない場合は二分法用の既定値を使用する
+    const SolverResult defaulted = bisection_method(f, 0, 2, {.epsilon = 1e-12});
+    EXPECT_EQ(defaulted.status, SolverStatus::Converged);
+    EXPECT_GT(defaulted.iterations, Constants::max_attempts);
+    EXPECT_NEAR(defaulted.root, std::numbers::sqrt2, 1e-12);
+
+    const SolverResult brent = brent_method(f, 0.0, 2.0, {.epsilon = 1e-12, .max_attempts = 100});
+    EXPECT_EQ(brent.status, SolverStatus::Converged);
+    EXPECT_LT(brent.residual, 1e-11);
+    EXPECT_EQ(brent_method(f, 0.0, 2.0, {.epsilon = 1e-12}).root, brent.root);
+}
+TEST(NumericalAnalysisTest, SolverProfilerTest) {
+    std::vector<std::string_view> names;
+    std::vector<SolverResult> reports;
+    const SolverOptions options = {
+        .epsilon = 1e-12,
+        .max_attempts = 50,
+        .profiler = [&](std::string_view name, const SolverResult& result) {
+            names.push_back(name);
+            reports.push_back(result);
+        }
+    };
+    const auto f = [](const double x) { return std::cos(x) - x; };
+    const SolverResult newton = newton_raphson(0.5, f, options);
+    const SolverResult brent = brent_method(f, 0.0, 1.0, options);
+    ASSERT_EQ(names.size(), 2u);
+    EXPECT_EQ(names[0], "newton_raphson");
+    EXPECT_EQ(names[1], "brent_method");
+    EXPECT_EQ(reports[0].iterations, newton.iterations);
+    EXPECT_EQ(reports[1].evaluations, brent.evaluations);
+    EXPECT_GE(newton.elapsed.count(), 0);
+    EXPECT_EQ(reports[1].elapsed, brent.elapsed);
+}
@@ -0,0 +1,76 @@
+#include <gtest/gtest.h>
+#include "../../include/NumericalAnalysis/numerical_integration.hpp"
+
+#include <cmath>
+#include <numbers>
+namespace {
+    using namespace numerical_analysis;
+}
+TEST(NumericalAnalysisIntegrationTest, PolynomialExactnessTest) {
+    // 埋め込まれたGauss則(7点は13次、10点は19次)でも厳密な多項式は誤差の推定値が0となり分割しない
+    const auto f = [](const double x) { return std::pow(x, 12) + 3 * x * x - 1; };
+    const double expected = std::pow(2.0, 13) / 13 + 8 - 2;
+    const auto k15 = integrate(f, 0.0, 2.0, 1.0e-6);
+    EXPECT_NEAR(k15.value, expected, 1.0e-9 * expected);
+    EXPECT_EQ(k15.subdivisions, 0u);
+    EXPECT_EQ(k15.evaluations, 15u);
+
+    const auto g = [](const double x) { return std::pow(x, 18); };
+    const auto k21 = integrate<GaussKronrodRule::G10K21>(g, -1.0, 1.0, 1.0e-6);
+    EXPECT_NEAR(k21.value, 2.0 / 19, 1.0e-14);
+    EXPECT_EQ(k21.evaluations, 21u);
+
+    // Kronrod則はGauss則が厳密でない次数(G7K15は22次まで)でも厳密
+    const auto h = [](const double x) { return std::pow(x, 22); };
+    const auto coarse = integrate(h, -1.0, 1.0, 1.0, 0);
+    EXPECT_NEAR(coarse.value, 2.0 / 23, 1.0e-14);
+    EXPECT_GT(coarse.error, 0.0);
+}
+TEST(NumericalAnalysisIntegrationTest, AdaptiveSubdivisionTest) {
+    // 端点で微分が発散する関数は端点付近を集中的に分割する
+    const auto f = [](const double x) { return std::sqrt(x); };
+    const auto result = integrate(f, 0.0, 1.0, 1.0e-12);
+    EXPECT_EQ(result.status, SolverStatus::Converged);
+    EXPECT_GT(result.subdivisions, 0u);
+    EXPECT_LE(result.error, 1.0e-12);
+    EXPECT_NEAR(result.value, 2.0 / 3, 1.0e-12);
+    EXPECT_EQ(result.evaluations, 15 * (2 * result.subdivisions + 1));
+
+    const auto g = [](const double x) { return std::sin(50 * x) * std::exp(-x); };
+    const double expected = (50 - std::exp(-std::numbers::pi) * (50 * std::cos(50 * std::numbers::pi) + std::sin(50 * std::numbers::pi))) / 2501;
+    const auto oscillating = integrate<GaussKronrodRule::G10K21>(g, 0.0, std::numbers::pi, 1.0e-12);
+    EXPECT_EQ(oscillating.status, SolverStatus::Converged);
+    EXPECT_NEAR(oscillating.value, expected, 1.0e-12);
+}
+TEST(NumericalAnalysisIntegrationTest, MaxSubdivisionsTest) {
+    const auto f = [](const double x) { return 1 / std::sqrt(x); };
+    const auto result = integrate(f, 0.0, 1.0, 1.0e-15, 5);
+    EXPECT_EQ(result.status, SolverStatus::MaxAttemptsReached);
+    EXPECT_EQ(result.subdivisions, 5u);
+    EXPECT_GT(result.error, 1.0e-15);
+}
+TEST(NumericalAnalysisIntegrationTest, ParallelTest) {
+    const auto f = [](const double x) { return std::exp(-x * x); };
+    const double expected = std::sqrt(std::numbers::pi) / 2 * std::erf(3.0) * 2;
+    const auto serial = integrate(f, -3.0, 3.0, 1.0e-13);
+    const auto parallel = integrate(f, -3.0, 3.0, 1.0e-13, 1000, 4);
+    EXPECT_EQ(parallel.status, SolverStatus::Converged);
+    EXPECT_NEAR(serial.value, expected, 1.0e-13);
+    EXPECT_NEAR(parallel.value, expected, 1.0e-13);
+    EXPECT_LE(parallel.error, 1.0e-13);
+
+    // 特異点を含む1つの部分区間に他の部分区間の残りの分割回数が配分される (等分すると1区間あたり10回)
+    const auto g = [](const double x) { return std::sqrt(std::abs(x - 0.3)); };
+    const double cusp = 2.0 / 3.0 * (std::pow(0.3, 1.5) + std::pow(0.7, 1.5));
+    const auto hard = integrate(g, 0.0, 1.0, 1.0e-12, 40, 4);
+    EXPECT_EQ(integrate(g, 0.0, 1.0, 1.0e-12, 40).status, SolverStatus::Converged);
+    EXPECT_EQ(hard.status, SolverStatus::Converged);
+    EXPECT_LE(hard.subdivisions, 40u);
+    EXPECT_NEAR(hard.value, cusp, 1.0e-12);
+    // 部分区間の結果は添え字の順に足し合わせるため、同じ呼び出しは同じ結果を返す
+    for(int i = 0; i < 20; ++i) {
+        const auto repeated = integrate(g, 0.0, 1.0, 1.0e-12, 40, 4);
+        ASSERT_EQ(repeated.value, hard.value);
+        ASSERT_EQ(repeated.error, hard.error);
+    }
+}
@@ -0,0 +1,87 @@
+#include <gtest/gtest.h>
+#include "../../include/NumericalAnalysis/ode_integration.hpp"
+#include "../../include/LinearAlgebra/StaticMatrix/Vector/staticvector.hpp"
+
+#include <cmath>
+#include <vector>
+namespace {
+    using namespace numerical_analysis;
+    using State2 = klibrary::linear_algebra::StaticColVector<double, 2>;
+    // 調和振動子 y'' = -w^2 y
+    struct Oscillator {
+        double w;
+        State2 operator()(const double, const State2& y) const {
+            State2 dy;
+            dy[0] = y[1];
+            dy[1] = -w * w * y[0];
+            return dy;
+        }
+    };
+}
+TEST(NumericalAnalysisOdeIntegrationTest, ScalarDecayTest) {
+    using State1 = klibrary::linear_algebra::StaticColVector<double, 1>;
+    static_assert(state_size_v<State1> == 1);
+    static_assert(state_size_v<klibrary::linear_algebra::StaticMatrixBase<double, 3, 4>> == 12);
+    const auto f = [](const double t, const State1& y) {
+        State1 dy;
+        dy[0] = -2 * t * y[0];
+        return dy;
+    };
+    State1 y0;
+    y0[0] = 1;
+    const auto result = integrate_ode(f, 0.0, y0, 2.0, 1e-10, 1e-12);
+    EXPECT_EQ(result.status, SolverStatus::Converged);
+    EXPECT_NEAR(result.y[0], std::exp(-4.0), 1e-10);
+    // FSALにより受理・棄却を問わず1ステップあたり6回 (初期値と初期刻み幅の推定に各1回)
+    EXPECT_EQ(result.evaluations, 2 + 6 * (result.steps + result.rejected_steps));
+}
+TEST(NumericalAnalysisOdeIntegrationTest, DenseOutputTest) {
+    State2 y0;
+    y0[0] = 1;
+    y0[1] = 0;
+    DormandPrince45<State2, Oscillator> solver(Oscillator{3.0}, 0.0, y0, 1e-9, 1e-12);
+    double max_error = 0;
+    while(solver.t() < 5.0) {
+        ASSERT_TRUE(solver.step(5.0));
+        const double t_old = solver.previous_t();
+        for(int j = 0; j <= 4; ++j) {
+            const double t = t_old + (solver.t() - t_old) * j / 4;
+            const State2 y = solver.dense_output(t);
+            max_error = std::max(max_error, std::abs(y[0] - std::cos(3 * t)));
+        }
+    }
+    EXPECT_DOUBLE_EQ(solver.t(), 5.0);
+    EXPECT_NEAR(solver.y()[0], std::cos(15.0), 1e-7);
+    EXPECT_NEAR(solver.y()[1], -3 * std::sin(15.0), 1e-7);
+    EXPECT_LT(max_error, 1e-6);
+    EXPECT_GT(solver.steps(), 10u);
+}
+TEST(NumericalAnalysisOdeIntegrationTest, MaxStepsTest) {
+    State2 y0;
+    y0[0] = 1;
+    const auto result = integrate_ode(Oscillator{100.0}, 0.0, y0, 10.0, 1e-10, 1e-12, 20);
+    EXPECT_EQ(result.status, SolverStatus::MaxAttemptsReached);
+    EXPECT_EQ(result.steps + result.rejected_steps, 20u);
+}
+TEST(NumericalAnalysisOdeIntegrationTest, BatchTest) {
+    // 端数のレーンを含む11本の軌道を一括で積分し、個別に積分した結果と比較する
+    std::vector<State2> ys(11);
+    for(std::size_t i = 0; i < ys.size(); ++i) {
+        ys[i][0] = 1.0 + static_cast<double>(i);
+        ys[i][1] = 0.5 * static_cast<double>(i);
+    }
+    const Oscillator f{2.0};
+    for(const std::size_t threads : {1, 2}) {
+        std::vector<State2> results(ys.size());
+        std::vector<SolverStatus> status(ys.size());
+        integrate_ode_batch<State2>(f, 0.0, ys, 3.0, results, status, 1e-9, 1e-12, 100000, threads);
+        for(std::size_t i = 0; i < ys.size(); ++i) {
+            const auto single = integrate_ode(f, 0.0, ys[i], 3.0, 1e-9, 1e-12);
+            EXPECT_EQ(status[i], SolverStatus::Converged);
+            EXPECT_NEAR(results[i][0], single.y[0], 1e-12);
+            EXPECT_NEAR(results[i][1], single.y[1], 1e-12);
+            const double exact = ys[i][0] * std::cos(6.0) + ys[i][1] / 2 * std::sin(6.0);
+            EXPECT_NEAR(results[i][0], exact, 1e-7);
+        }
+    }
+}
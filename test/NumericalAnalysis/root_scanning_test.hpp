@@ -0,0 +1,48 @@
+#include <gtest/gtest.h>
+#include "../../include/NumericalAnalysis/root_scanning.hpp"
+
+#include <cmath>
+#include <numbers>
+namespace {
+    using namespace numerical_analysis;
+}
+TEST(NumericalAnalysisRootScanningTest, FindAllRootsTest) {
+    // sin(x) = 0 の[0.5, 20]における解はkπ (k = 1, ..., 6)
+    const auto f = [](const double x) { return std::sin(x); };
+    for(const std::size_t threads : {1, 4}) {
+        const auto roots = find_all_roots(f, 0.5, 20.0, 1000, 1.0e-12, threads);
+        ASSERT_EQ(roots.size(), 6u);
+        for(std::size_t k = 0; k < roots.size(); ++k) {
+            EXPECT_NEAR(roots[k], static_cast<double>(k + 1) * std::numbers::pi, 1.0e-12);
+        }
+    }
+}
+TEST(NumericalAnalysisRootScanningTest, CloseRootsTest) {
+    // (x - 1)^2 - 10^-8 = 0 の2解は標本間隔よりはるかに近い
+    const auto f = [](const double x) { return (x - 1) * (x - 1) - 1.0e-8; };
+    const auto roots = find_all_roots(f, 0.0, 3.0, 7, 1.0e-12, 2, 24);
+    ASSERT_EQ(roots.size(), 2u);
+    EXPECT_NEAR(roots[0], 1 - 1.0e-4, 1.0e-10);
+    EXPECT_NEAR(roots[1], 1 + 1.0e-4, 1.0e-10);
+}
+TEST(NumericalAnalysisRootScanningTest, SampledRootTest) {
+    // 標本点上や区間の端にある解は重複なく1度だけ返される
+    const auto f = [](const double x) { return x * (x - 1) * (x - 2); };
+    for(const std::size_t threads : {1, 3}) {
+        const auto roots = find_all_roots(f, 0.0, 2.0, 4, 1.0e-12, threads);
+        ASSERT_EQ(roots.size(), 3u);
+        EXPECT_DOUBLE_EQ(roots[0], 0.0);
+        EXPECT_DOUBLE_EQ(roots[1], 1.0);
+        EXPECT_DOUBLE_EQ(roots[2], 2.0);
+    }
+    EXPECT_TRUE(find_all_roots(f, 3.0, 4.0).empty());
+
+    // 標本点上の解と同じ区間にあるもう1つの解も検出される (x = 0は標本点、x = 0.3は区間[0, 0.5]の内部)
+    const auto g = [](const double x) { return x * (x - 0.3); };
+    for(const std::size_t threads : {1, 3}) {
+        const auto roots = find_all_roots(g, 0.0, 2.0, 4, 1.0e-12, threads);
+        ASSERT_EQ(roots.size(), 2u);
+        EXPECT_DOUBLE_EQ(roots[0], 0.0);
+        EXPECT_NEAR(roots[1], 0.3, 1.0e-12);
+    }
+}
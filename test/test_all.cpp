@@ -3,4 +3,27 @@
 #include "./LinearAlgebra/StaticMatrix/staticmatrix_basic_transfrms_test.hpp"
 #include "./LinearAlgebra/StaticMatrix/staticmatrix_basic_matrices_test.hpp"
 #include "./LinearAlgebra/StaticMatrix/Vector/staticvector_base_test.hpp"
-#include "./LinearAlgebra/StaticMatrix/Vector/staticvector_geometory_test.hpp"
\ No newline at end of file
+#include "./LinearAlgebra/StaticMatrix/Vector/staticvector_geometory_test.hpp"
+#include "./LinearAlgebra/StaticMatrix/staticmatrix_reduction_test.hpp"
+#include "./NumericalAnalysis/batch_root_finding_test.hpp"
+#include "./LinearAlgebra/StaticMatrix/staticmatrix_lu_test.hpp"
+#include "./LinearAlgebra/StaticMatrix/Vector/staticvector_test.hpp"
+#include "./NumericalAnalysis/multidimensional_newton_test.hpp"
+#include "./NumericalAnalysis/root_scanning_test.hpp"
+#include "./NumericalAnalysis/numerical_integration_test.hpp"
+#include "./NumericalAnalysis/ode_integration_test.hpp"
+#include "./NumericalAnalysis/function_adapter_test.hpp"
+#include "./NumericalAnalysis/fast_fourier_transform_test.hpp"
+#include "./NumericalAnalysis/least_squares_test.hpp"
+#include "./NumericalAnalysis/iterative_solvers_test.hpp"
+#include "./NumericalAnalysis/multivariate_differentiation_test.hpp"
+#include "./NumericalAnalysis/minimization_test.hpp"
+#include "./LinearAlgebra/StaticMatrix/staticmatrix_modint_test.hpp"
+#include "./LinearAlgebra/StaticMatrix/staticmatrix_power_test.hpp"
+#include "./LinearAlgebra/StaticMatrix/staticmatrix_strassen_test.hpp"
+#include "./LinearAlgebra/StaticMatrix/staticmatrix_complex_test.hpp"
+#include "./LinearAlgebra/StaticMatrix/staticmatrix_quantized_test.hpp"
+#include "./LinearAlgebra/StaticMatrix/staticmatrix_dispatch_test.hpp"
+#include "./LinearAlgebra/StaticMatrix/staticmatrix_random_test.hpp"
+#include "./LinearAlgebra/StaticMatrix/Vector/staticvector_kd_tree_test.hpp"
+#include "./LinearAlgebra/StaticMatrix/staticmatrix_permutation_test.hpp"
\ No newline at end of file